@@ -121,12 +121,15 @@ namespace ecs::EntityRegistry {
 	/**
 	* @brief Registers a system
 	* @param func The function to register
+	* @param optional Components the system reads where an entity has them. They follow the filter in the iterator
+	* and their buffer is null for tables without them
 	*/
 	auto extern RegisterSystem(
 		std::string name, 
 		std::vector<ecs_entity_t> filter, 
 		bool isParallel,
-		void (*func)(ecs_iter_t* it)
+		void (*func)(ecs_iter_t* it),
+		std::vector<ecs_entity_t> optional = {}
 	) -> ecs_entity_t;
 
 	/**
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "EntityRegistry.hxx"
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace ecs::Flipbook {
+	/**
+	* @brief What a flipbook does once it reaches its last frame
+	*/
+	enum class PlaybackMode : uint32_t {
+		// Stops on the last frame
+		Once = 0,
+		// Starts over from the first frame
+		Loop = 1,
+		// Plays backwards to the first frame, then forwards again
+		PingPong = 2
+	};
+
+	/**
+	* @brief Plays a flipbook on an entity, scripts mirror it as FlipbookComponent
+	* @note Scripts set the clip, the speed and the start time. The animation system writes the frame and its
+	* texture region every update, before any script system runs, and the sprite renderer draws that region.
+	*/
+	struct FlipbookComponent {
+		// The clip returned by CreateFlipbook
+		uint32_t clip;
+		// 1 plays at the authored speed, 0 pauses and negative values play backwards
+		float speed;
+		// Seconds into the clip, kept within the clip by the system
+		float time;
+		// The frame being shown
+		uint32_t frame;
+		// The texture region of that frame (u0, v0, u1, v1)
+		float uvRect[4];
+	};
+
+	static_assert(sizeof(FlipbookComponent) == 32, "Scripts mirror the component field by field");
+
+	/**
+	* @brief Registers the component and the system that advances every flipbook
+	* @note Called once after the entity registry is initialized
+	*/
+	auto extern Init() -> void;
+
+	/**
+	* @brief Creates a clip that flipbook components can play
+	* @param rects The texture region of every frame (u0, v0, u1, v1), 4 * frameCount floats
+	* @param durations How long every frame is shown, in seconds
+	* @param frameCount The number of frames
+	* @param mode What happens after the last frame
+	* @return The clip, 0 if the frames are invalid
+	*/
+	auto extern CreateClip(const float* rects, const float* durations, size_t frameCount, PlaybackMode mode) -> uint32_t;
+
+	/**
+	* @brief Advances flipbooks and writes the region of their current frame
+	* @param flipbooks The flipbooks to advance
+	* @param count The number of flipbooks
+	* @param delta The time since the last update, in seconds
+	*/
+	auto extern Advance(FlipbookComponent* flipbooks, size_t count, float delta) -> void;
+}
@@ -1,5 +1,6 @@
 #include "ecs/Bridge_ECS.h"
 #include "ecs/EntityRegistry.hxx"
+#include "ecs/Flipbook.hxx"
 
 #include <map>
 #include <memory>
@@ -12,6 +13,7 @@ std::map<int64_t, uint64_t> componentTypes;
 
 inline void ECS_Init(NativePointer logger, bool isDebug) {
 	ecs::EntityRegistry::Init(isDebug);
+	ecs::Flipbook::Init();
 }
 
 inline void ECS_Update(float delta) {
@@ -78,6 +80,26 @@ inline uint64_t ECS_RegisterSystem(
 	return ecs::EntityRegistry::RegisterSystem(name, filterVec, isParallel, reinterpret_cast<void (*)(ecs_iter_t*)>(func));
 }
 
+inline uint64_t ECS_RegisterSystemWithOptional(
+	const char* name, 
+	const uint64_t* filter, 
+	size_t filterLen, 
+	const uint64_t* optional,
+	size_t optionalLen,
+	bool isParallel,
+	void (*func)(NativePointer)
+) {
+	std::vector<uint64_t> filterVec(filter, filter + filterLen);
+	std::vector<uint64_t> optionalVec(optional, optional + optionalLen);
+	return ecs::EntityRegistry::RegisterSystem(
+		name,
+		filterVec,
+		isParallel,
+		reinterpret_cast<void (*)(ecs_iter_t*)>(func),
+		optionalVec
+	);
+}
+
 inline NativePointer ECS_GetComponentsFromIterator(NativePointer iterator, uint32_t index, size_t componentSize) {
 	auto iter = reinterpret_cast<ecs_iter_t*>(iterator);
 
@@ -118,3 +140,10 @@ inline uint64_t ECS_GetComponentUuid(uint64_t component) {
 	return ecs::EntityRegistry::GetComponentUuid(component);
 }
 
+inline uint32_t ECS_CreateFlipbook(const float* rects, const float* durations, size_t frameCount, uint32_t mode) {
+	if (mode > static_cast<uint32_t>(ecs::Flipbook::PlaybackMode::PingPong)) {
+		return 0;
+	}
+
+	return ecs::Flipbook::CreateClip(rects, durations, frameCount, static_cast<ecs::Flipbook::PlaybackMode>(mode));
+}
@@ -169,7 +169,8 @@ namespace ecs::EntityRegistry {
 		std::string name, 
 		std::vector<ecs_entity_t> filter, 
 		bool isParallel,
-		void (*func)(ecs_iter_t* it)
+		void (*func)(ecs_iter_t* it),
+		std::vector<ecs_entity_t> optional
 	) -> ecs_entity_t {
 		ecs_system_desc_t desc = {};
 		ecs_entity_desc_t entityDesc = {};
@@ -187,6 +188,11 @@ namespace ecs::EntityRegistry {
 			desc.query.filter.terms[x].id = componentId;
 			desc.query.filter.terms[x].oper = EcsAnd;
 		}
+		for (int x = 0; x < optional.size(); x++) {
+			auto& term = desc.query.filter.terms[filter.size() + x];
+			term.id = componentMappings[optional[x]];
+			term.oper = EcsOptional;
+		}
 
 		auto sysId = ecs_system_init(world, &desc);
 
@@ -0,0 +1,138 @@
+#include "ecs/Flipbook.hxx"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace ecs::Flipbook {
+	namespace {
+		struct Clip {
+			uint32_t firstFrame;
+			uint32_t frameCount;
+			// The sum of the frame durations
+			float duration;
+			PlaybackMode mode;
+		};
+
+		struct Frame {
+			// When the frame starts and ends, in seconds from the start of the clip
+			float start;
+			float end;
+			float rect[4];
+		};
+
+		// Clip 0 is never handed out, so a zeroed component plays nothing
+		std::vector<Clip> clips = { Clip {} };
+		// The frames of all clips, back to back
+		std::vector<Frame> frames;
+		// Clips are read by every worker while flipbooks advance and only written when scripts create one
+		std::shared_mutex clipLock;
+
+		// Keeps the time within one period of the clip, so it never grows large enough to lose precision
+		inline auto Wrap(float time, const Clip& clip) -> float {
+			if (clip.mode == PlaybackMode::Once) {
+				return std::fmin(std::fmax(time, 0.0f), clip.duration);
+			}
+
+			// Ping pong plays the clip forwards and then backwards within one period
+			auto period = clip.mode == PlaybackMode::PingPong ? 2.0f * clip.duration : clip.duration;
+			auto wrapped = time - std::floor(time / period) * period;
+
+			return wrapped < period ? wrapped : 0.0f;
+		}
+
+		auto AdvanceFlipbooks(ecs_iter_t* it) -> void {
+			auto flipbooks = static_cast<FlipbookComponent*>(ecs_field_w_size(it, sizeof(FlipbookComponent), 1));
+			Advance(flipbooks, it->count, it->delta_time);
+		}
+	}
+
+	auto Init() -> void {
+		auto world = EntityRegistry::GetRegistry();
+
+		// Created by name, so scripts registering their mirror of the component get the same id
+		ecs_entity_desc_t componentEntity = {};
+		componentEntity.name = "FlipbookComponent";
+
+		ecs_component_desc_t component = {};
+		component.entity = ecs_entity_init(world, &componentEntity);
+		component.type.size = sizeof(FlipbookComponent);
+		component.type.alignment = alignof(FlipbookComponent);
+		component.type.name = "FlipbookComponent";
+		auto componentId = ecs_component_init(world, &component);
+
+		// Script systems run on update, so by then every flipbook shows the frame of this update
+		ecs_entity_desc_t systemEntity = {};
+		systemEntity.name = "FlipbookSystem";
+		systemEntity.add[0] = ecs_pair(EcsDependsOn, EcsPreUpdate);
+
+		ecs_system_desc_t system = {};
+		system.entity = ecs_entity_init(world, &systemEntity);
+		system.callback = AdvanceFlipbooks;
+		system.multi_threaded = true;
+		system.query.filter.terms[0].id = componentId;
+		system.query.filter.terms[0].oper = EcsAnd;
+		ecs_system_init(world, &system);
+	}
+
+	auto CreateClip(const float* rects, const float* durations, size_t frameCount, PlaybackMode mode) -> uint32_t {
+		if (frameCount == 0) {
+			std::cerr << "Tried to create a flipbook without frames" << std::endl;
+			return 0;
+		}
+
+		Clip clip = { 0, static_cast<uint32_t>(frameCount), 0.0f, mode };
+		std::vector<Frame> clipFrames(frameCount);
+		for (size_t x = 0; x < frameCount; x++) {
+			if (!(durations[x] > 0.0f)) {
+				std::cerr << "Flipbook frames need a duration above zero" << std::endl;
+				return 0;
+			}
+
+			clipFrames[x].start = clip.duration;
+			clip.duration += durations[x];
+			clipFrames[x].end = clip.duration;
+			std::memcpy(clipFrames[x].rect, rects + x * 4, sizeof(clipFrames[x].rect));
+		}
+
+		std::unique_lock lock { clipLock };
+		clip.firstFrame = static_cast<uint32_t>(frames.size());
+		frames.insert(frames.end(), clipFrames.begin(), clipFrames.end());
+		clips.push_back(clip);
+
+		return static_cast<uint32_t>(clips.size() - 1);
+	}
+
+	auto Advance(FlipbookComponent* flipbooks, size_t count, float delta) -> void {
+		std::shared_lock lock { clipLock };
+
+		// One flat pass over the column, no calls or allocations per flipbook
+		for (size_t x = 0; x < count; x++) {
+			auto& flipbook = flipbooks[x];
+			if (flipbook.clip == 0 || flipbook.clip >= clips.size()) {
+				continue;
+			}
+
+			const auto& clip = clips[flipbook.clip];
+			const auto* clipFrames = frames.data() + clip.firstFrame;
+
+			flipbook.time = Wrap(flipbook.time + delta * flipbook.speed, clip);
+			auto local = flipbook.time > clip.duration ? 2.0f * clip.duration - flipbook.time : flipbook.time;
+
+			// Flipbooks move by a frame at most in most updates, so the search starts at the frame they show
+			auto frame = flipbook.frame < clip.frameCount ? flipbook.frame : 0;
+			while (frame > 0 && local < clipFrames[frame].start) {
+				frame--;
+			}
+			while (frame + 1 < clip.frameCount && local >= clipFrames[frame].end) {
+				frame++;
+			}
+
+			flipbook.frame = frame;
+			std::memcpy(flipbook.uvRect, clipFrames[frame].rect, sizeof(flipbook.uvRect));
+		}
+	}
+}
@@ -0,0 +1,142 @@
+#include "ecs/Flipbook.hxx"
+#include <gtest/gtest.h>
+#include <cstring>
+
+using ecs::Flipbook::Advance;
+using ecs::Flipbook::CreateClip;
+using ecs::Flipbook::FlipbookComponent;
+using ecs::Flipbook::PlaybackMode;
+
+namespace {
+    constexpr float FrameDuration = 0.1f;
+    constexpr float ClipDuration = 3 * FrameDuration;
+
+    // Three frames of a tenth of a second, frame n shows the nth quarter of the texture
+    auto MakeClip(PlaybackMode mode) -> uint32_t {
+        const float rects[] = {
+            0.0f, 0.0f, 0.25f, 1.0f,
+            0.25f, 0.0f, 0.5f, 1.0f,
+            0.5f, 0.0f, 0.75f, 1.0f
+        };
+        const float durations[] = { FrameDuration, FrameDuration, FrameDuration };
+        return CreateClip(rects, durations, 3, mode);
+    }
+
+    auto MakeFlipbook(uint32_t clip, float speed = 1.0f, float time = 0.0f) -> FlipbookComponent {
+        FlipbookComponent flipbook = {};
+        flipbook.clip = clip;
+        flipbook.speed = speed;
+        flipbook.time = time;
+        return flipbook;
+    }
+
+    // Advances one flipbook and checks the frame it lands on along with its region
+    auto ExpectFrame(FlipbookComponent& flipbook, float delta, uint32_t frame) -> void {
+        Advance(&flipbook, 1, delta);
+        EXPECT_EQ(flipbook.frame, frame) << "at " << flipbook.time << " seconds";
+        EXPECT_FLOAT_EQ(flipbook.uvRect[0], 0.25f * frame);
+        EXPECT_FLOAT_EQ(flipbook.uvRect[2], 0.25f * (frame + 1));
+    }
+}
+
+TEST(Flipbook, TestOnceStopsOnTheLastFrame) {
+    auto flipbook = MakeFlipbook(MakeClip(PlaybackMode::Once));
+
+    ExpectFrame(flipbook, 0.05f, 0);
+    ExpectFrame(flipbook, 0.1f, 1);
+    ExpectFrame(flipbook, 0.1f, 2);
+
+    // Far past the end the time is held at the end of the clip
+    ExpectFrame(flipbook, 10.0f, 2);
+    EXPECT_FLOAT_EQ(flipbook.time, ClipDuration);
+}
+
+TEST(Flipbook, TestOnceBackwardsStopsOnTheFirstFrame) {
+    auto flipbook = MakeFlipbook(MakeClip(PlaybackMode::Once), -1.0f, 0.25f);
+
+    ExpectFrame(flipbook, 0.1f, 1);
+    ExpectFrame(flipbook, 10.0f, 0);
+    EXPECT_FLOAT_EQ(flipbook.time, 0.0f);
+}
+
+TEST(Flipbook, TestLoopWrapsToTheFirstFrame) {
+    auto flipbook = MakeFlipbook(MakeClip(PlaybackMode::Loop), 1.0f, 0.25f);
+
+    ExpectFrame(flipbook, 0.1f, 0);
+    EXPECT_NEAR(flipbook.time, 0.05f, 1e-5f);
+
+    // Many periods at once still land within one period
+    ExpectFrame(flipbook, 100.0f * ClipDuration + 0.1f, 1);
+    EXPECT_GE(flipbook.time, 0.0f);
+    EXPECT_LT(flipbook.time, ClipDuration);
+}
+
+TEST(Flipbook, TestLoopBackwardsWrapsToTheLastFrame) {
+    auto flipbook = MakeFlipbook(MakeClip(PlaybackMode::Loop), -1.0f, 0.05f);
+
+    ExpectFrame(flipbook, 0.1f, 2);
+    EXPECT_NEAR(flipbook.time, 0.25f, 1e-5f);
+    ExpectFrame(flipbook, 0.1f, 1);
+}
+
+TEST(Flipbook, TestPingPongPlaysBackwardsInTheSecondHalf) {
+    auto flipbook = MakeFlipbook(MakeClip(PlaybackMode::PingPong), 1.0f, 0.25f);
+
+    // Past the end of the clip the frames run backwards, the time keeps counting up to twice the clip
+    ExpectFrame(flipbook, 0.1f, 2);
+    ExpectFrame(flipbook, 0.1f, 1);
+    ExpectFrame(flipbook, 0.1f, 0);
+    EXPECT_GT(flipbook.time, ClipDuration);
+
+    // Then forwards again from the start
+    ExpectFrame(flipbook, 0.1f, 0);
+    EXPECT_LT(flipbook.time, ClipDuration);
+    ExpectFrame(flipbook, 0.1f, 1);
+}
+
+TEST(Flipbook, TestPingPongBackwardsEntersTheReverseHalf) {
+    auto flipbook = MakeFlipbook(MakeClip(PlaybackMode::PingPong), -1.0f, 0.05f);
+
+    // Going back from the start lands at the end of the period, which shows the first frames again
+    ExpectFrame(flipbook, 0.1f, 0);
+    EXPECT_NEAR(flipbook.time, 2.0f * ClipDuration - 0.05f, 1e-5f);
+    ExpectFrame(flipbook, 0.1f, 1);
+}
+
+TEST(Flipbook, TestSpeedScalesTheDelta) {
+    auto flipbook = MakeFlipbook(MakeClip(PlaybackMode::Loop), 2.0f);
+    ExpectFrame(flipbook, 0.075f, 1);
+
+    flipbook.speed = 0.0f;
+    ExpectFrame(flipbook, 1.0f, 1);
+    EXPECT_NEAR(flipbook.time, 0.15f, 1e-5f);
+}
+
+TEST(Flipbook, TestInvalidClipsAreLeftUntouched) {
+    auto valid = MakeClip(PlaybackMode::Loop);
+    FlipbookComponent flipbooks[] = {
+        MakeFlipbook(0, 1.0f, 0.05f),
+        MakeFlipbook(valid, 1.0f, 0.05f),
+        MakeFlipbook(valid + 1000, 1.0f, 0.05f)
+    };
+    flipbooks[0].frame = 7;
+    flipbooks[2].frame = 7;
+    FlipbookComponent before[3];
+    std::memcpy(before, flipbooks, sizeof(flipbooks));
+
+    Advance(flipbooks, 3, 0.1f);
+
+    EXPECT_EQ(std::memcmp(&flipbooks[0], &before[0], sizeof(FlipbookComponent)), 0);
+    EXPECT_EQ(std::memcmp(&flipbooks[2], &before[2], sizeof(FlipbookComponent)), 0);
+    // The valid one between them still advances
+    EXPECT_EQ(flipbooks[1].frame, 1u);
+}
+
+TEST(Flipbook, TestClipsWithoutFramesOrDurationsAreRejected) {
+    const float rects[] = { 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f };
+    const float durations[] = { 0.1f, 0.0f };
+
+    EXPECT_EQ(CreateClip(rects, durations, 0, PlaybackMode::Loop), 0u);
+    EXPECT_EQ(CreateClip(rects, durations, 2, PlaybackMode::Loop), 0u);
+    EXPECT_NE(CreateClip(rects, durations, 1, PlaybackMode::Loop), 0u);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace kyanite::engine::io {
+	/**
+	* @brief A read only view of a whole file, paged in by the OS on access
+	*/
+	class MappedFile {
+	public:
+		/**
+		* @brief Maps a file into memory
+		* @param path The file to map
+		* @return The mapping, or nullptr if the file could not be opened or is empty
+		*/
+		static auto Open(const std::filesystem::path& path) -> std::shared_ptr<MappedFile>;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		[[nodiscard]] auto Data() const -> const uint8_t* { return _data; }
+		[[nodiscard]] auto Size() const -> size_t { return _size; }
+
+	private:
+		MappedFile() = default;
+
+		const uint8_t* _data = nullptr;
+		size_t _size = 0;
+#if _WIN32
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+#endif
+	};
+}
@@ -0,0 +1,85 @@
+#include "io/filesystem/MappedFile.hxx"
+
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kyanite::engine::io {
+#if _WIN32
+	auto MappedFile::Open(const std::filesystem::path& path) -> std::shared_ptr<MappedFile> {
+		auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return nullptr;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		auto mapped = std::shared_ptr<MappedFile>(new MappedFile());
+		mapped->_data = static_cast<const uint8_t*>(data);
+		mapped->_size = static_cast<size_t>(size.QuadPart);
+		mapped->_file = file;
+		mapped->_mapping = mapping;
+
+		return mapped;
+	}
+
+	MappedFile::~MappedFile() {
+		UnmapViewOfFile(_data);
+		CloseHandle(_mapping);
+		CloseHandle(_file);
+	}
+#else
+	auto MappedFile::Open(const std::filesystem::path& path) -> std::shared_ptr<MappedFile> {
+		auto file = open(path.c_str(), O_RDONLY);
+		if (file < 0) {
+			return nullptr;
+		}
+
+		struct stat info;
+		if (fstat(file, &info) != 0 || info.st_size == 0) {
+			close(file);
+			return nullptr;
+		}
+
+		// The mapping keeps the file alive, so the descriptor is not needed anymore
+		auto data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (data == MAP_FAILED) {
+			return nullptr;
+		}
+
+		auto mapped = std::shared_ptr<MappedFile>(new MappedFile());
+		mapped->_data = static_cast<const uint8_t*>(data);
+		mapped->_size = static_cast<size_t>(info.st_size);
+
+		return mapped;
+	}
+
+	MappedFile::~MappedFile() {
+		munmap(const_cast<uint8_t*>(_data), _size);
+	}
+#endif
+}
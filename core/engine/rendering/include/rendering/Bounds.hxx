@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <limits>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief Axis aligned bounding box in the local space of a mesh
+	* @note A default constructed box is empty, which culling treats as unbounded
+	*/
+	struct Bounds {
+		glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+		auto IsValid() const -> bool {
+			return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+		}
+
+		auto Encapsulate(const glm::vec3& point) -> void {
+			min = glm::min(min, point);
+			max = glm::max(max, point);
+		}
+	};
+}
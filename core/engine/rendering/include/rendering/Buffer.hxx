@@ -1,14 +1,32 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace kyanite::engine::rendering {
+	// How often the contents of a buffer are replaced, backends pick their storage from it
+	enum class BufferUsage {
+		// Written once, drawn many times
+		Static,
+		// Rewritten now and then, drawn many times
+		Dynamic,
+		// Rewritten about once per frame
+		Stream
+	};
+
 	class Buffer {
 	public:
-		Buffer(size_t size) : _size(size) {}
+		Buffer(size_t size, BufferUsage usage = BufferUsage::Static) : _size(size), _usage(usage) {}
 		virtual ~Buffer() = 0 {}
+		virtual auto Id() const -> uint64_t = 0;
 
 		auto Size() const -> size_t { return _size; }
+		auto Usage() const -> BufferUsage { return _usage; }
+		// Set when an update replaced the whole contents with a different number of elements
+		auto Resize(size_t size) -> void { _size = size; }
 
 	private:
 		size_t _size;
+		BufferUsage _usage;
 	};
-}
\ No newline at end of file
+}
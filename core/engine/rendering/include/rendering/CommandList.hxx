@@ -2,17 +2,40 @@
 
 #include "CommandAllocator.hxx"
 #include "CommandListType.hxx"
+#include "DepthMode.hxx"
+#include "GpuTimerPool.hxx"
+#include "SpriteBatch.hxx"
 #include "Vertex.hxx"
 #include "IndexBuffer.hxx"
+#include "IndirectDraw.hxx"
 #include "PrimitiveTopology.hxx"
+#include "RenderTarget.hxx"
 #include "VertexArray.hxx"
 #include "VertexBuffer.hxx"
 #include "Mesh.hxx"
 #include "Material.hxx"
+#include "Texture.hxx"
+
+#include <shared/TextureFormat.hxx>
 
 #include <glm/glm.hpp>
 
+#include <memory>
+#include <vector>
+
 namespace kyanite::engine::rendering {
+	// One staged write into a buffer, executed as a GPU side copy out of the staging data
+	struct BufferCopy {
+		std::shared_ptr<Buffer> buffer;
+		// Offset of the source bytes in the staging data
+		size_t sourceOffset;
+		// Offset in the buffer, zero when the contents are replaced
+		size_t offset;
+		size_t size;
+		// The storage is respecified at size bytes before the copy, instead of written in place
+		bool replace;
+	};
+
 	class CommandList {
 	public:
 		CommandList(CommandListType type) : _type(type) {};
@@ -20,7 +43,28 @@ namespace kyanite::engine::rendering {
 		virtual auto Begin() -> void = 0;
 		virtual auto Close() -> void = 0;
 		virtual auto Reset(std::shared_ptr<CommandAllocator>&) -> void = 0;
+		/**
+		* @brief Clears the colour of the bound target to the given colour and its depth to the far plane
+		*/
 		virtual auto ClearRenderTarget(glm::vec4 color) -> void = 0;
+
+		/**
+		* @brief Makes the following draws and clears go to a render target
+		* @param target The target, or nullptr for the backbuffer
+		*/
+		virtual auto BindRenderTarget(std::shared_ptr<RenderTarget> target) -> void = 0;
+
+		/**
+		* @brief Changes what a render target is used as, from here on
+		* @param target The target to transition
+		* @param before What the target was used as until now
+		* @param after What the target is used as next
+		*/
+		virtual auto TransitionRenderTarget(
+			std::shared_ptr<RenderTarget> target,
+			ResourceState before,
+			ResourceState after
+		) -> void = 0;
 		virtual auto SetViewport(
 			uint32_t x, 
 			uint32_t y, 
@@ -33,11 +77,18 @@ namespace kyanite::engine::rendering {
 		virtual auto SetViewMatrix(glm::mat4 viewMatrix) -> void = 0;
 		virtual auto SetProjectionMatrix(glm::mat4 projectionMatrix) -> void = 0;
 		virtual auto SetPrimitiveTopology(PrimitiveTopology topology) -> void = 0;
+		virtual auto SetBlending(bool enabled) -> void = 0;
+		virtual auto SetDepthMode(DepthMode mode) -> void = 0;
+		/**
+		* @brief Offsets the depth of the following draws, negative is nearer
+		* @param bias The offset in the smallest depth differences the depth buffer resolves, see LayerDepthBias
+		*/
+		virtual auto SetDepthBias(float bias) -> void = 0;
 		virtual auto SetMaterial(std::shared_ptr<Material> material) -> void = 0;
 		virtual auto BindVertexArray(std::shared_ptr<VertexArray> vertexArray) -> void const = 0;
 		virtual auto BindVertexBuffer(uint8_t index, std::shared_ptr<VertexBuffer> vertexBuffer) -> void const = 0;
 		virtual auto BindIndexBuffer(std::shared_ptr<IndexBuffer> vertexBuffer) -> void const = 0;
-		virtual auto DrawIndexed(glm::mat4 model, uint32_t numIndices, uint32_t startIndex) -> void = 0;
+		virtual auto DrawIndexed(glm::mat4 model, glm::vec4 uvRect, uint32_t numIndices, uint32_t startIndex, int32_t baseVertex) -> void = 0;
 		virtual auto DrawIndexedInstanced(
 			uint32_t numIndices,
 			uint32_t instanceCount,
@@ -45,6 +96,82 @@ namespace kyanite::engine::rendering {
 			int32_t baseVertexLocation
 		) -> void = 0;
 
+		/**
+		* @brief Replaces the indirect commands and the draw data the following indirect draws read
+		* @param commands The commands, addressed by their index
+		* @param draws The draw data, addressed by the baseInstance of the commands
+		*/
+		virtual auto SetIndirectDraws(std::vector<DrawIndirectCommand> commands, std::vector<DrawData> draws) -> void = 0;
+
+		/**
+		* @brief Issues a range of the indirect commands with the bound vertex array and material in one call
+		* @param firstCommand The index of the first command
+		* @param commandCount The number of commands
+		*/
+		virtual auto MultiDrawIndexedIndirect(uint32_t firstCommand, uint32_t commandCount) -> void = 0;
+
+		/**
+		* @brief Streams the instances of the batched sprites of this list
+		* @param instances The instances, replacing the ones set before
+		*/
+		virtual auto SetSpriteInstances(std::vector<SpriteInstance> instances) -> void = 0;
+
+		/**
+		* @brief Draws a run of the instances set with SetSpriteInstances, each one expanding the bound quad
+		*/
+		virtual auto DrawSpriteInstances(
+			uint32_t numIndices,
+			uint32_t startIndex,
+			int32_t baseVertex,
+			uint32_t firstInstance,
+			uint32_t instanceCount
+		) -> void = 0;
+
+		/**
+		* @brief Writes the GPU time once everything recorded before has finished
+		* @param pool The pool the query belongs to
+		* @param query The query, as handed out by the pool
+		*/
+		virtual auto WriteTimestamp(std::shared_ptr<GpuTimerPool> pool, uint32_t query) -> void = 0;
+
+		/**
+		* @brief Replaces the storage of a texture with the given pixels
+		* @param texture The texture to upload to
+		* @param width The width of the image
+		* @param height The height of the image
+		* @param pixels Tightly packed 32 bit BGRA pixels
+		*/
+		virtual auto UploadTexture(
+			std::shared_ptr<Texture> texture,
+			uint32_t width,
+			uint32_t height,
+			std::shared_ptr<std::vector<uint8_t>> pixels
+		) -> void = 0;
+
+		/**
+		* @brief Replaces the storage of a texture with precompressed blocks and their mip chain
+		* @param texture The texture to upload to
+		* @param format The block format of all levels
+		* @param levels The levels to upload, largest first
+		* @param data The base the level offsets are relative to. It is kept alive until the upload ran
+		*/
+		virtual auto UploadCompressedTexture(
+			std::shared_ptr<Texture> texture,
+			shared::TextureFormat format,
+			std::vector<shared::TextureLevel> levels,
+			std::shared_ptr<const uint8_t> data
+		) -> void = 0;
+
+		/**
+		* @brief Uploads staged bytes once and copies them into their buffers on the GPU
+		* @param staging The bytes of all copies. It is kept alive until the upload ran
+		* @param copies The writes, executed in order, so later writes to the same bytes win
+		*/
+		virtual auto UpdateBuffers(
+			std::shared_ptr<const std::vector<uint8_t>> staging,
+			std::vector<BufferCopy> copies
+		) -> void = 0;
+
 		auto Type() const -> CommandListType { return _type; }
 
 	private:
@@ -11,6 +11,7 @@ namespace kyanite::engine::rendering {
 	public:
 		CommandQueue(CommandListType type) : _type(type) {}
 		virtual ~CommandQueue() = default;
+		// Lists are replayed one after another in the order given, no matter which threads recorded them
 		virtual void Execute(const std::vector<std::shared_ptr<CommandList>>&) = 0;
 		virtual void Signal(Fence& fence, uint64_t value) = 0;
 
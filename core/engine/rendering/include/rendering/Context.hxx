@@ -24,9 +24,9 @@ namespace kyanite::engine::rendering {
         std::shared_ptr<CommandQueue> _commandQueue;
         std::shared_ptr<CommandAllocator> _commandAllocator;
         std::shared_ptr<CommandList> _commandList;
+        std::shared_ptr<Device> _device;
 
     private:
         CommandListType _type;
-        std::shared_ptr<Device> _device;
     };
 }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Bounds.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief The six clip planes of a view-projection, stored transposed so four planes can be tested at once
+	* @note Plane order is left, right, bottom, top, near, far. Lanes 6 and 7 repeat the far plane.
+	*/
+	struct alignas(16) Frustum {
+		float x[8];
+		float y[8];
+		float z[8];
+		float w[8];
+
+		/**
+		* @brief Extracts the planes of a combined view-projection matrix
+		* @param viewProjection The projection matrix multiplied by the view matrix
+		* @return The frustum
+		*/
+		static auto FromViewProjection(const glm::mat4& viewProjection) -> Frustum;
+	};
+
+	/**
+	* @brief Tests transformed local bounds against a frustum
+	* @param frustum The frustum to test against
+	* @param models The model matrix of each item
+	* @param bounds The local bounds of each item. Invalid bounds are always visible
+	* @param count The number of items
+	* @param visible Receives 1 for every item that intersects the frustum and 0 otherwise
+	*/
+	auto CullBounds(
+		const Frustum& frustum,
+		const glm::mat4* models,
+		const Bounds* bounds,
+		size_t count,
+		uint8_t* visible
+	) -> void;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace kyanite::engine::rendering {
+	enum class DepthMode {
+		Disabled,
+		// Opaque draws, the nearest one wins and the first one drawn wins ties
+		TestAndWrite,
+		// Blended draws, hidden behind opaque ones but never hiding anything themselves
+		TestOnly,
+	};
+
+	/**
+	* @brief The depth bias of a layer, in the smallest depth differences the depth buffer resolves
+	* @note Every layer is one step nearer than the layer below, so at the same depth a higher layer wins the depth test
+	* in both passes. An opaque sprite hides the blended ones of lower layers and is never hidden by them.
+	*/
+	constexpr auto LayerDepthBias(uint16_t layer) -> float {
+		return -static_cast<float>(layer);
+	}
+}
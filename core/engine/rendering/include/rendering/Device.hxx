@@ -4,6 +4,9 @@
 #include "CommandListType.hxx"
 #include "CommandQueue.hxx"
 #include "Fence.hxx"
+#include "FrameStats.hxx"
+#include "GpuTimerPool.hxx"
+#include "RenderTarget.hxx"
 #include "Shader.hxx"
 #include "Swapchain.hxx"
 #include "IndexBuffer.hxx"
@@ -18,7 +21,6 @@
 
 namespace kyanite::engine::rendering {
 	class Buffer;
-	class RenderTarget;
 	class GraphicsContext;
 	class ImmediateGuiContext;
 	class UploadContext;
@@ -30,6 +32,10 @@ namespace kyanite::engine::rendering {
 		virtual ~Device() = default;
 		virtual auto Shutdown() -> void = 0;
 
+		// Moves the native context between threads, it is current on the creating thread until detached
+		virtual auto AttachToCurrentThread() -> void = 0;
+		virtual auto DetachFromCurrentThread() -> void = 0;
+
 		// Creation work submission and synchronization
 		virtual auto CreateGraphicsContext() -> std::unique_ptr<GraphicsContext> = 0;
 		virtual auto CreateImGuiContext(ImGuiContext* context) -> 
@@ -40,10 +46,11 @@ namespace kyanite::engine::rendering {
 		virtual auto CreateCommandAllocator() -> std::shared_ptr<CommandAllocator> = 0;
 		virtual auto CreateFence() -> std::shared_ptr<Fence> = 0;
 		virtual auto CreateSwapchain() -> std::unique_ptr<Swapchain> = 0;
+		virtual auto CreateTimerPool() -> std::shared_ptr<GpuTimerPool> = 0;
 
 		// Creation of resources
 		virtual auto CreateBuffer(uint64_t size) -> std::shared_ptr<Buffer> = 0;
-		virtual auto CreateRenderTarget() -> std::shared_ptr<RenderTarget> = 0;
+		virtual auto CreateRenderTarget(const RenderTargetDesc& desc) -> std::shared_ptr<RenderTarget> = 0;
 		virtual auto CreateMaterial(
 			std::map<ShaderType, 
 			std::shared_ptr<Shader>> shaders,
@@ -53,10 +60,10 @@ namespace kyanite::engine::rendering {
 			const std::string& shaderSource, 
 			ShaderType type
 		) -> std::shared_ptr<Shader> = 0;
-		virtual auto CreateVertexBuffer(const void* data, uint64_t size, size_t elemSize) -> std::shared_ptr<VertexBuffer> = 0;
+		virtual auto CreateVertexBuffer(const void* data, uint64_t size, size_t elemSize, BufferUsage usage = BufferUsage::Static) -> std::shared_ptr<VertexBuffer> = 0;
 		virtual auto UpdateVertexBuffer(std::shared_ptr<VertexBuffer> buffer, const void* data, uint64_t size
 		) -> void = 0;
-		virtual auto CreateIndexBuffer(const uint32_t* indices, size_t len) -> std::shared_ptr<IndexBuffer> = 0;
+		virtual auto CreateIndexBuffer(const uint32_t* indices, size_t len, BufferUsage usage = BufferUsage::Static) -> std::shared_ptr<IndexBuffer> = 0;
 		virtual auto UpdateIndexBuffer(std::shared_ptr<IndexBuffer> buffer, std::vector<uint32_t> indices) -> void = 0;
 		virtual auto CreateVertexArray(
 			std::shared_ptr<VertexBuffer> vertexBuffer,
@@ -68,10 +75,15 @@ namespace kyanite::engine::rendering {
 			uint32_t channels,
 			const uint8_t* data
 		) -> std::shared_ptr<Texture> = 0;
+		virtual auto CreatePlaceholderTexture() -> std::shared_ptr<Texture> = 0;
 
 		// Deleting resources
 		virtual auto DestroyShader(uint64_t shaderHandle) -> void = 0;
 
+		// Statistics, collected until they are reset once per frame
+		virtual auto Stats() const -> FrameStats = 0;
+		virtual auto ResetStats() -> void = 0;
+
 	protected:
 		std::shared_ptr<CommandQueue> _graphicsQueue;
 		std::shared_ptr<CommandQueue> _computeQueue;
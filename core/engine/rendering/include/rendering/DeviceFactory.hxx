@@ -1,11 +1,18 @@
 #pragma once
 
 #include "RenderBackendType.hxx"
+#include "null/NullDevice.hxx"
 #include "opengl/GlDevice.hxx"
+#ifdef KYANITE_HEADLESS_EGL
+#include "opengl/GlHeadlessDevice.hxx"
+#endif
 
 #include <SDL2/SDL.h>
 #include <glad/glad.h>
 
+#include <cstdint>
+#include <iostream>
+
 namespace kyanite::engine::rendering {
 	class DeviceFactory {
 	public:
@@ -18,6 +25,15 @@ namespace kyanite::engine::rendering {
 				break;
 			case kyanite::engine::rendering::RenderBackendType::D3D12:
 				break;
+			case kyanite::engine::rendering::RenderBackendType::Null: {
+				// The window is only asked for its size
+				int width = 1920;
+				int height = 1080;
+				if (window != nullptr) {
+					SDL_GetWindowSize(window, &width, &height);
+				}
+				return std::make_shared<kyanite::engine::rendering::null::NullDevice>(width, height);
+			}
 			default:
 				break;
 			}
@@ -25,5 +41,30 @@ namespace kyanite::engine::rendering {
 			// If we reach this point, the backend is not supported
 			exit(1);
 		}
+
+		/**
+		* @brief Creates a device without a window, which presents into an offscreen backbuffer
+		* @param width The width of the backbuffer
+		* @param height The height of the backbuffer
+		*/
+		static auto CreateHeadlessDevice(RenderBackendType backend, uint32_t width, uint32_t height) -> std::shared_ptr<Device> {
+			switch (backend)
+			{
+			case kyanite::engine::rendering::RenderBackendType::OpenGL:
+#ifdef KYANITE_HEADLESS_EGL
+				return std::make_shared<kyanite::engine::rendering::opengl::GlHeadlessDevice>(width, height);
+#else
+				break;
+#endif
+			case kyanite::engine::rendering::RenderBackendType::Null:
+				return std::make_shared<kyanite::engine::rendering::null::NullDevice>(width, height);
+			default:
+				break;
+			}
+
+			// If we reach this point, the backend has no headless mode on this platform
+			std::cerr << "The render backend cannot run headless on this platform" << std::endl;
+			exit(1);
+		}
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "DrawCall.hxx"
+#include "SpriteBatch.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief Append-only draw storage owned by a single submitting thread
+	* @note Draws are stored as SoA so the merge step only copies plain arrays
+	*/
+	struct DrawBucket {
+		std::vector<glm::mat4> models;
+		std::vector<glm::vec4> uvRects;
+		std::vector<uint32_t> vaos;
+		std::vector<uint32_t> materials;
+		std::vector<uint16_t> layers;
+
+		inline auto Push(const glm::mat4& model, const glm::vec4& uvRect, uint32_t vao, uint32_t material, uint16_t layer = 0) -> void {
+			models.push_back(model);
+			uvRects.push_back(uvRect);
+			vaos.push_back(vao);
+			materials.push_back(material);
+			layers.push_back(layer);
+		}
+
+		inline auto Size() const -> size_t { return vaos.size(); }
+
+		// Keeps the capacity so steady-state frames do not allocate
+		inline auto Clear() -> void {
+			models.clear();
+			uvRects.clear();
+			vaos.clear();
+			materials.clear();
+			layers.clear();
+		}
+	};
+
+	/**
+	* @brief Append-only storage of batched sprites owned by a single submitting thread
+	*/
+	struct SpriteBucket {
+		std::vector<SpriteInstance> sprites;
+		std::vector<uint32_t> materials;
+
+		inline auto Push(const SpriteInstance& sprite, uint32_t material) -> void {
+			sprites.push_back(sprite);
+			materials.push_back(material);
+		}
+
+		inline auto Size() const -> size_t { return sprites.size(); }
+
+		inline auto Clear() -> void {
+			sprites.clear();
+			materials.clear();
+		}
+	};
+
+	/**
+	* @brief The buckets of one submitting thread, one for each draw path
+	*/
+	struct ThreadDrawBuckets {
+		DrawBucket indexed;
+		DrawBucket instanced;
+		SpriteBucket sprites;
+	};
+
+	/**
+	* @brief Hands out one ThreadDrawBuckets per thread and collects them at frame end
+	* @note Buckets are only written by their owning thread during the update phase and only read by the
+	* render thread after it. No synchronisation is done per draw, only when a thread submits for the first time.
+	*/
+	class DrawBucketRegistry {
+	public:
+		/**
+		* @brief Gets the buckets of the calling thread, registering them on first use
+		* @return The buckets of the calling thread
+		*/
+		auto Local() -> ThreadDrawBuckets&;
+
+		/**
+		* @brief Appends all indexed draws of all threads to the given vector and clears the buckets
+		* @param drawCalls The vector to append to
+		*/
+		auto MergeIndexed(std::vector<DrawCall>& drawCalls) -> void;
+
+		/**
+		* @brief Appends all instanced draws of all threads to the given vector and clears the buckets
+		* @param drawCalls The vector to append to
+		*/
+		auto MergeInstanced(std::vector<DrawCall>& drawCalls) -> void;
+
+		/**
+		* @brief Appends all batched sprites of all threads to the given vectors and clears the buckets
+		* @param sprites The vector to append the sprites to
+		* @param materials The vector to append their materials to
+		*/
+		auto MergeSprites(std::vector<SpriteInstance>& sprites, std::vector<uint32_t>& materials) -> void;
+
+		/**
+		* @brief Drops all pending draws without submitting them
+		*/
+		auto Clear() -> void;
+
+	private:
+		std::mutex _registrationLock;
+		// Buckets are never removed so the thread local pointers to them stay valid
+		std::vector<std::unique_ptr<ThreadDrawBuckets>> _buckets;
+	};
+}
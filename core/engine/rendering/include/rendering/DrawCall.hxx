@@ -1,7 +1,20 @@
 #pragma once
 
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
 namespace kyanite::engine::rendering {
-	struct DrawCall {
+	// The whole texture, used by draws that do not sample an atlas region
+	inline const glm::vec4 FullUvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
 
+	struct DrawCall {
+		glm::mat4 model;
+		// u0, v0, u1, v1 of the texture region to sample
+		glm::vec4 uvRect;
+		uint32_t vao;
+		uint32_t material;
+		// Orders blended draws before their depth does and biases the depth of all, higher layers are in front
+		uint16_t layer;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "DrawCall.hxx"
+#include "ImGuiContext.hxx"
+#include "Rect.hxx"
+#include "SpriteBatch.hxx"
+#include "StagedBuffers.hxx"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief Everything needed to draw one frame, captured when the simulation of that frame ends
+	* @note A packet is not changed after it is submitted. The simulation already runs the next frame while it is drawn.
+	*/
+	struct FramePacket {
+		glm::mat4 view;
+		glm::mat4 projection;
+		Rect viewport;
+		// Buffer contents the simulation changed during the frame, uploaded before the frame is drawn
+		StagedBuffers buffers;
+		// Draws of opaque materials, culled and sorted front to back, ties by material and vertex array
+		std::vector<DrawCall> drawCalls;
+		std::vector<DrawCall> instancedDrawCalls;
+		// Draws of blended materials, culled and sorted by layer, then back to front
+		std::vector<DrawCall> blendedDrawCalls;
+		std::vector<DrawCall> blendedInstancedDrawCalls;
+		// Culled and sorted by layer, then by material
+		std::vector<SpriteInstance> sprites;
+		std::vector<SpriteBatch> spriteBatches;
+		GuiSnapshot gui;
+	};
+}
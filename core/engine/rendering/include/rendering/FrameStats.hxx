@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace kyanite::engine::rendering {
+	// Counters a device collects while executing one frame
+	struct FrameStats {
+		// State changes that reached the driver
+		uint64_t stateChanges = 0;
+		// State changes dropped because the state was already set
+		uint64_t redundantStateChanges = 0;
+		// Commands executed, draw submissions and bytes sent to the GPU, the null device counts them
+		uint64_t commands = 0;
+		uint64_t drawCalls = 0;
+		uint64_t uploadedBytes = 0;
+		// GPU time of the frame in milliseconds, 0 where the device does not measure it
+		double gpuFrameTime = 0.0;
+	};
+}
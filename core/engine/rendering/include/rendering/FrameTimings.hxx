@@ -0,0 +1,24 @@
+#pragma once
+
+#include "GpuTimerPool.hxx"
+
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	// Where the time of a frame went, all in milliseconds
+	struct FrameTimings {
+		// Wall time from the start of one frame to the start of the next
+		double cpuFrame = 0.0;
+		// PreFrame and PostFrame on the simulation thread, PostFrame without drawing the packet
+		double preFrame = 0.0;
+		double postFrame = 0.0;
+		// Recording and submitting the packet, on the render thread if there is one
+		double render = 0.0;
+		// Presenting, which also waits for the GPU when it falls behind
+		double swap = 0.0;
+		// GPU time of the whole frame, 0 where the device does not measure it
+		double gpuFrame = 0.0;
+		// GPU time of every timed scope, passes included. These lag a few frames behind the CPU times.
+		std::vector<GpuScopeTime> scopes;
+	};
+}
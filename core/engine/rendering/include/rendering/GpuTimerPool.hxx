@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	// GPU time of one timed scope of a frame
+	struct GpuScopeTime {
+		std::string name;
+		double milliseconds;
+	};
+
+	/**
+	* @brief Timestamps written at the start and the end of scopes, read back a few frames later
+	* @note The results of a frame are read FrameLatency frames after it was recorded. By then the GPU is done with
+	* it, so reading never waits. A frame whose results are still not there is dropped instead.
+	*/
+	class GpuTimerPool {
+	public:
+		static constexpr uint32_t FrameLatency = 3;
+		static constexpr uint32_t MaxScopes = 32;
+		static constexpr uint32_t QueriesPerFrame = MaxScopes * 2;
+		static constexpr uint32_t QueryCount = FrameLatency * QueriesPerFrame;
+		static constexpr uint32_t InvalidQuery = UINT32_MAX;
+
+		virtual ~GpuTimerPool() = default;
+
+		/**
+		* @brief Reads the frame recorded FrameLatency frames ago and reuses its queries for the next one
+		*/
+		auto BeginFrame() -> void;
+		/**
+		* @brief Opens a scope, scopes nest
+		* @return The query to write the start timestamp to, InvalidQuery once the frame ran out of scopes
+		*/
+		auto BeginScope(std::string name) -> uint32_t;
+		/**
+		* @brief Closes the innermost open scope
+		* @return The query to write the end timestamp to, InvalidQuery if that scope is not timed
+		*/
+		auto EndScope() -> uint32_t;
+		/**
+		* @brief The scopes of the last frame that was read back, in the order they were opened
+		*/
+		auto Results() const -> const std::vector<GpuScopeTime>& { return _results; }
+
+	protected:
+		virtual auto IsAvailable(uint32_t query) -> bool = 0;
+		// In nanoseconds
+		virtual auto Timestamp(uint32_t query) -> uint64_t = 0;
+
+	private:
+		struct Scope {
+			std::string name;
+			uint32_t begin;
+			uint32_t end;
+		};
+
+		struct Frame {
+			std::vector<Scope> scopes;
+			// The end query closed last. Outer scopes close after the scopes they contain, so this is not the highest one
+			uint32_t lastEnd = InvalidQuery;
+		};
+
+		std::array<Frame, FrameLatency> _frames;
+		uint32_t _frame = 0;
+		// Scopes of the current frame that were opened and not closed yet, innermost last
+		std::vector<uint32_t> _open;
+		// Opened past MaxScopes, their ends are dropped
+		uint32_t _untimed = 0;
+		std::vector<GpuScopeTime> _results;
+	};
+}
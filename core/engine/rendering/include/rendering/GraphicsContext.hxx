@@ -2,16 +2,21 @@
 
 #include "CommandListType.hxx"
 #include "Context.hxx"
+#include "DepthMode.hxx"
 #include "Device.hxx"
+#include "GpuTimerPool.hxx"
 #include "IndexBuffer.hxx"
+#include "IndirectDraw.hxx"
 #include "VertexBuffer.hxx"
 #include "PrimitiveTopology.hxx"
+#include "RenderTarget.hxx"
+#include "SpriteBatch.hxx"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace kyanite::engine::rendering {
-    class RenderTarget;
-
     class GraphicsContext: public Context {
     public:
         GraphicsContext(
@@ -21,18 +26,51 @@ namespace kyanite::engine::rendering {
         virtual ~GraphicsContext() = default;
         virtual auto Begin() -> void override;
         virtual auto Finish() -> void override;
+        /**
+        * @brief Executes this context and then the given contexts in one submission, in the order given
+        * @param recorded Contexts recorded in parallel. They are only executed here, not finished on their own
+        */
+        virtual auto Finish(const std::vector<GraphicsContext*>& recorded) -> void;
         virtual auto ClearRenderTarget() -> void;
         virtual auto SetRenderTarget(std::shared_ptr<RenderTarget> target) -> void;
+        virtual auto TransitionRenderTarget(std::shared_ptr<RenderTarget> target, ResourceState before, ResourceState after) -> void;
         virtual auto SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t minDepth, uint32_t maxDepth) -> void;
         virtual auto SetScissorRect(long left, long top, long right, long bottom) -> void;
         virtual auto SetPrimitiveTopology(PrimitiveTopology topology) -> void;
+        virtual auto SetBlending(bool enabled) -> void;
+        virtual auto SetDepthMode(DepthMode mode) -> void;
+        virtual auto SetDepthBias(float bias) -> void;
         virtual auto SetViewMatrix(glm::mat4 view) -> void;
         virtual auto SetProjectionMatrix(glm::mat4 projection) -> void;
         virtual auto SetVertexArray(const std::shared_ptr<VertexArray>& vertexArray) -> void const;
         virtual auto SetVertexBuffer(uint8_t index, const std::shared_ptr<VertexBuffer>& buffer) -> void const;
         virtual auto SetIndexBuffer(const std::shared_ptr<IndexBuffer>& buffer) -> void const;
         virtual auto SetMaterial(std::shared_ptr<Material>& material) -> void;
-        virtual auto DrawIndexed(glm::mat4& model, uint32_t numIndices, uint32_t startIndex) -> void;
+        virtual auto DrawIndexed(glm::mat4& model, glm::vec4& uvRect, uint32_t numIndices, uint32_t startIndex, int32_t baseVertex) -> void;
         virtual auto DrawIndexedInstanced(uint32_t numIndices, uint32_t instanceCount, uint32_t startIndexLocation, int32_t baseVertexLocation) -> void;
+        virtual auto SetIndirectDraws(std::vector<DrawIndirectCommand> commands, std::vector<DrawData> draws) -> void;
+        virtual auto MultiDrawIndexedIndirect(uint32_t firstCommand, uint32_t commandCount) -> void;
+        virtual auto SetSpriteInstances(std::vector<SpriteInstance> instances) -> void;
+        virtual auto DrawSpriteInstances(uint32_t numIndices, uint32_t startIndex, int32_t baseVertex, uint32_t firstInstance, uint32_t instanceCount) -> void;
+        /**
+        * @brief Starts timing a new frame, creates the timer pool on first use
+        */
+        virtual auto BeginFrameTimers() -> void;
+        /**
+        * @brief Opens a GPU timed scope, scopes nest and may span several Begin/Finish pairs
+        * @param name The name the scope is reported as
+        */
+        virtual auto BeginTimer(std::string name) -> void;
+        /**
+        * @brief Closes the innermost open GPU timed scope
+        */
+        virtual auto EndTimer() -> void;
+        /**
+        * @brief The GPU times of the scopes of a frame a few frames back, empty before the first frame is read
+        */
+        virtual auto GpuTimes() const -> std::vector<GpuScopeTime>;
+
+    private:
+        std::shared_ptr<GpuTimerPool> _timers;
     };
 }
\ No newline at end of file
@@ -8,6 +8,26 @@
 #include <imgui.h>
 
 namespace kyanite::engine::rendering {
+	/**
+	* @brief An owning copy of the ImGui draw data of one frame
+	* @note ImGui reuses its draw lists on the next NewFrame, so a frame drawn on another thread needs its own copy
+	*/
+	class GuiSnapshot {
+	public:
+		GuiSnapshot() = default;
+		~GuiSnapshot() { Clear(); }
+
+		GuiSnapshot(const GuiSnapshot&) = delete;
+		GuiSnapshot& operator=(const GuiSnapshot&) = delete;
+
+		auto Capture(const ImDrawData& source) -> void;
+		auto Clear() -> void;
+		auto DrawData() -> ImDrawData* { return _drawData.Valid ? &_drawData : nullptr; }
+
+	private:
+		ImDrawData _drawData;
+	};
+
 	class ImmediateGuiContext : public Context {
 	public:
 		ImmediateGuiContext(
@@ -22,6 +42,20 @@ namespace kyanite::engine::rendering {
 		auto Begin() -> void override;
 		auto Finish() -> void override;
 
+		// Render thread mode, the frame is ended on the simulation thread and drawn later on the render thread
+		/**
+		* @brief Creates the GL objects of the ImGui backend, has to run while the context is current on this thread
+		*/
+		auto CreateDeviceObjects() -> void;
+		/**
+		* @brief Ends the ImGui frame and copies its draw data
+		*/
+		auto Capture(GuiSnapshot& snapshot) -> void;
+		/**
+		* @brief Draws a captured frame. Platform windows are not supported in this mode
+		*/
+		auto Render(GuiSnapshot& snapshot) -> void;
+
 	private:
 		SDL_Window* _window;
 		RenderBackendType _backend;
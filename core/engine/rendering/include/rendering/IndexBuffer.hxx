@@ -7,10 +7,11 @@
 namespace kyanite::engine::rendering {
 	class IndexBuffer: public Buffer {
 	public:
-		IndexBuffer(size_t size) : Buffer(size) {}
+		IndexBuffer(size_t size, BufferUsage usage = BufferUsage::Static) : Buffer(size, usage) {}
 		virtual ~IndexBuffer() = 0 {}
-		virtual auto Id() const-> uint64_t = 0;
 		virtual void SetData(const void* data, size_t size) = 0;
+		// Overwrites bytes [offset, offset + size) and keeps the rest of the storage
+		virtual void SetSubData(size_t offset, const void* data, size_t size) = 0;
 		virtual void Bind() const = 0;
 	};
 }
\ No newline at end of file
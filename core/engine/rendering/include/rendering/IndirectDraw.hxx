@@ -0,0 +1,27 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace kyanite::engine::rendering {
+	// One indexed draw as the GPU reads it from an indirect buffer
+	struct DrawIndirectCommand {
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		// Index of the first DrawData record of the draw
+		uint32_t baseInstance;
+	};
+
+	// Per draw data of indirect draws, one record per instance.
+	// Instanced materials read it through attributes 2 to 6, which step from baseInstance onwards.
+	struct DrawData {
+		glm::mat4 model;
+		glm::vec4 uvRect;
+	};
+
+	static_assert(sizeof(DrawIndirectCommand) == 20, "Indirect commands are read with a stride of 20 bytes");
+	static_assert(sizeof(DrawData) == 80, "Draw data is read with a stride of 80 bytes");
+}
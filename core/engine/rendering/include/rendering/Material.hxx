@@ -11,6 +11,8 @@
 
 #include <glm/glm.hpp>
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -20,6 +22,8 @@ namespace kyanite::engine::rendering {
 	class Material {
 	public:
 		bool isInstanced = false;
+		// Opaque draws are depth tested and written and not blended. Read when frames are sorted, on the simulation thread.
+		bool isOpaque = false;
 		std::map<ShaderType, std::shared_ptr<Shader>> shaders;
 		std::map<std::string, std::shared_ptr<Texture>> textures;
 		std::map<std::string, float> floats;
@@ -40,9 +44,46 @@ namespace kyanite::engine::rendering {
 			vec3s({}),
 			vec4s({}) {}
 
+		virtual ~Material() = default;
+
+		// Parameters end up in the material block of the program. Setting them through here lets the next Bind upload them
+		auto SetFloat(const std::string& name, float value) -> void { floats[name] = value; _parametersDirty = true; }
+		auto SetInt(const std::string& name, uint32_t value) -> void { ints[name] = value; _parametersDirty = true; }
+		auto SetBool(const std::string& name, bool value) -> void { bools[name] = value; _parametersDirty = true; }
+		auto SetVec2(const std::string& name, std::array<float, 2> value) -> void { vec2s[name] = value; _parametersDirty = true; }
+		auto SetVec3(const std::string& name, std::array<float, 3> value) -> void { vec3s[name] = value; _parametersDirty = true; }
+		auto SetVec4(const std::string& name, std::array<float, 4> value) -> void { vec4s[name] = value; _parametersDirty = true; }
+
+		/**
+		* @brief Copies the textures and parameters of another material
+		* @param other The material to copy from
+		*/
+		auto CopyParameters(const Material& other) -> void {
+			textures = other.textures;
+			floats = other.floats;
+			ints = other.ints;
+			bools = other.bools;
+			vec2s = other.vec2s;
+			vec3s = other.vec3s;
+			vec4s = other.vec4s;
+			_parametersDirty = true;
+		}
+
+		// False while the backend still compiles the shaders, the material is then drawn with a fallback.
+		// Asks the backend, so it is only called where the context is current
+		virtual auto IsReady() -> bool { return true; }
+
+		// What IsReady answered last, safe to read from any thread
+		auto WasReady() const -> bool { return _ready.load(std::memory_order_acquire); }
+
 		virtual void Bind() = 0;
 
-		virtual void SetBuiltins(glm::mat4 model, glm::mat4 view, glm::mat4 projection) = 0;
+		virtual void SetBuiltins(glm::mat4 model, glm::vec4 uvRect, glm::mat4 view, glm::mat4 projection) = 0;
+
+	protected:
+		bool _parametersDirty = true;
+		// Published by backends whose materials are not ready right away, every time they are asked
+		std::atomic<bool> _ready = true;
 	};
 }
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Bounds.hxx"
+#include "Device.hxx"
+#include "RangeAllocator.hxx"
+#include "Vertex.hxx"
+#include "VertexArray.hxx"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief A mesh stored in a page of the mesh buffer. Binding it binds the vertex array of the whole page.
+	*/
+	class MeshRange : public VertexArray {
+	public:
+		MeshRange(
+			std::shared_ptr<VertexArray> page,
+			uint32_t pageIndex,
+			uint32_t baseVertex,
+			uint32_t vertexCount,
+			uint32_t firstIndex,
+			uint32_t indexCount,
+			const Bounds& bounds
+		) :
+			VertexArray(page->IndexBuffer(), page->VertexBuffer()),
+			_page(std::move(page)),
+			_pageIndex(pageIndex),
+			_baseVertex(baseVertex),
+			_vertexCount(vertexCount),
+			_firstIndex(firstIndex),
+			_indexCount(indexCount),
+			_bounds(bounds) {}
+
+		auto Id() const -> uint32_t override { return _page->Id(); }
+		auto Bind() const -> void override { _page->Bind(); }
+		auto Indices() const -> uint32_t override { return _indexCount; }
+		auto FirstIndex() const -> uint32_t override { return _firstIndex; }
+		auto BaseVertex() const -> int32_t override { return static_cast<int32_t>(_baseVertex); }
+		auto LocalBounds() const -> const Bounds& override { return _bounds; }
+
+		auto Page() const -> uint32_t { return _pageIndex; }
+		auto VertexCount() const -> uint32_t { return _vertexCount; }
+
+	private:
+		std::shared_ptr<VertexArray> _page;
+		uint32_t _pageIndex;
+		uint32_t _baseVertex;
+		uint32_t _vertexCount;
+		uint32_t _firstIndex;
+		uint32_t _indexCount;
+		Bounds _bounds;
+	};
+
+	/**
+	* @brief Shared vertex and index storage for static meshes.
+	* Meshes are suballocated from large pages, every page has one vertex array, so draws of different meshes
+	* only rebind when they cross a page. Indices stay relative to their mesh and are offset by the base vertex.
+	*/
+	class MeshBuffer {
+	public:
+		// 5 MB of vertices and 4 MB of indices per page
+		static constexpr uint32_t PageVertices = 1 << 18;
+		static constexpr uint32_t PageIndices = 1 << 20;
+
+		MeshBuffer(std::shared_ptr<Device> device);
+
+		/**
+		* @brief Copies a mesh into the first page with room for it, a new page is opened if none has
+		* @return The range the mesh was placed in, or nullptr if the mesh is empty
+		*/
+		auto Allocate(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) -> std::shared_ptr<MeshRange>;
+
+		/**
+		* @brief Returns the storage of a range to its page. The range must not be drawn afterwards.
+		*/
+		auto Free(const MeshRange& range) -> void;
+
+		auto PageCount() const -> size_t { return _pages.size(); }
+
+	private:
+		struct Page {
+			std::shared_ptr<VertexArray> vertexArray;
+			RangeAllocator vertices;
+			RangeAllocator indices;
+		};
+
+		auto AddPage(uint32_t vertexCapacity, uint32_t indexCapacity) -> Page&;
+
+		std::shared_ptr<Device> _device;
+		std::vector<Page> _pages;
+	};
+}
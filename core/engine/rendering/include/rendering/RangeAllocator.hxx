@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief First fit suballocator over a fixed range of elements. Freed ranges merge with free neighbours.
+	*/
+	class RangeAllocator {
+	public:
+		RangeAllocator(uint32_t capacity);
+
+		/**
+		* @brief Reserves a contiguous range
+		* @param count The number of elements
+		* @return The first element of the range, or nothing if no free range is large enough
+		*/
+		auto Allocate(uint32_t count) -> std::optional<uint32_t>;
+
+		/**
+		* @brief Returns a range given out by Allocate
+		* @param offset The first element of the range
+		* @param count The number of elements it was allocated with
+		*/
+		auto Free(uint32_t offset, uint32_t count) -> void;
+
+		auto Capacity() const -> uint32_t { return _capacity; }
+		auto Available() const -> uint32_t { return _available; }
+
+	private:
+		uint32_t _capacity;
+		uint32_t _available;
+		// Free ranges by offset, so neighbours of a freed range are found by one lookup
+		std::map<uint32_t, uint32_t> _free;
+	};
+}
@@ -4,6 +4,8 @@ namespace kyanite::engine::rendering {
 	enum class RenderBackendType {
 		OpenGL,
 		Vulkan,
-		D3D12
+		D3D12,
+		// Records and counts commands without a GPU, for measuring the CPU side of the renderer
+		Null
 	};
 }
\ No newline at end of file
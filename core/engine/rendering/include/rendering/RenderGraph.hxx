@@ -0,0 +1,157 @@
+#pragma once
+
+#include "RenderPass.hxx"
+#include "RenderTarget.hxx"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	class Device;
+	class GraphicsContext;
+	class RenderGraph;
+
+	/**
+	* @brief Keeps the transient targets of render graphs alive between frames
+	* @note Targets are handed out by description. One that was given back can be handed out again in the same
+	* frame, which is how targets with lifetimes that do not overlap end up sharing their memory.
+	*/
+	class RenderTargetPool {
+	public:
+		// Targets no graph acquired for this many frames are destroyed
+		static constexpr uint64_t MaxIdleFrames = 8;
+
+		explicit RenderTargetPool(std::shared_ptr<Device> device);
+
+		auto Acquire(const RenderTargetDesc& desc) -> std::shared_ptr<RenderTarget>;
+		auto Release(std::shared_ptr<RenderTarget> target) -> void;
+		/**
+		* @brief Ages the free targets and destroys the idle ones, once per frame
+		*/
+		auto EndFrame() -> void;
+		/**
+		* @brief The number of targets the pool has created and not yet destroyed
+		*/
+		auto Size() const -> size_t { return _size; }
+
+	private:
+		struct Entry {
+			std::shared_ptr<RenderTarget> target;
+			uint64_t releasedFrame;
+		};
+
+		std::shared_ptr<Device> _device;
+		std::vector<Entry> _free;
+		uint64_t _frame = 0;
+		size_t _size = 0;
+	};
+
+	/**
+	* @brief Declares what a pass reads and writes while it is added to a graph
+	*/
+	class RenderGraphBuilder {
+	public:
+		RenderGraphBuilder(RenderGraph& graph, RenderPass& pass) : _graph(graph), _pass(pass) {}
+
+		/**
+		* @brief Creates a transient target that lives from this pass to the last pass reading it, and writes it
+		*/
+		auto Create(std::string name, const RenderTargetDesc& desc) -> RenderResourceHandle;
+		/**
+		* @brief Samples a target an earlier pass wrote
+		*/
+		auto Read(RenderResourceHandle resource) -> RenderResourceHandle;
+		/**
+		* @brief Renders to a target. A pass renders to at most one
+		*/
+		auto Write(RenderResourceHandle resource) -> RenderResourceHandle;
+		/**
+		* @brief Keeps the pass even if it writes nothing, or nothing reads what it writes
+		*/
+		auto SideEffects() -> void;
+
+	private:
+		RenderGraph& _graph;
+		RenderPass& _pass;
+	};
+
+	/**
+	* @brief What a pass gets to record with while the graph executes
+	*/
+	class RenderPassContext {
+	public:
+		RenderPassContext(RenderGraph& graph, GraphicsContext& context) : _graph(graph), _context(context) {}
+
+		auto Context() -> GraphicsContext& { return _context; }
+		auto Target(RenderResourceHandle resource) const -> std::shared_ptr<RenderTarget>;
+		/**
+		* @brief Executes a context the pass recorded in parallel after the commands of the pass itself
+		*/
+		auto Submit(GraphicsContext& recorded) -> void { _recorded.push_back(&recorded); }
+
+	private:
+		friend class RenderGraph;
+
+		RenderGraph& _graph;
+		GraphicsContext& _context;
+		std::vector<GraphicsContext*> _recorded;
+	};
+
+	/**
+	* @brief Builds a frame out of passes that declare the targets they read and write
+	* @note Passes run in the order they were added, which is always a valid order, since a pass can only read
+	* targets handed out to earlier passes. Compiling culls the passes nothing imported depends on, places the
+	* transient targets and derives the transitions between passes.
+	*/
+	class RenderGraph {
+	public:
+		/**
+		* @brief Makes a target from outside the graph available to its passes. Imported targets are outputs
+		* @param target The target, or nullptr for the backbuffer
+		* @param state What the target is used as when the graph starts
+		*/
+		auto Import(
+			std::string name,
+			std::shared_ptr<RenderTarget> target,
+			const RenderTargetDesc& desc,
+			ResourceState state = ResourceState::RenderTarget
+		) -> RenderResourceHandle;
+		auto AddPass(
+			std::string name,
+			const std::function<void(RenderGraphBuilder&)>& setup,
+			std::function<void(RenderPassContext&)> execute
+		) -> void;
+		auto Compile() -> void;
+		/**
+		* @brief Records the passes that survived culling into the context, in order
+		* @note Each pass is timed as a GPU scope named after it
+		* @param context The context to record into, it is begun and not finished yet
+		* @param pool The pool the transient targets come from
+		*/
+		auto Execute(GraphicsContext& context, RenderTargetPool& pool) -> void;
+
+		auto Passes() const -> const std::vector<RenderPass>& { return _passes; }
+		auto CulledPasses() const -> size_t;
+
+	private:
+		friend class RenderGraphBuilder;
+		friend class RenderPassContext;
+
+		struct Resource {
+			std::string name;
+			RenderTargetDesc desc;
+			std::shared_ptr<RenderTarget> target;
+			bool imported;
+			ResourceState initialState;
+			// Indices of the passes writing the resource
+			std::vector<size_t> writers;
+			uint32_t refCount = 0;
+		};
+
+		std::vector<RenderPass> _passes;
+		std::vector<Resource> _resources;
+	};
+}
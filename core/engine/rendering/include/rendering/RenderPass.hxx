@@ -1,9 +1,58 @@
 #pragma once
 
+#include "RenderTarget.hxx"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
 namespace kyanite::engine::rendering {
+	class RenderPassContext;
+
+	// A render target of a render graph, valid for the graph that handed it out
+	using RenderResourceHandle = uint32_t;
+
+	// A transition a render graph issues before a pass runs
+	struct RenderBarrier {
+		RenderResourceHandle resource;
+		ResourceState before;
+		ResourceState after;
+	};
+
+	/**
+	* @brief One pass of a render graph, with the targets it reads and the target it renders to
+	* @note Passes are declared by the graph and filled in by RenderGraphBuilder, the graph compiles the rest
+	*/
 	class RenderPass {
 	public:
-		RenderPass() = default;
+		RenderPass(std::string name, std::function<void(RenderPassContext&)> execute) :
+			_name(std::move(name)),
+			_execute(std::move(execute)) {}
 		virtual ~RenderPass() = default;
+
+		auto Name() const -> const std::string& { return _name; }
+		auto Reads() const -> const std::vector<RenderResourceHandle>& { return _reads; }
+		auto Writes() const -> const std::vector<RenderResourceHandle>& { return _writes; }
+		auto IsCulled() const -> bool { return _culled; }
+
+	private:
+		friend class RenderGraph;
+		friend class RenderGraphBuilder;
+
+		std::string _name;
+		std::function<void(RenderPassContext&)> _execute;
+		std::vector<RenderResourceHandle> _reads;
+		std::vector<RenderResourceHandle> _writes;
+		// Passes with side effects outside of the graph are never culled
+		bool _sideEffects = false;
+
+		// Filled in when the graph compiles
+		uint32_t _refCount = 0;
+		bool _culled = false;
+		std::vector<RenderBarrier> _barriers;
+		// Transient targets whose lifetime starts or ends with this pass
+		std::vector<RenderResourceHandle> _acquires;
+		std::vector<RenderResourceHandle> _releases;
 	};
-}
\ No newline at end of file
+}
@@ -1,12 +1,49 @@
 #pragma once
 
 #include "GpuResource.hxx"
+#include "Texture.hxx"
+
+#include <cstdint>
+#include <memory>
 
 namespace kyanite::engine::rendering {
+	enum class RenderTargetFormat {
+		RGBA8,
+		RGBA16F,
+	};
+
+	struct RenderTargetDesc {
+		uint32_t width;
+		uint32_t height;
+		RenderTargetFormat format;
+		// Attaches a depth buffer, which is only written and tested, never sampled
+		bool depth;
+
+		auto operator==(const RenderTargetDesc& other) const -> bool = default;
+	};
+
+	// What a render target is used as, render graphs transition targets between these between passes
+	enum class ResourceState {
+		// The contents are not needed any more and may be discarded
+		Undefined,
+		RenderTarget,
+		ShaderResource,
+	};
+
 	class RenderTarget : public GpuResource {
 	public:
-        explicit RenderTarget(uint64_t address) : GpuResource(address) {}
+		RenderTarget(uint64_t address, const RenderTargetDesc& desc) : GpuResource(address), _desc(desc) {}
+
+		virtual ~RenderTarget() = default;
+
+		auto Desc() const -> const RenderTargetDesc& { return _desc; }
+
+		/**
+		* @brief The colour attachment, for passes that sample what an earlier pass rendered
+		*/
+		virtual auto ColorTexture() const -> std::shared_ptr<Texture> = 0;
 
-        virtual ~RenderTarget() = default;
+	private:
+		RenderTargetDesc _desc;
 	};
-}
\ No newline at end of file
+}
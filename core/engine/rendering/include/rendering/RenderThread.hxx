@@ -0,0 +1,87 @@
+#pragma once
+
+#include "FramePacket.hxx"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief A thread that owns the graphics context and draws the frame packets the simulation hands over
+	* @note Packets and jobs share one queue, so a job posted during a frame runs after the packets before it and
+	* before the packet of its own frame. Only packets count against the frame limit, jobs are never dropped.
+	*/
+	class RenderThread {
+	public:
+		/**
+		* @param maxFramesInFlight The number of packets that may wait or be drawn before Submit blocks
+		* @param attach Called on the new thread before anything else, makes the graphics context current
+		* @param render Called on the thread for every packet, in submission order
+		* @param detach Called on the thread after the last packet, releases the graphics context
+		*/
+		RenderThread(
+			size_t maxFramesInFlight,
+			std::function<void()> attach,
+			std::function<void(FramePacket&)> render,
+			std::function<void()> detach
+		);
+		/**
+		* @brief Draws the packets that are still queued, then stops the thread
+		*/
+		~RenderThread();
+
+		RenderThread(const RenderThread&) = delete;
+		RenderThread& operator=(const RenderThread&) = delete;
+
+		/**
+		* @brief Hands a packet to the thread, waiting while the limit of frames in flight is reached
+		*/
+		auto Submit(std::unique_ptr<FramePacket> packet) -> void;
+
+		/**
+		* @brief Queues a job and returns immediately
+		*/
+		auto Post(std::function<void()> job) -> void;
+
+		/**
+		* @brief Runs a job on the thread and waits for its result. Runs it directly if called from the thread
+		*/
+		template<typename Job>
+		auto Invoke(Job&& job) -> std::invoke_result_t<Job&> {
+			if (IsCurrent()) {
+				return job();
+			}
+
+			auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Job&>()>>(std::forward<Job>(job));
+			auto result = task->get_future();
+			Post([task]() { (*task)(); });
+
+			return result.get();
+		}
+
+		auto IsCurrent() const -> bool { return std::this_thread::get_id() == _thread.get_id(); }
+
+	private:
+		auto Run() -> void;
+
+		std::function<void()> _attach;
+		std::function<void(FramePacket&)> _render;
+		std::function<void()> _detach;
+		std::deque<std::function<void()>> _work;
+		std::mutex _lock;
+		std::condition_variable _workSignal;
+		std::condition_variable _frameSignal;
+		size_t _maxFramesInFlight;
+		size_t _framesInFlight = 0;
+		bool _stopping = false;
+		// Started last, everything above has to exist once it runs
+		std::thread _thread;
+	};
+}
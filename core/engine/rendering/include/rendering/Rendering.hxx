@@ -1,6 +1,10 @@
 #pragma once
 
+#include "Buffer.hxx"
+#include "FrameStats.hxx"
+#include "FrameTimings.hxx"
 #include "Mesh.hxx"
+#include "RenderBackendType.hxx"
 #include "Renderer.hxx"
 #include "Shader.hxx"
 #include "Texture.hxx"
@@ -15,25 +19,103 @@
 namespace kyanite::engine::rendering {
 	// Lifecycle
 	auto Init(NativePointer window, ImGuiContext* imGuiContext) -> void;
+	/**
+	* @brief Initializes rendering without a window, frames are presented into an offscreen backbuffer
+	* @param width The width of the backbuffer
+	* @param height The height of the backbuffer
+	* @param backend OpenGL renders offscreen, Null only records and counts what would have been rendered
+	*/
+	auto InitHeadless(
+		uint32_t width,
+		uint32_t height,
+		ImGuiContext* imGuiContext,
+		RenderBackendType backend = RenderBackendType::OpenGL
+	) -> void;
 	auto Shutdown() -> void;
 	extern auto PreFrame() -> void;
 	extern auto Update(float deltaTime) -> void;
 	extern auto PostFrame() -> void;
+	/**
+	* @brief Moves the graphics context to a render thread that draws each frame while the next one is simulated
+	* @param maxFramesInFlight How many frames the simulation may run ahead before PostFrame blocks
+	*/
+	auto StartRenderThread(size_t maxFramesInFlight = 1) -> void;
+	/**
+	* @brief Draws the frames still in flight and moves the graphics context back to the calling thread
+	*/
+	auto StopRenderThread() -> void;
 	
 	// Resource creation
 	auto LoadTexture(const uint8_t* data, size_t len) -> uint32_t;
+	auto LoadTextureFile(std::string_view path) -> uint32_t;
 	auto LoadShader(std::string code, ShaderType type) -> uint32_t;
 	auto LoadModel(std::string_view path) -> std::vector<Mesh>;
 	auto CreateMaterial(uint32_t pixelShader, uint32_t vertexShader, bool isInstanced) -> uint32_t;
 	auto CopyMaterial(uint32_t materialId) -> uint32_t;
-	auto CreateVertexBuffer(const void* data, size_t size, size_t elemSize) -> uint32_t;
-	auto CreateIndexBuffer(const uint32_t* indices, size_t len) -> uint32_t;
+	auto CreateVertexBuffer(const void* data, size_t size, size_t elemSize, BufferUsage usage = BufferUsage::Static) -> uint32_t;
+	auto CreateIndexBuffer(const uint32_t* indices, size_t len, BufferUsage usage = BufferUsage::Static) -> uint32_t;
+	/**
+	* @brief Replaces the contents of a buffer, it takes the size of the new contents
+	* @param size The size of the new contents in bytes
+	* @note Does not wait for the render thread. Buffers updated every frame should be created with a Dynamic or Stream usage
+	*/
 	auto UpdateVertexBuffer(uint32_t buffer, const void* data, size_t size) -> void;
 	auto UpdateIndexBuffer(uint32_t buffer, const void* data, size_t size) -> void;
+	/**
+	* @brief Overwrites part of a buffer and keeps the rest
+	* @param offset The offset in bytes, offset + size must lie inside the buffer
+	*/
+	auto UpdateVertexBufferRange(uint32_t buffer, size_t offset, const void* data, size_t size) -> void;
+	auto UpdateIndexBufferRange(uint32_t buffer, size_t offset, const void* data, size_t size) -> void;
 	auto CreateVertexArray(uint32_t vertexBufferId, uint32_t indexBufferId) -> uint32_t;
+	/**
+	* @brief Places a mesh in the shared mesh buffer
+	* @return A vertex array handle that DrawIndexed accepts, draws of such meshes share one vertex array binding
+	*/
+	auto CreateMesh(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount) -> uint32_t;
+	auto LoadAtlas(const uint8_t* data, size_t len) -> uint32_t;
+
+	// Sprite atlases
+	constexpr uint32_t InvalidAtlasPage = UINT32_MAX;
+	/**
+	* @brief Looks up a named region of a sprite atlas
+	* @param uvRect Receives u0, v0, u1, v1 of the region
+	* @return The atlas page that holds the region, or InvalidAtlasPage if it does not exist
+	*/
+	auto GetAtlasRegion(uint32_t atlas, const char* name, glm::vec4& uvRect) -> uint32_t;
+
+	// Tilemaps
+	/**
+	* @brief Creates an empty tilemap, drawn as one mesh per chunk of 32 by 32 tiles
+	* @param tileSize The size of a tile in world units
+	* @param atlasColumns The number of tile columns in the texture of the material
+	* @param atlasRows The number of tile rows in the texture of the material
+	*/
+	auto CreateTilemap(
+		uint32_t width,
+		uint32_t height,
+		glm::vec2 tileSize,
+		uint32_t atlasColumns,
+		uint32_t atlasRows,
+		uint32_t material
+	) -> uint32_t;
+	/**
+	* @brief Replaces a rectangle of tiles, row by row. Tiles count atlas cells from 1, 0 is empty
+	* @note Only the chunks whose tiles changed are rebuilt, at the start of the frame after the map is drawn.
+	* Safe to call from a system running in parallel with the ones drawing the map, but not from two at once for one map.
+	*/
+	auto SetTilemapTiles(uint32_t tilemap, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint16_t* tiles) -> void;
+	/**
+	* @brief Draws the chunks of a tilemap that intersect the view, one draw per chunk
+	* @param position Where the lower left corner of the map is placed
+	* @note Safe to call from parallel systems, it only reads the map. Chunks without a mesh yet appear from the next frame.
+	*/
+	auto DrawTilemap(uint32_t tilemap, glm::vec3 position, uint16_t layer = 0) -> void;
 
 	// Resource destruction
 	auto UnloadShader(uint64_t shader) -> void;
+	auto DestroyMesh(uint32_t mesh) -> void;
+	auto DestroyTilemap(uint32_t tilemap) -> void;
 
 	// State management
 	auto SetClearColor(float r, float g, float b, float a) -> void;
@@ -43,7 +125,78 @@ namespace kyanite::engine::rendering {
 		uint32_t vao,
 		uint32_t material
 	) -> void;
-	extern auto DrawSprite(glm::mat4 model, uint32_t material) -> void;
+	/**
+	* @brief Draws a sprite
+	* @param layer Higher is in front, at the same depth also of opaque draws. Orders blended sprites before their depth does.
+	*/
+	extern auto DrawSprite(
+		glm::mat4 model,
+		uint32_t material,
+		glm::vec4 uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+		uint16_t layer = 0
+	) -> void;
+	/**
+	* @brief Draws many sprites at once, exactly like calling DrawSprite with the matrix scripts build for each
+	* @param count The number of sprites
+	* @param positions The x, y and z of every sprite
+	* @param rotations The rotation of every sprite around z, in radians
+	* @param scales The x, y and z scale of every sprite
+	* @param materialIds The material of every sprite
+	* @param uvRects The region every sprite samples (u0, v0, u1, v1), whole textures if null
+	*/
+	auto DrawSprites(
+		size_t count,
+		const float* positions,
+		const float* rotations,
+		const float* scales,
+		const uint32_t* materialIds,
+		const float* uvRects = nullptr
+	) -> void;
+	/**
+	* @brief Draws a sprite through the sprite batcher, which draws each layer with one call per material
+	* @param color The RGBA8 tint, red in the lowest byte
+	* @param layer Higher is in front of all draws at the same depth. Within a layer batched sprites are drawn last.
+	* @param material A material whose vertex shader reads the per instance attributes of SpriteInstance
+	*/
+	auto DrawBatchedSprite(
+		glm::vec2 position,
+		float rotation,
+		glm::vec2 scale,
+		glm::vec4 uvRect,
+		uint32_t color,
+		uint16_t layer,
+		uint32_t material
+	) -> void;
 
 	auto SetMaterialTexture(uint32_t materialId, uint32_t textureId, const char* name) -> void;
+	/**
+	* @brief Draws a material in the opaque pass, depth tested and written and not blended, instead of the blended pass
+	*/
+	auto SetMaterialOpaque(uint32_t materialId, bool opaque) -> void;
+	/**
+	* @brief Whether the shaders of a material finished compiling, it is drawn with a fallback until they have
+	* @note Never waits for the render thread, the answer is as of the last frame it drew
+	*/
+	auto IsMaterialReady(uint32_t materialId) -> bool;
+	auto SetMaterialFloat(uint32_t materialId, const char* name, float value) -> void;
+	auto SetMaterialInt(uint32_t materialId, const char* name, uint32_t value) -> void;
+	auto SetMaterialVector(uint32_t materialId, const char* name, const float* values, size_t count) -> void;
+
+	// Diagnostics
+	/**
+	* @brief The counters of the last presented frame
+	*/
+	auto GetFrameStats() -> FrameStats;
+	/**
+	* @brief Writes the next presented frame to a PNG file, if the device supports reading frames back
+	*/
+	auto CaptureFrame(std::string_view path) -> void;
+	/**
+	* @brief CPU times of the last frame and GPU times of its timed scopes, which lag a few frames behind
+	*/
+	auto GetFrameTimings() -> FrameTimings;
+	/**
+	* @brief Shows or hides an ImGui window with the frame timings
+	*/
+	auto SetTimingOverlay(bool visible) -> void;
 }
\ No newline at end of file
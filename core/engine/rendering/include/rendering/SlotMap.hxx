@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief Generational slot map that stores its values contiguously
+	* @note Handles are 32 bit so they can cross the bridge unchanged. The low bits index a slot,
+	* the high bits hold the generation of that slot. Generations start at 1, so 0 is never a valid handle.
+	*/
+	template<typename T>
+	class SlotMap {
+	public:
+		using Handle = uint32_t;
+
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t GenerationBits = 32 - IndexBits;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+		static constexpr uint32_t GenerationMask = (1u << GenerationBits) - 1;
+		static constexpr Handle InvalidHandle = 0;
+
+		/**
+		* @brief Inserts a value and returns its handle
+		* @param value The value to insert
+		* @return The handle of the value, or InvalidHandle if the map is full
+		*/
+		auto Insert(T value) -> Handle {
+			uint32_t slotIndex;
+			if (_freeHead != NoSlot) {
+				slotIndex = _freeHead;
+				_freeHead = _slots[slotIndex].next;
+			}
+			else {
+				if (_slots.size() > IndexMask) {
+					return InvalidHandle;
+				}
+				slotIndex = static_cast<uint32_t>(_slots.size());
+				_slots.push_back(Slot { 1, 0, NoSlot });
+			}
+
+			auto& slot = _slots[slotIndex];
+			slot.valueIndex = static_cast<uint32_t>(_values.size());
+			slot.next = NoSlot;
+			_values.push_back(std::move(value));
+			_valueSlots.push_back(slotIndex);
+
+			return MakeHandle(slotIndex, slot.generation);
+		}
+
+		/**
+		* @brief Removes the value of a handle, invalidating the handle and all its copies
+		* @param handle The handle to remove
+		* @return True if the handle was alive, false otherwise
+		*/
+		auto Remove(Handle handle) -> bool {
+			if (!Contains(handle)) {
+				return false;
+			}
+
+			auto slotIndex = handle & IndexMask;
+			auto& slot = _slots[slotIndex];
+
+			// Keep the values dense by moving the last value into the hole
+			auto last = static_cast<uint32_t>(_values.size() - 1);
+			if (slot.valueIndex != last) {
+				_values[slot.valueIndex] = std::move(_values[last]);
+				_valueSlots[slot.valueIndex] = _valueSlots[last];
+				_slots[_valueSlots[last]].valueIndex = slot.valueIndex;
+			}
+			_values.pop_back();
+			_valueSlots.pop_back();
+
+			// Bump the generation so stale handles are detected, skipping 0 on wrap around
+			slot.generation = (slot.generation + 1) & GenerationMask;
+			if (slot.generation == 0) {
+				slot.generation = 1;
+			}
+			slot.next = _freeHead;
+			_freeHead = slotIndex;
+
+			return true;
+		}
+
+		/**
+		* @brief Checks if a handle refers to a live value
+		* @param handle The handle to check
+		* @return True if the handle is alive, false if it is invalid or stale
+		*/
+		auto Contains(Handle handle) const -> bool {
+			auto slotIndex = handle & IndexMask;
+			if (handle == InvalidHandle || slotIndex >= _slots.size()) {
+				return false;
+			}
+
+			return _slots[slotIndex].generation == (handle >> IndexBits);
+		}
+
+		/**
+		* @brief Resolves a handle
+		* @param handle The handle to resolve
+		* @return A pointer to the value, or nullptr if the handle is invalid or stale
+		* @note The pointer is invalidated by the next Insert or Remove
+		*/
+		auto Get(Handle handle) -> T* {
+			return Contains(handle) ? &_values[_slots[handle & IndexMask].valueIndex] : nullptr;
+		}
+
+		auto Get(Handle handle) const -> const T* {
+			return Contains(handle) ? &_values[_slots[handle & IndexMask].valueIndex] : nullptr;
+		}
+
+		auto Size() const -> size_t { return _values.size(); }
+		auto Empty() const -> bool { return _values.empty(); }
+
+		auto Clear() -> void {
+			// Invalidate every handle that is still alive before dropping the values
+			while (!_valueSlots.empty()) {
+				auto slotIndex = _valueSlots.back();
+				Remove(MakeHandle(slotIndex, _slots[slotIndex].generation));
+			}
+		}
+
+		// Iteration is over the dense values, in no particular order
+		auto begin() { return _values.begin(); }
+		auto end() { return _values.end(); }
+		auto begin() const { return _values.begin(); }
+		auto end() const { return _values.end(); }
+
+	private:
+		static constexpr uint32_t NoSlot = UINT32_MAX;
+
+		struct Slot {
+			uint32_t generation;
+			uint32_t valueIndex;
+			uint32_t next;
+		};
+
+		static constexpr auto MakeHandle(uint32_t slotIndex, uint32_t generation) -> Handle {
+			return (generation << IndexBits) | slotIndex;
+		}
+
+		std::vector<Slot> _slots;
+		std::vector<T> _values;
+		std::vector<uint32_t> _valueSlots;
+		uint32_t _freeHead = NoSlot;
+	};
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <shared/AtlasFormat.hxx>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief The regions of a texture atlas produced by the bundler
+	*/
+	struct SpriteAtlas {
+		struct Region {
+			uint32_t page;
+			// u0, v0, u1, v1
+			glm::vec4 uvRect;
+		};
+
+		uint32_t pageCount = 0;
+		std::unordered_map<std::string, Region> regions;
+
+		/**
+		* @brief Reads the contents of a .atlas file
+		* @param data The file contents
+		* @param len The length of the contents
+		* @param atlas The atlas to fill
+		* @return True if the data was a valid atlas, false otherwise
+		*/
+		static auto Parse(const uint8_t* data, size_t len, SpriteAtlas& atlas) -> bool {
+			shared::AtlasHeader header;
+			if (len < sizeof(header)) {
+				return false;
+			}
+			std::memcpy(&header, data, sizeof(header));
+
+			if (header.magic != shared::AtlasMagic || header.version != shared::AtlasVersion) {
+				return false;
+			}
+			if (len < sizeof(header) + static_cast<size_t>(header.regionCount) * sizeof(shared::AtlasRegion)) {
+				return false;
+			}
+
+			atlas.pageCount = header.pageCount;
+			atlas.regions.reserve(header.regionCount);
+			for (uint32_t x = 0; x < header.regionCount; x++) {
+				shared::AtlasRegion region;
+				std::memcpy(&region, data + sizeof(header) + x * sizeof(region), sizeof(region));
+				region.name[shared::AtlasNameLength - 1] = '\0';
+
+				atlas.regions[region.name] = Region { region.page, glm::vec4(region.u0, region.v0, region.u1, region.v1) };
+			}
+
+			return true;
+		}
+	};
+}
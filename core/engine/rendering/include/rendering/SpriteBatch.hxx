@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Culling.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief One batched sprite as the GPU reads it, 32 bytes where an indexed or indirect sprite needs 80
+	* @note Batched sprite materials expand the shared quad with per instance attributes:
+	* 2 is vec3(position, rotation), 3 the scale, 4 the texture region (u0, v0, u1, v1) and 5 the tint.
+	*/
+	struct SpriteInstance {
+		glm::vec2 position;
+		// Counter clockwise, in radians
+		float rotation;
+		// Width and height in world units, as two half floats
+		uint32_t scale;
+		// The texture region in 1/65535ths of the texture, read as normalised shorts
+		uint16_t uvRect[4];
+		// RGBA8 with red in the lowest byte, read as normalised bytes
+		uint32_t color;
+		// Lower layers are drawn first, the GPU does not read it
+		uint16_t layer;
+		uint16_t padding;
+
+		/**
+		* @brief Packs a sprite, regions outside of 0 to 1 are clamped
+		*/
+		static auto Pack(
+			glm::vec2 position,
+			float rotation,
+			glm::vec2 scale,
+			glm::vec4 uvRect,
+			uint32_t color,
+			uint16_t layer
+		) -> SpriteInstance;
+	};
+
+	static_assert(sizeof(SpriteInstance) == 32, "Sprite instances are read with a stride of 32 bytes");
+
+	// Sprites of one layer and one material, drawn with one instanced call
+	struct SpriteBatch {
+		uint32_t material;
+		uint16_t layer;
+		uint32_t firstInstance;
+		uint32_t instanceCount;
+	};
+
+	/**
+	* @brief Culls submitted sprites and orders the rest into one batch per layer and material
+	* @param frustum The frustum to cull against, sprites are tested by the circle around them
+	* @param sprites The submitted sprites
+	* @param materials The material of every submitted sprite
+	* @param instances Receives the visible sprites, ordered by layer and then material
+	* @param batches Receives the batches, in draw order
+	* @note Sprites of the same layer and material keep the order they were submitted in
+	*/
+	auto BatchSprites(
+		const Frustum& frustum,
+		const std::vector<SpriteInstance>& sprites,
+		const std::vector<uint32_t>& materials,
+		std::vector<SpriteInstance>& instances,
+		std::vector<SpriteBatch>& batches
+	) -> void;
+}
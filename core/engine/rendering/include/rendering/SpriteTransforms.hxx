@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief Builds the model matrices of sprites from their transforms, several sprites at a time where the CPU allows
+	* @param count The number of sprites
+	* @param positions The x, y and z of every sprite
+	* @param rotations The rotation of every sprite around z, in radians
+	* @param scales The x, y and z scale of every sprite
+	* @param models Receives one matrix per sprite, laid out like the ones scripts build for DrawSprite
+	* @note Uses AVX2 and FMA when the CPU has them and NEON on ARM, sines and cosines are within a few ulp of the C library
+	*/
+	auto BuildSpriteTransforms(
+		size_t count,
+		const float* positions,
+		const float* rotations,
+		const float* scales,
+		glm::mat4* models
+	) -> void;
+
+	/**
+	* @brief Builds the same matrices as BuildSpriteTransforms one sprite at a time with the C library's sine and cosine
+	* @note The reference the vector paths are checked against, the renderer always calls BuildSpriteTransforms
+	*/
+	auto BuildSpriteTransformsScalar(
+		size_t count,
+		const float* positions,
+		const float* rotations,
+		const float* scales,
+		glm::mat4* models
+	) -> void;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Bounds.hxx"
+#include "CommandList.hxx"
+#include "VertexBuffer.hxx"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	// New local bounds of a vertex buffer, staged together with its vertices
+	struct BoundsUpdate {
+		std::shared_ptr<VertexBuffer> buffer;
+		Bounds bounds;
+		// The bounds replace the old ones, instead of growing them
+		bool replace;
+	};
+
+	/**
+	* @brief The buffer updates of one frame, taken out of the upload context when the packet of the frame is built
+	* @note The bounds are applied before the packet is culled and the copies when it is drawn, so both match the frame
+	*/
+	struct StagedBuffers {
+		std::shared_ptr<std::vector<uint8_t>> data;
+		std::vector<BufferCopy> copies;
+		std::vector<BoundsUpdate> bounds;
+	};
+}
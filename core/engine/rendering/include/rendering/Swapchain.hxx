@@ -2,13 +2,29 @@
 
 #include <SDL2/SDL.h>
 
+#include <filesystem>
+#include <iostream>
+
 namespace kyanite::engine::rendering {
 	class Swapchain {
 	public:
 		Swapchain(SDL_Window* window) : _window(window) {}
 		virtual ~Swapchain() = default;
 		virtual auto Swap() -> void = 0;
+
+		/**
+		* @brief Writes the next presented frame to a PNG file
+		*/
+		virtual auto RequestCapture(std::filesystem::path path) -> void {
+			std::cerr << "This swapchain cannot capture frames" << std::endl;
+		}
+
+		/**
+		* @brief The GPU time of the last presented frame in milliseconds, 0 if the swapchain does not measure it
+		*/
+		virtual auto GpuFrameTime() const -> double { return 0.0; }
+
 	protected:
 		SDL_Window* _window;
 	};
-}
\ No newline at end of file
+}
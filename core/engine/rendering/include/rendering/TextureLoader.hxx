@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Texture.hxx"
+#include "UploadContext.hxx"
+#include "WorkerPool.hxx"
+
+#include <io/filesystem/MappedFile.hxx>
+
+#include <cstdint>
+#include <memory>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief Decodes images on the worker pool and hands the pixels to the upload context
+	* @note Cooked .ktex files skip the decode and go to the upload context as they are
+	*/
+	class TextureLoader {
+	public:
+		TextureLoader(WorkerPool& pool, UploadContext& uploadContext) : _pool(pool), _uploadContext(uploadContext) {}
+
+		/**
+		* @brief Decodes an encoded image in the background and uploads it into the texture once done
+		* @param texture The texture that receives the image. It keeps its placeholder image until then
+		* @param data The encoded image. The format is detected from the data
+		* @param len The length of the data
+		* @note The data is copied, so the caller may free it right away
+		*/
+		auto Load(const std::shared_ptr<Texture>& texture, const uint8_t* data, size_t len) -> void;
+
+		/**
+		* @brief Uploads a mapped file into the texture
+		* @param texture The texture that receives the image
+		* @param file The mapped file. Cooked textures are uploaded straight from the mapping, which stays open until then
+		*/
+		auto Load(const std::shared_ptr<Texture>& texture, std::shared_ptr<io::MappedFile> file) -> void;
+
+	private:
+		auto LoadCompressed(const std::shared_ptr<Texture>& texture, std::shared_ptr<const uint8_t> data, size_t len) -> void;
+
+		WorkerPool& _pool;
+		UploadContext& _uploadContext;
+	};
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Bounds.hxx"
+#include "Vertex.hxx"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief A static grid of tiles, drawn as one mesh per chunk of 32 by 32 tiles
+	* @note Tiles are cells of an atlas texture counted row by row from 1, 0 leaves a tile empty. Changing tiles
+	* only marks their chunk dirty, its mesh is rebuilt at the start of the frame after the map is drawn.
+	* The dirty flags may be read while tiles change on another thread, everything else is only read during a frame.
+	*/
+	class Tilemap {
+	public:
+		static constexpr uint32_t ChunkSize = 32;
+		static constexpr uint16_t EmptyTile = 0;
+
+		struct Chunk {
+			// The mesh of the chunk, invalid while the chunk has no tiles
+			uint32_t mesh;
+			// The tiles of the chunk changed since its mesh was built
+			std::atomic<bool> dirty = true;
+			// Local bounds of the chunk, to cull it before its draw is submitted
+			Bounds bounds;
+		};
+
+		/**
+		* @param width The number of tiles in a row
+		* @param height The number of rows
+		* @param tileSize The size of a tile in world units
+		* @param atlasColumns The number of tile columns in the atlas texture
+		* @param atlasRows The number of tile rows in the atlas texture
+		* @param material The material the tiles are drawn with
+		* @param invalidMesh The id chunks without tiles hold
+		*/
+		Tilemap(
+			uint32_t width,
+			uint32_t height,
+			glm::vec2 tileSize,
+			uint32_t atlasColumns,
+			uint32_t atlasRows,
+			uint32_t material,
+			uint32_t invalidMesh
+		);
+
+		/**
+		* @brief Replaces a rectangle of tiles, parts outside of the map are ignored
+		* @param x The column of the first tile
+		* @param y The row of the first tile
+		* @param width The width of the rectangle
+		* @param height The height of the rectangle
+		* @param tiles The tiles row by row, width * height of them
+		*/
+		auto SetTiles(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint16_t* tiles) -> void;
+
+		/**
+		* @brief Builds the mesh of a chunk in the local space of the map, two triangles per tile that is not empty
+		* @param chunk The index of the chunk
+		* @param vertices Receives the vertices
+		* @param indices Receives the indices, relative to the first vertex
+		*/
+		auto BuildChunk(size_t chunk, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const -> void;
+
+		/**
+		* @brief Whether any chunk changed since its mesh was built
+		*/
+		auto HasDirtyChunks() const -> bool;
+
+		/**
+		* @brief Marks the map as waiting for its chunks to be rebuilt
+		* @return Whether it was not waiting yet, so only the first of many draws queues it
+		*/
+		auto QueueRebuild() -> bool { return !_queued.exchange(true); }
+		/**
+		* @brief Ends the wait before the chunks are rebuilt, changes made from then on queue the map again
+		*/
+		auto StartRebuild() -> void { _queued = false; }
+
+		auto Chunks() -> std::vector<Chunk>& { return _chunks; }
+		auto MaterialId() const -> uint32_t { return _material; }
+
+	private:
+		uint32_t _width;
+		uint32_t _height;
+		glm::vec2 _tileSize;
+		uint32_t _atlasColumns;
+		uint32_t _atlasRows;
+		uint32_t _material;
+		uint32_t _chunkColumns;
+		std::vector<uint16_t> _tiles;
+		std::vector<Chunk> _chunks;
+		std::atomic<bool> _queued = false;
+	};
+}
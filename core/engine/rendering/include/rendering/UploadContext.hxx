@@ -1,26 +1,152 @@
 #pragma once
 
+#include "Bounds.hxx"
 #include "Context.hxx"
+#include "StagedBuffers.hxx"
+#include "Texture.hxx"
+
+#include <shared/TextureFormat.hxx>
+
+#include <concurrentqueue/concurrentqueue.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace kyanite::engine::rendering {
 	class UploadContext : public Context {
+		struct TextureUpload {
+			std::shared_ptr<Texture> texture;
+			uint32_t width;
+			uint32_t height;
+			std::shared_ptr<std::vector<uint8_t>> pixels;
+		};
+
+		struct CompressedTextureUpload {
+			std::shared_ptr<Texture> texture;
+			shared::TextureFormat format;
+			std::vector<shared::TextureLevel> levels;
+			std::shared_ptr<const uint8_t> data;
+			size_t size;
+		};
+
 	public:
+		// Enough for two 2048x2048 RGBA images per frame
+		static constexpr size_t DefaultBudget = 32 * 1024 * 1024;
+
 		UploadContext(
 			const std::shared_ptr<Device>& device,
 			std::shared_ptr<CommandQueue> queue
 		) : Context(CommandListType::Copy, device, queue) { }
+
+		/**
+		* @brief Queues new contents for a vertex buffer, its storage is replaced at the new size
+		* @param buffer The buffer to replace
+		* @param data The new contents, copied before this returns
+		* @param size The size of the contents in bytes
+		* @param bounds The local bounds of the new contents, null leaves the bounds as they are
+		* @note Thread safe. All buffer updates of a frame are taken out together by TakeStagedBuffers
+		*/
 		auto UpdateVertexBuffer(
 			const std::shared_ptr<VertexBuffer>& buffer,
 			const void* data,
-			size_t size
+			size_t size,
+			const Bounds* bounds = nullptr
 		) -> void;
+
+		/**
+		* @brief Queues new contents for an index buffer, its index count follows the new size
+		* @param buffer The buffer to replace
+		* @param data The new indices, copied before this returns
+		* @param size The size of the indices in bytes
+		* @note Thread safe
+		*/
 		auto UpdateIndexBuffer(
 			const std::shared_ptr<IndexBuffer>& buffer,
 			const void* data,
 			size_t size
 		) -> void;
+
+		/**
+		* @brief Queues a write into part of a buffer, the rest of its contents stays as it is
+		* @param buffer The buffer to write to
+		* @param offset The offset of the write in bytes, the write must lie inside the buffer
+		* @param data The bytes to write, copied before this returns
+		* @param size The number of bytes
+		* @param bounds Bounds the written vertices add to the bounds of the buffer, null leaves them as they are
+		* @note Thread safe
+		*/
+		auto UpdateBufferRange(
+			const std::shared_ptr<Buffer>& buffer,
+			size_t offset,
+			const void* data,
+			size_t size,
+			const Bounds* bounds = nullptr
+		) -> void;
+
+		/**
+		* @brief Queues decoded pixels for upload into a texture
+		* @param texture The texture to upload to
+		* @param width The width of the image
+		* @param height The height of the image
+		* @param pixels Tightly packed 32 bit BGRA pixels
+		* @note Thread safe. The upload happens in one of the following Finish calls, depending on the budget
+		*/
+		auto UploadTexture(
+			const std::shared_ptr<Texture>& texture,
+			uint32_t width,
+			uint32_t height,
+			std::shared_ptr<std::vector<uint8_t>> pixels
+		) -> void;
+
+		/**
+		* @brief Queues precompressed blocks for upload into a texture
+		* @param texture The texture to upload to
+		* @param format The block format of all levels
+		* @param levels The levels to upload, largest first
+		* @param data The base the level offsets are relative to, usually a mapped .ktex file
+		* @note Thread safe. Counts against the same budget as UploadTexture
+		*/
+		auto UploadCompressedTexture(
+			const std::shared_ptr<Texture>& texture,
+			shared::TextureFormat format,
+			std::vector<shared::TextureLevel> levels,
+			std::shared_ptr<const uint8_t> data
+		) -> void;
+
+		/**
+		* @brief Sets how many bytes of texture data Finish may upload per frame
+		* @param bytes The budget in bytes
+		* @note At least one pending upload is done per frame, even if it exceeds the budget
+		*/
+		auto SetBudget(size_t bytes) -> void { _budget = bytes; }
+
+		/**
+		* @brief Takes out every buffer update staged since the last call, later updates go into a new frame
+		* @note Thread safe. Called once per frame, when the packet of the frame is built
+		*/
+		auto TakeStagedBuffers() -> StagedBuffers;
+
+		/**
+		* @brief Records the copies of a frame, uploaded by the next Finish
+		* @note Called on the thread that records, right before the frame is drawn
+		*/
+		auto UploadStagedBuffers(StagedBuffers staged) -> void;
+
 		virtual ~UploadContext() = default;
 		virtual auto Begin() -> void override;
 		virtual auto Finish() -> void override;
+
+	private:
+		auto Stage(const std::shared_ptr<Buffer>& buffer, size_t offset, const void* data, size_t size, bool replace, const Bounds* bounds) -> void;
+
+		// Updates of the frame being simulated. Packets in flight own the blocks of earlier frames.
+		std::mutex _stagingLock;
+		StagedBuffers _staged = { std::make_shared<std::vector<uint8_t>>() };
+
+		moodycamel::ConcurrentQueue<TextureUpload> _pendingTextures;
+		moodycamel::ConcurrentQueue<CompressedTextureUpload> _pendingCompressedTextures;
+		size_t _budget = DefaultBudget;
 	};
-}
\ No newline at end of file
+}
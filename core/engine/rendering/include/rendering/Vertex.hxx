@@ -7,10 +7,20 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
+
 namespace kyanite::engine::rendering {
 	struct Vertex {
 		glm::vec3 position;
 		glm::vec2 uvs;
 
 	};
+
+	// How the vertices of a buffer are stored. The GPU expands every layout to the float attributes the shaders read.
+	enum class VertexLayout : uint32_t {
+		// Vertex as declared above
+		Float32 = 1,
+		// Half float position padded to four halves, half float uvs, 12 bytes
+		Half16 = 2
+	};
 }
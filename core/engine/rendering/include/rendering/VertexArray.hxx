@@ -18,9 +18,13 @@ namespace kyanite::engine::rendering {
 		virtual auto Id() const->uint32_t = 0;
 		virtual auto Bind() const->void = 0;
 		virtual auto Indices() const->uint32_t = 0;
+		// Arrays that share their buffers with other meshes draw from an offset into them
+		virtual auto FirstIndex() const -> uint32_t { return 0; }
+		virtual auto BaseVertex() const -> int32_t { return 0; }
 
 		auto IndexBuffer() const -> std::shared_ptr<IndexBuffer> { return _indexBuffer; }
 		auto VertexBuffer() const -> std::shared_ptr<VertexBuffer> { return _vertexBuffer; }
+		virtual auto LocalBounds() const -> const Bounds& { return _vertexBuffer->LocalBounds(); }
 
 	private:
 		std::shared_ptr<engine::rendering::IndexBuffer> _indexBuffer;
@@ -1,16 +1,29 @@
 #pragma once
 
+#include "Bounds.hxx"
 #include "Buffer.hxx"
+#include "Vertex.hxx"
 
 #include <cstdint>
 
 namespace kyanite::engine::rendering {
 	class VertexBuffer: public Buffer {
 	public:
-		VertexBuffer(size_t size) : Buffer(size) {};
+		VertexBuffer(size_t size, BufferUsage usage = BufferUsage::Static) : Buffer(size, usage) {};
 		virtual ~VertexBuffer() = 0 {}
-		virtual auto Id() const->uint64_t = 0;
 		virtual void SetData(const void* data, size_t size) = 0;
+		// Overwrites bytes [offset, offset + size) and keeps the rest of the storage
+		virtual void SetSubData(size_t offset, const void* data, size_t size) = 0;
 		virtual void Bind() const = 0;
+
+		auto LocalBounds() const -> const Bounds& { return _bounds; }
+		auto SetLocalBounds(const Bounds& bounds) -> void { _bounds = bounds; }
+
+		auto Layout() const -> VertexLayout { return _layout; }
+		auto SetLayout(VertexLayout layout) -> void { _layout = layout; }
+
+	private:
+		Bounds _bounds;
+		VertexLayout _layout = VertexLayout::Float32;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kyanite::engine::rendering {
+	/**
+	* @brief A fixed set of worker threads for renderer side jobs
+	*/
+	class WorkerPool {
+	public:
+		/**
+		* @brief Creates the pool
+		* @param threads The number of worker threads. 0 uses the hardware concurrency minus the calling thread
+		*/
+		explicit WorkerPool(uint32_t threads = 0);
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		/**
+		* @brief Queues a job and returns immediately
+		* @param job The job to run on a worker thread
+		*/
+		auto Submit(std::function<void()> job) -> void;
+
+		/**
+		* @brief Splits [0, count) into batches and runs them in parallel, returning once all batches are done
+		* @param count The number of items
+		* @param batchSize The number of items per batch
+		* @param job Called with the begin and end of each batch
+		* @note The calling thread works on batches as well
+		*/
+		auto Dispatch(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& job) -> void;
+
+		auto ThreadCount() const -> size_t { return _threads.size(); }
+
+	private:
+		auto Run() -> void;
+
+		std::vector<std::thread> _threads;
+		std::deque<std::function<void()>> _jobs;
+		std::mutex _lock;
+		std::condition_variable _signal;
+		bool _stopping = false;
+	};
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../CommandList.hxx"
+#include "NullStateTracker.hxx"
+
+#include <vector>
+
+namespace kyanite::engine::rendering::null {
+	/**
+	* @brief Records what a GPU would have been asked to do, as a compact list the queue replays into its tracker
+	*/
+	class NullCommandList : public CommandList {
+
+	// Used by NullCommandQueue to access the _commands vector
+	friend class NullCommandQueue;
+
+	public:
+		explicit NullCommandList(CommandListType type) : CommandList(type) {}
+
+		auto Begin() -> void override {}
+		auto Close() -> void override {}
+		auto Reset(std::shared_ptr<CommandAllocator>&) -> void override { _commands.clear(); }
+		auto ClearRenderTarget(glm::vec4 color) -> void override;
+		auto BindRenderTarget(std::shared_ptr<RenderTarget> target) -> void override;
+		auto TransitionRenderTarget(
+			std::shared_ptr<RenderTarget> target,
+			ResourceState before,
+			ResourceState after
+		) -> void override;
+		auto SetViewport(
+			uint32_t x,
+			uint32_t y,
+			uint32_t width,
+			uint32_t height,
+			uint32_t minDepth,
+			uint32_t maxDepth
+		) -> void override;
+		auto SetScissorRect(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) -> void override;
+		auto SetViewMatrix(glm::mat4 viewMatrix) -> void override;
+		auto SetProjectionMatrix(glm::mat4 projectionMatrix) -> void override;
+		auto SetPrimitiveTopology(PrimitiveTopology topology) -> void override;
+		auto SetBlending(bool enabled) -> void override;
+		auto SetDepthMode(DepthMode mode) -> void override;
+		auto SetDepthBias(float bias) -> void override;
+		auto SetMaterial(std::shared_ptr<Material> material) -> void override;
+		auto BindVertexArray(std::shared_ptr<VertexArray> vertexArray) -> void const override;
+		auto BindVertexBuffer(uint8_t index, std::shared_ptr<VertexBuffer> vertexBuffer) -> void const override;
+		auto BindIndexBuffer(std::shared_ptr<IndexBuffer> indexBuffer) -> void const override;
+		auto DrawIndexed(glm::mat4 model, glm::vec4 uvRect, uint32_t numIndices, uint32_t startIndex, int32_t baseVertex) -> void override;
+		auto DrawIndexedInstanced(
+			uint32_t numIndices,
+			uint32_t instanceCount,
+			uint32_t startIndexLocation,
+			int32_t baseVertexLocation
+		) -> void override;
+		auto SetIndirectDraws(std::vector<DrawIndirectCommand> commands, std::vector<DrawData> draws) -> void override;
+		auto MultiDrawIndexedIndirect(uint32_t firstCommand, uint32_t commandCount) -> void override;
+		auto SetSpriteInstances(std::vector<SpriteInstance> instances) -> void override;
+		auto DrawSpriteInstances(
+			uint32_t numIndices,
+			uint32_t startIndex,
+			int32_t baseVertex,
+			uint32_t firstInstance,
+			uint32_t instanceCount
+		) -> void override;
+		auto WriteTimestamp(std::shared_ptr<GpuTimerPool> pool, uint32_t query) -> void override;
+		auto UploadTexture(
+			std::shared_ptr<Texture> texture,
+			uint32_t width,
+			uint32_t height,
+			std::shared_ptr<std::vector<uint8_t>> pixels
+		) -> void override;
+		auto UploadCompressedTexture(
+			std::shared_ptr<Texture> texture,
+			shared::TextureFormat format,
+			std::vector<shared::TextureLevel> levels,
+			std::shared_ptr<const uint8_t> data
+		) -> void override;
+		auto UpdateBuffers(
+			std::shared_ptr<const std::vector<uint8_t>> staging,
+			std::vector<BufferCopy> copies
+		) -> void override;
+
+	private:
+		auto Record(NullCommandType type, uint64_t value = 0) const -> void { _commands.push_back({ type, value }); }
+
+		// Binds are const in the interface, recording them still appends
+		mutable std::vector<NullCommand> _commands;
+	};
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../CommandQueue.hxx"
+#include "NullStateTracker.hxx"
+
+#include <memory>
+
+namespace kyanite::engine::rendering::null {
+	class NullCommandQueue : public CommandQueue {
+	public:
+		NullCommandQueue(CommandListType type, std::shared_ptr<NullStateTracker> tracker) :
+			CommandQueue(type),
+			_tracker(std::move(tracker)) {}
+
+		auto Execute(const std::vector<std::shared_ptr<CommandList>>& commandLists) -> void override;
+		auto Signal(Fence& fence, uint64_t value) -> void override;
+
+	private:
+		std::shared_ptr<NullStateTracker> _tracker;
+	};
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../Device.hxx"
+#include "NullStateTracker.hxx"
+
+#include <cstdint>
+#include <memory>
+
+namespace kyanite::engine::rendering::null {
+	/**
+	* @brief A device without a GPU, for measuring everything the renderer does on the CPU
+	* @note Commands are recorded and replayed into counters instead of being executed. The frame stats report
+	* commands, draw submissions, state changes and the bytes that would have been uploaded.
+	*/
+	class NullDevice : public Device, public std::enable_shared_from_this<NullDevice> {
+	public:
+		NullDevice(uint32_t width, uint32_t height);
+		virtual ~NullDevice() = default;
+		virtual auto Shutdown() -> void override {}
+		virtual auto AttachToCurrentThread() -> void override {}
+		virtual auto DetachFromCurrentThread() -> void override {}
+
+		// Creation work submission and synchronization
+		virtual auto CreateGraphicsContext() -> std::unique_ptr<GraphicsContext> override;
+		virtual auto CreateImGuiContext(ImGuiContext* context) ->
+			std::unique_ptr<ImmediateGuiContext> override;
+		virtual auto CreateUploadContext() -> std::unique_ptr<UploadContext> override;
+		virtual auto CreateCommandList(CommandListType type) -> std::shared_ptr<CommandList> override;
+		virtual auto CreateCommandQueue(CommandListType type) -> std::shared_ptr<CommandQueue> override;
+		virtual auto CreateCommandAllocator() -> std::shared_ptr<CommandAllocator> override;
+		virtual auto CreateFence() -> std::shared_ptr<Fence> override;
+		virtual auto CreateSwapchain() -> std::unique_ptr<Swapchain> override;
+		virtual auto CreateTimerPool() -> std::shared_ptr<GpuTimerPool> override;
+
+		// Creation of resources
+		virtual auto CreateBuffer(uint64_t size) -> std::shared_ptr<Buffer> override;
+		virtual auto CreateRenderTarget(const RenderTargetDesc& desc) -> std::shared_ptr<RenderTarget> override;
+		virtual auto CreateMaterial(
+			std::map<ShaderType, std::shared_ptr<Shader>> shaders,
+			bool isInstanced
+		) -> std::shared_ptr<Material> override;
+		virtual auto CompileShader(
+			const std::string& shaderSource,
+			ShaderType type
+		) -> std::shared_ptr<Shader> override;
+		virtual auto CreateVertexBuffer(const void* data, uint64_t size, size_t elemSize, BufferUsage usage
+		) -> std::shared_ptr<VertexBuffer> override;
+		virtual auto UpdateVertexBuffer(std::shared_ptr<VertexBuffer> buffer, const void* data, uint64_t size) -> void override;
+		virtual auto CreateIndexBuffer(const uint32_t* indices, size_t len, BufferUsage usage) -> std::shared_ptr<IndexBuffer> override;
+		virtual auto UpdateIndexBuffer(std::shared_ptr<IndexBuffer> buffer, std::vector<uint32_t> indices) -> void override;
+		virtual auto CreateVertexArray(
+			std::shared_ptr<VertexBuffer> vertexBuffer,
+			std::shared_ptr<IndexBuffer> indexBuffer
+		) -> std::shared_ptr<VertexArray> override;
+		auto CreateTexture(
+			uint32_t width,
+			uint32_t height,
+			uint32_t channels,
+			const uint8_t* data
+		) -> std::shared_ptr<Texture> override;
+		auto CreatePlaceholderTexture() -> std::shared_ptr<Texture> override;
+
+		//Delete resources
+		virtual auto DestroyShader(uint64_t shaderHandle) -> void override {}
+
+		virtual auto Stats() const -> FrameStats override { return _tracker->Stats(); }
+		virtual auto ResetStats() -> void override { _tracker->ResetStats(); }
+
+	private:
+		// Ids start at 1, 0 stands for the backbuffer and for nothing bound
+		auto NextId() -> uint32_t { return _nextId++; }
+
+		uint32_t _width;
+		uint32_t _height;
+		uint32_t _nextId = 1;
+		std::shared_ptr<NullStateTracker> _tracker;
+	};
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "../CommandAllocator.hxx"
+#include "../Fence.hxx"
+#include "../GpuTimerPool.hxx"
+#include "../IndexBuffer.hxx"
+#include "../Material.hxx"
+#include "../RenderTarget.hxx"
+#include "../Swapchain.hxx"
+#include "../Texture.hxx"
+#include "../VertexArray.hxx"
+#include "../VertexBuffer.hxx"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+
+namespace kyanite::engine::rendering::null {
+	// Resources of the null device only carry the ids the renderer sorts and deduplicates by
+
+	class NullVertexBuffer : public VertexBuffer {
+	public:
+		NullVertexBuffer(uint64_t id, size_t size, BufferUsage usage) : VertexBuffer(size, usage), _id(id) {}
+
+		auto Id() const -> uint64_t override { return _id; }
+		auto SetData(const void* data, size_t size) -> void override {}
+		auto SetSubData(size_t offset, const void* data, size_t size) -> void override {}
+		auto Bind() const -> void override {}
+
+	private:
+		uint64_t _id;
+	};
+
+	class NullIndexBuffer : public IndexBuffer {
+	public:
+		NullIndexBuffer(uint64_t id, size_t size, BufferUsage usage) : IndexBuffer(size, usage), _id(id) {}
+
+		auto Id() const -> uint64_t override { return _id; }
+		auto SetData(const void* data, size_t size) -> void override {}
+		auto SetSubData(size_t offset, const void* data, size_t size) -> void override {}
+		auto Bind() const -> void override {}
+
+	private:
+		uint64_t _id;
+	};
+
+	class NullVertexArray : public VertexArray {
+	public:
+		NullVertexArray(
+			uint32_t id,
+			std::shared_ptr<engine::rendering::VertexBuffer> vertexBuffer,
+			std::shared_ptr<engine::rendering::IndexBuffer> indexBuffer
+		) :
+			VertexArray(indexBuffer, vertexBuffer),
+			_id(id) {}
+
+		auto Id() const -> uint32_t override { return _id; }
+		auto Bind() const -> void override {}
+		auto Indices() const -> uint32_t override { return static_cast<uint32_t>(IndexBuffer()->Size()); }
+
+	private:
+		uint32_t _id;
+	};
+
+	class NullTexture : public Texture {
+	public:
+		explicit NullTexture(uint32_t id) { _id = id; }
+	};
+
+	class NullMaterial : public Material {
+	public:
+		NullMaterial(std::map<ShaderType, std::shared_ptr<Shader>> shaders, bool instanced) : Material(shaders) {
+			isInstanced = instanced;
+		}
+
+		auto Bind() -> void override { _parametersDirty = false; }
+		auto SetBuiltins(glm::mat4 model, glm::vec4 uvRect, glm::mat4 view, glm::mat4 projection) -> void override {}
+	};
+
+	class NullRenderTarget : public RenderTarget {
+	public:
+		NullRenderTarget(uint64_t id, const RenderTargetDesc& desc, uint32_t textureId) :
+			RenderTarget(id, desc),
+			_color(std::make_shared<NullTexture>(textureId)) {}
+
+		auto ColorTexture() const -> std::shared_ptr<Texture> override { return _color; }
+
+	private:
+		std::shared_ptr<NullTexture> _color;
+	};
+
+	class NullFence : public Fence {
+	public:
+		auto Signal() -> void override { _value++; }
+		auto SetOnCompletion(uint64_t value, void* event) -> void override {}
+		auto GetCompletedValue() -> uint64_t override { return _value; }
+
+	private:
+		uint64_t _value = 0;
+	};
+
+	class NullCommandAllocator : public CommandAllocator {
+	public:
+		auto Reset() -> void override {}
+	};
+
+	// Every scope takes no time, there is no GPU to take it
+	class NullGpuTimerPool : public GpuTimerPool {
+	protected:
+		auto IsAvailable(uint32_t query) -> bool override { return true; }
+		auto Timestamp(uint32_t query) -> uint64_t override { return 0; }
+	};
+
+	class NullSwapchain : public Swapchain {
+	public:
+		NullSwapchain() : Swapchain(nullptr) {}
+
+		auto Swap() -> void override {}
+	};
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../FrameStats.hxx"
+
+#include <cstdint>
+
+namespace kyanite::engine::rendering::null {
+	// What a recorded null command did, replayed through NullStateTracker when its list executes
+	enum class NullCommandType : uint8_t {
+		Clear,
+		BindRenderTarget,
+		TransitionRenderTarget,
+		SetViewport,
+		SetScissorRect,
+		SetViewMatrix,
+		SetProjectionMatrix,
+		SetPrimitiveTopology,
+		SetBlending,
+		SetDepthMode,
+		SetDepthBias,
+		SetMaterial,
+		BindVertexArray,
+		BindVertexBuffer,
+		BindIndexBuffer,
+		Draw,
+		DrawInstanced,
+		MultiDrawIndirect,
+		WriteTimestamp,
+		Upload,
+	};
+
+	struct NullCommand {
+		NullCommandType type;
+		// The object a bind binds, the element count of a draw or the byte count of an upload
+		uint64_t value;
+	};
+
+	/**
+	* @brief Counts what the null device would have sent to a GPU
+	* @note Binds are shadowed like GlStateCache does it, so state change counts of both backends compare.
+	* The shadow is reset whenever a queue starts executing.
+	*/
+	class NullStateTracker {
+	public:
+		auto Reset() -> void;
+		auto Execute(const NullCommand& command) -> void;
+		/**
+		* @brief Counts bytes that went to the GPU outside of a command list, like the initial data of a buffer
+		*/
+		auto Upload(uint64_t bytes) -> void { _stats.uploadedBytes += bytes; }
+
+		auto Stats() const -> const FrameStats& { return _stats; }
+		auto ResetStats() -> void { _stats = {}; }
+
+	private:
+		static constexpr uint64_t Unknown = UINT64_MAX;
+
+		auto Bind(uint64_t& bound, uint64_t value) -> void;
+
+		uint64_t _renderTarget = Unknown;
+		uint64_t _material = Unknown;
+		uint64_t _vertexArray = Unknown;
+		uint64_t _vertexBuffer = Unknown;
+		uint64_t _indexBuffer = Unknown;
+		uint64_t _blending = Unknown;
+		uint64_t _depthMode = Unknown;
+		uint64_t _depthBias = Unknown;
+		FrameStats _stats;
+	};
+}
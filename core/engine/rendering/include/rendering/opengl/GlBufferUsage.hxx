@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../Buffer.hxx"
+
+#include <glad/glad.h>
+
+namespace kyanite::engine::rendering::opengl {
+	inline auto GlBufferUsage(BufferUsage usage) -> GLenum {
+		switch (usage) {
+		case BufferUsage::Dynamic:
+			return GL_DYNAMIC_DRAW;
+		case BufferUsage::Stream:
+			return GL_STREAM_DRAW;
+		default:
+			return GL_STATIC_DRAW;
+		}
+	}
+}
@@ -6,10 +6,12 @@
 #include "../PrimitiveTopology.hxx"
 #include "../VertexArray.hxx"
 #include "../VertexBuffer.hxx"
+#include "GlStateCache.hxx"
 
 #include <glad/glad.h>
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace kyanite::engine::rendering::opengl {
@@ -20,12 +22,18 @@ namespace kyanite::engine::rendering::opengl {
 	friend class GlCommandQueue;
 
 	public:
-		GlCommandList(CommandListType type);
+		GlCommandList(CommandListType type, std::shared_ptr<GlStateCache> state);
 		~GlCommandList();
 		virtual auto Begin() -> void override;
 		virtual auto Close() -> void override;
 		virtual auto Reset(std::shared_ptr<CommandAllocator>&) -> void override;
 		virtual auto ClearRenderTarget(glm::vec4 color) -> void override;
+		auto BindRenderTarget(std::shared_ptr<RenderTarget> target) -> void override;
+		auto TransitionRenderTarget(
+			std::shared_ptr<RenderTarget> target,
+			ResourceState before,
+			ResourceState after
+		) -> void override;
 		virtual auto SetViewport(
 			uint32_t x, 
 			uint32_t y, 
@@ -36,21 +44,67 @@ namespace kyanite::engine::rendering::opengl {
 		) -> void override;
 		virtual auto SetScissorRect(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) -> void override;
 		auto SetPrimitiveTopology(PrimitiveTopology topology) -> void override;
+		auto SetBlending(bool enabled) -> void override;
+		auto SetDepthMode(DepthMode mode) -> void override;
+		auto SetDepthBias(float bias) -> void override;
 		auto SetViewMatrix(glm::mat4 viewMatrix) -> void override;
 		auto SetProjectionMatrix(glm::mat4 projectionMatrix) -> void override;
 		auto SetMaterial(std::shared_ptr<Material> material) -> void override;
 		auto BindVertexArray(std::shared_ptr<VertexArray> vertexArray) -> void const override;
 		auto BindVertexBuffer(uint8_t index, std::shared_ptr<VertexBuffer> vertexBuffer) -> void const override;
 		auto BindIndexBuffer(std::shared_ptr<IndexBuffer> indexBuffer) -> void const override;
-		auto DrawIndexed(glm::mat4 model, uint32_t numIndices, uint32_t startIndex) -> void override;
+		auto DrawIndexed(glm::mat4 model, glm::vec4 uvRect, uint32_t numIndices, uint32_t startIndex, int32_t baseVertex) -> void override;
 		auto DrawIndexedInstanced(
 			uint32_t numIndices,
 			uint32_t instanceCount,
 			uint32_t startIndexLocation,
 			int32_t baseVertexLocation
 		) -> void override;
+		auto UpdateBuffers(
+			std::shared_ptr<const std::vector<uint8_t>> staging,
+			std::vector<BufferCopy> copies
+		) -> void override;
+		auto SetIndirectDraws(std::vector<DrawIndirectCommand> commands, std::vector<DrawData> draws) -> void override;
+		auto MultiDrawIndexedIndirect(uint32_t firstCommand, uint32_t commandCount) -> void override;
+		auto SetSpriteInstances(std::vector<SpriteInstance> instances) -> void override;
+		auto DrawSpriteInstances(
+			uint32_t numIndices,
+			uint32_t startIndex,
+			int32_t baseVertex,
+			uint32_t firstInstance,
+			uint32_t instanceCount
+		) -> void override;
+		auto WriteTimestamp(std::shared_ptr<GpuTimerPool> pool, uint32_t query) -> void override;
+		auto UploadTexture(
+			std::shared_ptr<Texture> texture,
+			uint32_t width,
+			uint32_t height,
+			std::shared_ptr<std::vector<uint8_t>> pixels
+		) -> void override;
+		auto UploadCompressedTexture(
+			std::shared_ptr<Texture> texture,
+			shared::TextureFormat format,
+			std::vector<shared::TextureLevel> levels,
+			std::shared_ptr<const uint8_t> data
+		) -> void override;
 
 	private:
+		// Uploads rotate through a few pixel buffers, each one is orphaned before it is refilled
+		static constexpr size_t PixelBufferCount = 4;
+		std::vector<GLuint> _pixelBuffers;
+		size_t _nextPixelBuffer = 0;
+
+		// Buffer updates of a frame go out in one transfer, rotated and orphaned like the pixel buffers
+		static constexpr size_t StagingBufferCount = 3;
+		std::vector<GLuint> _stagingBuffers;
+		size_t _nextStagingBuffer = 0;
+
+		// Refilled every frame, each fill orphans the storage the previous frame may still read
+		GLuint _indirectBuffer = 0;
+		GLuint _drawDataBuffer = 0;
+		GLuint _spriteBuffer = 0;
+
+		std::shared_ptr<GlStateCache> _state;
 		std::vector<std::function<void()>> _commands;
 		GLenum _primitiveTopology;
 		std::shared_ptr<GlMaterial> _currentMaterial;
@@ -1,14 +1,20 @@
 #pragma once 
 
 #include "../CommandQueue.hxx"
+#include "GlStateCache.hxx"
+
+#include <memory>
 
 namespace kyanite::engine::rendering::opengl {
 	class GlCommandQueue : public CommandQueue {
 	public:
-		GlCommandQueue(CommandListType type);
+		GlCommandQueue(CommandListType type, std::shared_ptr<GlStateCache> state);
 		~GlCommandQueue() = default;
 
 		virtual auto Execute(const std::vector<std::shared_ptr<CommandList>>&) -> void override;
 		virtual auto Signal(Fence& fence, uint64_t value) -> void override;
+
+	private:
+		std::shared_ptr<GlStateCache> _state;
 	};
 }
\ No newline at end of file
@@ -2,8 +2,11 @@
 
 #include "../Device.hxx"
 #include "../Shader.hxx"
+#include "GlProgramCache.hxx"
+#include "GlStateCache.hxx"
 
 #include <SDL2/SDL.h>
+#include <glad/glad.h>
 
 #include <memory>
 
@@ -13,6 +16,8 @@ namespace kyanite::engine::rendering::opengl {
 		GlDevice(SDL_Window* window);
 		virtual ~GlDevice();
 		virtual auto Shutdown() -> void override;
+		virtual auto AttachToCurrentThread() -> void override;
+		virtual auto DetachFromCurrentThread() -> void override;
 
 		// Creation work submission and synchronization
 		virtual auto CreateGraphicsContext() -> std::unique_ptr<GraphicsContext> override;
@@ -24,10 +29,11 @@ namespace kyanite::engine::rendering::opengl {
 		virtual auto CreateCommandAllocator() -> std::shared_ptr<CommandAllocator> override;
 		virtual auto CreateFence() -> std::shared_ptr<Fence> override;
 		virtual auto CreateSwapchain() -> std::unique_ptr<Swapchain> override;
+		virtual auto CreateTimerPool() -> std::shared_ptr<GpuTimerPool> override;
 
 		// Creation of resources
 		virtual auto CreateBuffer(uint64_t size) -> std::shared_ptr<Buffer> override;
-		virtual auto CreateRenderTarget() -> std::shared_ptr<RenderTarget> override;
+		virtual auto CreateRenderTarget(const RenderTargetDesc& desc) -> std::shared_ptr<RenderTarget> override;
 		virtual auto CreateMaterial(
 			std::map<ShaderType, std::shared_ptr<Shader>> shaders,
 			bool isInstanced
@@ -36,10 +42,10 @@ namespace kyanite::engine::rendering::opengl {
 			const std::string& shaderSource,
 			ShaderType type
 		) -> std::shared_ptr<Shader> override;
-		virtual auto CreateVertexBuffer(const void* data, uint64_t size, size_t elemSize
+		virtual auto CreateVertexBuffer(const void* data, uint64_t size, size_t elemSize, BufferUsage usage
 		) -> std::shared_ptr<VertexBuffer> override;
 		virtual auto UpdateVertexBuffer(std::shared_ptr<VertexBuffer> buffer, const void* data, uint64_t size) -> void override;
-		virtual auto CreateIndexBuffer(const uint32_t* indices, size_t len) -> std::shared_ptr<IndexBuffer> override;
+		virtual auto CreateIndexBuffer(const uint32_t* indices, size_t len, BufferUsage usage) -> std::shared_ptr<IndexBuffer> override;
 		virtual auto UpdateIndexBuffer(std::shared_ptr<IndexBuffer> buffer, std::vector<uint32_t> indices) -> void override;
 		virtual auto CreateVertexArray(
 			std::shared_ptr<VertexBuffer> vertexBuffer,
@@ -51,12 +57,26 @@ namespace kyanite::engine::rendering::opengl {
 			uint32_t channels,
 			const uint8_t* data
 		)->std::shared_ptr<Texture> override;
+		auto CreatePlaceholderTexture() -> std::shared_ptr<Texture> override;
 
 		//Delete resources
 		virtual auto DestroyShader(uint64_t shaderHandle) -> void override;
 
-	private:
-		SDL_Window* _window;
-		SDL_GLContext _glContext;
+		virtual auto Stats() const -> FrameStats override;
+		virtual auto ResetStats() -> void override;
+
+	protected:
+		// For devices that create and own their context themselves, they call Initialize once it is current
+		GlDevice() = default;
+		/**
+		* @brief Loads the GL functions and creates the caches and queues, with the context current on this thread
+		*/
+		auto Initialize(GLADloadproc loader) -> void;
+
+		SDL_Window* _window = nullptr;
+		SDL_GLContext _glContext = nullptr;
+		std::unique_ptr<GlProgramCache> _programCache;
+		// Shared by every queue, command list and material of the context
+		std::shared_ptr<GlStateCache> _state;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../GpuTimerPool.hxx"
+
+#include <glad/glad.h>
+
+#include <array>
+
+namespace kyanite::engine::rendering::opengl {
+	class GlGpuTimerPool : public GpuTimerPool {
+	public:
+		GlGpuTimerPool() {
+			glCreateQueries(GL_TIMESTAMP, static_cast<GLsizei>(_queries.size()), _queries.data());
+		}
+
+		~GlGpuTimerPool() {
+			glDeleteQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+		}
+
+		auto Query(uint32_t query) const -> GLuint { return _queries[query]; }
+
+	protected:
+		auto IsAvailable(uint32_t query) -> bool override {
+			GLuint available = GL_FALSE;
+			glGetQueryObjectuiv(_queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+			return available == GL_TRUE;
+		}
+
+		auto Timestamp(uint32_t query) -> uint64_t override {
+			GLuint64 timestamp = 0;
+			glGetQueryObjectui64v(_queries[query], GL_QUERY_RESULT, &timestamp);
+			return timestamp;
+		}
+
+	private:
+		std::array<GLuint, QueryCount> _queries;
+	};
+}
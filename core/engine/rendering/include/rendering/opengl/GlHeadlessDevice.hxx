@@ -0,0 +1,32 @@
+#pragma once
+
+#include "GlDevice.hxx"
+#include "GlRenderTarget.hxx"
+
+#include <EGL/egl.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace kyanite::engine::rendering::opengl {
+	/**
+	* @brief A GL device without a window, on a surfaceless EGL context
+	* @note The backbuffer is a render target of the requested size. Mesa provides the surfaceless platform
+	* on any Linux box, with llvmpipe when there is no GPU.
+	*/
+	class GlHeadlessDevice : public GlDevice {
+	public:
+		GlHeadlessDevice(uint32_t width, uint32_t height);
+		~GlHeadlessDevice();
+
+		auto AttachToCurrentThread() -> void override;
+		auto DetachFromCurrentThread() -> void override;
+		auto CreateImGuiContext(ImGuiContext* context) -> std::unique_ptr<ImmediateGuiContext> override;
+		auto CreateSwapchain() -> std::unique_ptr<Swapchain> override;
+
+	private:
+		EGLDisplay _display = EGL_NO_DISPLAY;
+		EGLContext _context = EGL_NO_CONTEXT;
+		std::shared_ptr<GlRenderTarget> _backbuffer;
+	};
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../Swapchain.hxx"
+#include "GlRenderTarget.hxx"
+
+#include <glad/glad.h>
+
+#include <filesystem>
+#include <memory>
+
+namespace kyanite::engine::rendering::opengl {
+	/**
+	* @brief Presents into a render target instead of a window
+	* @note Every frame is timed on the GPU with a time elapsed query. The result is read back at the next swap,
+	* which waits for the frame to finish, so the numbers are exact but the CPU never runs ahead of the GPU.
+	*/
+	class GlHeadlessSwapchain : public Swapchain {
+	public:
+		explicit GlHeadlessSwapchain(std::shared_ptr<GlRenderTarget> backbuffer);
+		~GlHeadlessSwapchain();
+
+		auto Swap() -> void override;
+		auto RequestCapture(std::filesystem::path path) -> void override { _capturePath = std::move(path); }
+		auto GpuFrameTime() const -> double override { return _gpuFrameTime; }
+
+	private:
+		auto Capture() -> void;
+
+		std::shared_ptr<GlRenderTarget> _backbuffer;
+		GLuint _timeQuery = 0;
+		double _gpuFrameTime = 0.0;
+		std::filesystem::path _capturePath;
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../IndexBuffer.hxx"
+#include "GlBufferUsage.hxx"
 
 #include <glad/glad.h>
 
@@ -11,7 +12,7 @@
 namespace kyanite::engine::rendering::opengl {
 	class GlIndexBuffer : public IndexBuffer {
 	public:
-		GlIndexBuffer(const uint32_t* indices, size_t len);
+		GlIndexBuffer(const uint32_t* indices, size_t len, BufferUsage usage = BufferUsage::Static);
 		~GlIndexBuffer();
 
 		auto Bind() const -> void override {
@@ -23,11 +24,14 @@ namespace kyanite::engine::rendering::opengl {
 		}
 
 		auto SetData(const void* data, size_t size) -> void override {
-			Bind();
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+			glNamedBufferData(_id, static_cast<GLsizeiptr>(size), data, GlBufferUsage(Usage()));
 		};
 
-		auto Id() const -> uint64_t { return _id; }
+		auto SetSubData(size_t offset, const void* data, size_t size) -> void override {
+			glNamedBufferSubData(_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		}
+
+		auto Id() const -> uint64_t override { return _id; }
 
 	private:
 		GLuint _id;
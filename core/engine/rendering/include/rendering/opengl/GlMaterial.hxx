@@ -1,86 +1,170 @@
 #pragma once
 
 #include "../Material.hxx"
+#include "GlProgram.hxx"
+#include "GlProgramCache.hxx"
 #include "GlShader.hxx"
+#include "GlStateCache.hxx"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstring>
+#include <iostream>
 #include <memory>
+#include <vector>
 
 namespace kyanite::engine::rendering::opengl {
 	class GlMaterial : public Material {
 	public:
 		uint32_t programId;
 
-		GlMaterial(std::map<ShaderType, std::shared_ptr<Shader>> shaders, bool isInstanced) : Material(shaders) {
-			// Convert the shaders to OpenGL shaders
+		// The program is owned by the program cache and shared by every material with the same shader pair
+		GlMaterial(
+			std::map<ShaderType, std::shared_ptr<Shader>> shaders,
+			bool isInstanced,
+			std::shared_ptr<const GlProgram> program,
+			std::shared_ptr<const GlProgram> fallback,
+			GlProgramCache* programs,
+			std::shared_ptr<GlStateCache> state
+		) :
+			Material(shaders),
+			programId(program->id),
+			_program(std::move(program)),
+			_fallback(std::move(fallback)),
+			_programs(programs),
+			_state(std::move(state)) {
 			this->isInstanced = isInstanced;
-			auto vertexShader = std::static_pointer_cast<GlShader>(shaders[ShaderType::VERTEX]);
-			auto fragmentShader = std::static_pointer_cast<GlShader>(shaders[ShaderType::FRAGMENT]);
-
-			// Create shader program
-			GLuint shaderProgram = glCreateProgram();
-			glAttachShader(shaderProgram, vertexShader->shaderId);
-			glAttachShader(shaderProgram, fragmentShader->shaderId);
-			glLinkProgram(shaderProgram);
-
-			// Check linking status
-			GLint success;
-			glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-			if (!success) {
-				GLchar infoLog[512];
-				glGetProgramInfoLog(shaderProgram, sizeof(infoLog), NULL, infoLog);
-				std::cerr << "Shader program linking failed:\n" << infoLog << std::endl;
-				// TODO: Throw exception
+			_ready.store(false, std::memory_order_release);
+		}
+
+		~GlMaterial() {
+			if (_uniformBuffer != 0) {
+				glDeleteBuffers(1, &_uniformBuffer);
 			}
-			programId = shaderProgram;
+		}
+
+		auto IsReady() -> bool override {
+			auto ready = _programs->Poll(*_program);
+			_ready.store(ready, std::memory_order_release);
+			return ready;
 		}
 
 		void Bind() override {
 			if (!isInstanced) {
-				// Disable instancing
-				// Disable the atribpointers
-				glDisableVertexAttribArray(2);
-				glDisableVertexAttribArray(3);
-				glDisableVertexAttribArray(4);
-				glDisableVertexAttribArray(5);
-				
-				// Reset the divisor for the model matrix
-				glVertexAttribDivisor(2, 0);
-				glVertexAttribDivisor(3, 0);
-				glVertexAttribDivisor(4, 0);
-				glVertexAttribDivisor(5, 0);
+				// Disable the instance attributes, the model matrix and the texture region come from uniforms
+				for (GLuint attribute = 2; attribute <= 6; attribute++) {
+					_state->EnableVertexAttribute(attribute, false);
+					_state->SetVertexAttributeDivisor(attribute, 0);
+				}
 			}
 
-			// Check for errors
-			GLenum error = glGetError();
-			if (error != GL_NO_ERROR) {
-				std::cerr << "Error setting up vertex attribute pointers: " << error << std::endl;
+			// Until its own program is linked the material draws flat with the fallback, or not at all
+			if (!IsReady()) {
+				_bound = _programs->Poll(*_fallback) ? _fallback.get() : nullptr;
+				if (_bound != nullptr) {
+					_state->UseProgram(_bound->id);
+				}
+				return;
 			}
 
-			glUseProgram(programId);
+			_bound = _program.get();
+			_state->UseProgram(programId);
 
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, textures.begin()->second->ID());
-				
-			// Set the sampler uniform to use texture unit 0
-			GLint textureLocation = glGetUniformLocation(programId, "DIFFUSE_MAP");
-			glUniform1i(textureLocation, 0);
+			// Every material owns a copy of the block, so materials of one program can differ in their parameters
+			if (_program->layout.blockSize > 0 && _uniformBuffer == 0) {
+				_block.resize(_program->layout.blockSize);
+				glCreateBuffers(1, &_uniformBuffer);
+				glNamedBufferData(_uniformBuffer, _program->layout.blockSize, nullptr, GL_DYNAMIC_DRAW);
+				_parametersDirty = true;
+			}
+
+			if (_uniformBuffer != 0) {
+				if (_parametersDirty) {
+					PackParameters();
+					glNamedBufferSubData(_uniformBuffer, 0, static_cast<GLsizeiptr>(_block.size()), _block.data());
+					_parametersDirty = false;
+				}
+				_state->BindUniformBuffer(MaterialBlockBinding, _uniformBuffer);
+			}
+
+			// Each sampler gets the texture of the same name on the unit the program reserved for it
+			for (const auto& sampler : _program->layout.samplers) {
+				auto texture = textures.find(sampler.name);
+				if (texture == textures.end()) {
+					// Materials written before samplers were named still expect their texture on the first unit
+					if (sampler.unit != 0 || textures.empty()) {
+						continue;
+					}
+					texture = textures.begin();
+				}
+
+				_state->BindTexture(sampler.unit, texture->second->ID());
+			}
 		}
 
-		void SetBuiltins(glm::mat4 model, glm::mat4 view, glm::mat4 projection) {
+		// Whether the last Bind left a program to draw with
+		auto CanDraw() const -> bool {
+			return _bound != nullptr;
+		}
+
+		void SetBuiltins(glm::mat4 model, glm::vec4 uvRect, glm::mat4 view, glm::mat4 projection) {
+			if (_bound == nullptr) {
+				return;
+			}
+
+			const auto& layout = _bound->layout;
 			if (!isInstanced) {
-				GLint modelLoc = glGetUniformLocation(programId, "model");
-				glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+				glUniformMatrix4fv(layout.model, 1, GL_FALSE, glm::value_ptr(model));
+
+				// Instanced materials read the region from vertex attribute 6 instead
+				glUniform4fv(layout.uvRect, 1, glm::value_ptr(uvRect));
 			}
-			// Pass matrices to the shader
-			GLint viewLoc = glGetUniformLocation(programId, "view");
-			GLint projLoc = glGetUniformLocation(programId, "projection");
 
 			// Pass matrices to the shader
-			glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-			glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+			glUniformMatrix4fv(layout.view, 1, GL_FALSE, glm::value_ptr(view));
+			glUniformMatrix4fv(layout.projection, 1, GL_FALSE, glm::value_ptr(projection));
 		}
+
+	private:
+		// Writes every parameter the program knows into the std140 block at its reflected offset
+		auto PackParameters() -> void {
+			const auto& fields = _program->layout.fields;
+			auto write = [&](const std::string& name, const void* value, size_t size) {
+				if (auto field = fields.find(name); field != fields.end() && field->second.offset + size <= _block.size()) {
+					std::memcpy(_block.data() + field->second.offset, value, size);
+				}
+			};
+
+			for (const auto& [name, value] : floats) {
+				write(name, &value, sizeof(value));
+			}
+			for (const auto& [name, value] : ints) {
+				write(name, &value, sizeof(value));
+			}
+			for (const auto& [name, value] : bools) {
+				// std140 bools are four bytes wide
+				uint32_t word = value ? 1 : 0;
+				write(name, &word, sizeof(word));
+			}
+			for (const auto& [name, value] : vec2s) {
+				write(name, value.data(), sizeof(value));
+			}
+			for (const auto& [name, value] : vec3s) {
+				write(name, value.data(), sizeof(value));
+			}
+			for (const auto& [name, value] : vec4s) {
+				write(name, value.data(), sizeof(value));
+			}
+		}
+
+		std::shared_ptr<const GlProgram> _program;
+		std::shared_ptr<const GlProgram> _fallback;
+		GlProgramCache* _programs;
+		// The program the last Bind used, the fallback while the own program links
+		const GlProgram* _bound = nullptr;
+		std::shared_ptr<GlStateCache> _state;
+		GLuint _uniformBuffer = 0;
+		std::vector<uint8_t> _block;
 	};
-}
\ No newline at end of file
+}
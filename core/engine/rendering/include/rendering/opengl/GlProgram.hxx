@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kyanite::engine::rendering::opengl {
+	// Name of the std140 uniform block that holds the material parameters, and the binding point it is attached to
+	constexpr const char* MaterialBlockName = "MaterialParams";
+	constexpr GLuint MaterialBlockBinding = 0;
+
+	/**
+	* @brief What a linked program expects from a material, read back from the program after linking
+	*/
+	struct GlProgramLayout {
+		struct Field {
+			GLint offset;
+			GLenum type;
+		};
+
+		struct Sampler {
+			std::string name;
+			GLint unit;
+		};
+
+		// Size of the material block in bytes, 0 if the program has none
+		GLint blockSize = 0;
+		// Members of the material block by name
+		std::unordered_map<std::string, Field> fields;
+		// One texture unit per sampler, in the order the program reports them
+		std::vector<Sampler> samplers;
+
+		// Locations of the builtins set per draw, -1 if the program does not use them
+		GLint model = -1;
+		GLint view = -1;
+		GLint projection = -1;
+		GLint uvRect = -1;
+	};
+
+	struct GlProgram {
+		GLuint id = 0;
+		// Only valid once the program is ready
+		GlProgramLayout layout;
+		// Identifies the shader pair in the program cache
+		uint64_t key = 0;
+		// False while the driver still compiles and links, the program must not be drawn with until then
+		bool ready = false;
+		// Set when compiling or linking failed, the program then never becomes ready
+		bool failed = false;
+	};
+}
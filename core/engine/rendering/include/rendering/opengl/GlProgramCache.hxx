@@ -0,0 +1,74 @@
+#pragma once
+
+#include "GlProgram.hxx"
+#include "GlShader.hxx"
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+
+namespace kyanite::engine::rendering::opengl {
+	/**
+	* @brief Links every shader pair once and keeps the program binaries on disk
+	* @note Programs are keyed by the source hashes of their shaders. Binaries live in a directory per driver and
+	* GL version, so a driver update starts with an empty cache instead of feeding the driver foreign binaries.
+	* Pairs that miss the cache are compiled and linked without waiting for the driver. Where the driver has
+	* KHR_parallel_shader_compile it does so on its own threads and Poll tells when a program is done.
+	*/
+	class GlProgramCache {
+	public:
+		/**
+		* @param directory The root of the on disk cache. Nothing is persisted if it is empty
+		* @param loader Resolves the entry points of extensions the loader does not know
+		*/
+		GlProgramCache(const std::filesystem::path& directory, GLADloadproc loader);
+		~GlProgramCache();
+
+		/**
+		* @brief Returns the linked program of a shader pair, restoring or linking it on first use
+		* @param vertex The vertex shader
+		* @param fragment The fragment shader
+		* @return The program, which may still be linking. The GL program is owned by the cache
+		*/
+		auto Acquire(const std::shared_ptr<GlShader>& vertex, const std::shared_ptr<GlShader>& fragment) -> std::shared_ptr<const GlProgram>;
+
+		/**
+		* @brief Returns the program drawn with while the programs of a vertex shader are still linking
+		* @param vertex The vertex shader
+		* @return The vertex shader paired with a flat grey fragment shader, so it reads the same vertex inputs
+		*/
+		auto AcquireFallback(const std::shared_ptr<GlShader>& vertex) -> std::shared_ptr<const GlProgram>;
+
+		/**
+		* @brief Checks whether a program finished linking, and reflects and stores it when it just did
+		* @param program A program of this cache
+		* @return Whether the program is ready to draw with
+		* @note Never waits where the driver compiles in parallel. Elsewhere the first poll waits for the driver.
+		*/
+		auto Poll(const GlProgram& program) -> bool;
+
+	private:
+		// A program that is still compiling and linking, its shaders are checked once it is done
+		struct PendingProgram {
+			std::shared_ptr<GlShader> vertex;
+			std::shared_ptr<GlShader> fragment;
+		};
+
+		auto Load(uint64_t key) -> GLuint;
+		auto Link(const std::shared_ptr<GlShader>& vertex, const std::shared_ptr<GlShader>& fragment) -> GLuint;
+		auto Finish(GlProgram& program, const PendingProgram& pending) -> void;
+		auto Store(uint64_t key, GLuint program) -> void;
+		auto Reflect(GLuint program) -> GlProgramLayout;
+		auto PathOf(uint64_t key) const -> std::filesystem::path;
+
+		std::filesystem::path _directory;
+		std::unordered_map<uint64_t, std::shared_ptr<GlProgram>> _programs;
+		std::unordered_map<uint64_t, PendingProgram> _pending;
+		std::shared_ptr<GlShader> _fallbackFragment;
+		// Whether the driver compiles and links on its own threads
+		bool _parallel = false;
+	};
+}
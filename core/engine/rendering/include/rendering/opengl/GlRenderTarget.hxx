@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../RenderTarget.hxx"
+#include "GlTexture.hxx"
+
+#include <glad/glad.h>
+
+#include <memory>
+
+namespace kyanite::engine::rendering::opengl {
+	/**
+	* @brief A framebuffer with one colour texture and an optional depth renderbuffer
+	*/
+	class GlRenderTarget : public RenderTarget {
+	public:
+		explicit GlRenderTarget(const RenderTargetDesc& desc);
+		~GlRenderTarget();
+
+		auto Framebuffer() const -> GLuint { return _framebuffer; }
+		auto HasDepth() const -> bool { return _depth != 0; }
+		auto ColorTexture() const -> std::shared_ptr<Texture> override { return _color; }
+
+	private:
+		GLuint _framebuffer = 0;
+		GLuint _depth = 0;
+		std::shared_ptr<GlTexture> _color;
+	};
+}
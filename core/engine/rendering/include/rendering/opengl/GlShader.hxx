@@ -2,14 +2,91 @@
 
 #include "../Shader.hxx"
 
+#include <glad/glad.h>
+
 #include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
 
 namespace kyanite::engine::rendering::opengl {
 	class GlShader: public Shader {
 	public:
-		uint64_t shaderId;
+		// Zero until the shader is compiled. Programs restored from the cache never compile their shaders
+		uint64_t shaderId = 0;
+		// Identifies the source in the program cache
+		uint64_t sourceHash;
+		std::string source;
+
+		GlShader(std::string source, ShaderType type): Shader("", type, 0), sourceHash(HashSource(source)), source(std::move(source)) {}
+
+		~GlShader() {
+			if (shaderId != 0) {
+				glDeleteShader(static_cast<GLuint>(shaderId));
+			}
+		}
+
+		/**
+		* @brief Starts compiling the shader on first use, without waiting for the driver to finish
+		* @return The GL shader object
+		*/
+		auto Compile() -> uint64_t {
+			if (shaderId != 0) {
+				return shaderId;
+			}
+
+			GLenum shaderTypeId = 0;
+			switch (type) {
+			case ShaderType::VERTEX:
+				shaderTypeId = GL_VERTEX_SHADER;
+				break;
+			case ShaderType::FRAGMENT:
+				shaderTypeId = GL_FRAGMENT_SHADER;
+				break;
+			default:
+				break;
+			}
+
+			const auto shaderCodeGl = reinterpret_cast<const GLchar*>(source.c_str());
+
+			auto shader = glCreateShader(shaderTypeId);
+			glShaderSource(shader, 1, &shaderCodeGl, nullptr);
+			glCompileShader(shader);
+
+			shaderId = shader;
+			id = shader;
+
+			return shaderId;
+		}
+
+		/**
+		* @brief Reports why the shader failed to compile
+		* @return Whether the shader compiled
+		* @note Waits for the compile to finish, so it is only called once the program it belongs to is done
+		*/
+		auto CheckStatus() const -> bool {
+			GLint iTestReturn;
+			glGetShaderiv(static_cast<GLuint>(shaderId), GL_COMPILE_STATUS, &iTestReturn);
+			if (iTestReturn == GL_FALSE) {
+				GLchar p_cInfoLog[1024];
+				int32_t iErrorLength;
+				glGetShaderInfoLog(static_cast<GLuint>(shaderId), 1024, &iErrorLength, p_cInfoLog);
+				std::cerr << "Error compiling shader: " << p_cInfoLog << std::endl;
+
+				return false;
+			}
 
-		GlShader(uint64_t shaderId, ShaderType type): Shader("", type, shaderId), shaderId(shaderId) {}
+			return true;
+		}
 
+		// FNV-1a, stable across runs so it can name files on disk
+		static constexpr auto HashSource(std::string_view source) -> uint64_t {
+			uint64_t hash = 0xcbf29ce484222325;
+			for (auto character : source) {
+				hash ^= static_cast<uint8_t>(character);
+				hash *= 0x100000001b3;
+			}
+			return hash;
+		}
 	};
-}
\ No newline at end of file
+}
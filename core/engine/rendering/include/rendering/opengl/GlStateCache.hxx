@@ -0,0 +1,125 @@
+#pragma once
+
+#include "../FrameStats.hxx"
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+namespace kyanite::engine::rendering::opengl {
+	/**
+	* @brief Shadows the GL state the command lists touch and drops calls that would not change it
+	* @note The shadow is reset whenever a queue starts executing, because resource creation and ImGui bind
+	* objects outside of it. Attribute state is kept per vertex array, as that is where GL stores it.
+	*/
+	class GlStateCache {
+	public:
+		static constexpr size_t MaxVertexAttributes = 16;
+		static constexpr size_t MaxTextureUnits = 16;
+		static constexpr size_t MaxUniformBindings = 16;
+
+		GlStateCache() { Reset(); }
+
+		/**
+		* @brief Forgets everything, so the next call of every kind reaches the driver
+		*/
+		auto Reset() -> void;
+
+		auto UseProgram(GLuint program) -> void;
+		auto BindVertexArray(GLuint vertexArray) -> void;
+		/**
+		* @brief Binds a buffer. Element array bindings are tracked per vertex array
+		*/
+		auto BindBuffer(GLenum target, GLuint buffer) -> void;
+		auto BindUniformBuffer(GLuint binding, GLuint buffer) -> void;
+		auto BindTexture(GLuint unit, GLuint texture) -> void;
+		/**
+		* @brief Makes a texture the target of the following GL_TEXTURE_2D calls, for uploads and parameter changes
+		*/
+		auto EditTexture(GLuint texture) -> void;
+		auto BindFramebuffer(GLuint framebuffer) -> void;
+		auto BoundFramebuffer() const -> GLuint { return _framebuffer; }
+		/**
+		* @brief The framebuffer that stands in for the backbuffer, 0 unless the device has no window
+		*/
+		auto SetDefaultFramebuffer(GLuint framebuffer) -> void { _defaultFramebuffer = framebuffer; }
+		auto DefaultFramebuffer() const -> GLuint { return _defaultFramebuffer; }
+		auto SetBlend(bool enabled, GLenum source, GLenum destination) -> void;
+		auto SetDepthTest(bool enabled, GLenum function) -> void;
+		auto SetDepthWrite(bool enabled) -> void;
+		/**
+		* @brief Offsets the depth of filled polygons by bias units, no bias disables the offset
+		*/
+		auto SetDepthBias(float bias) -> void;
+
+		// Attribute state of the bound vertex array
+		auto EnableVertexAttribute(GLuint index, bool enabled) -> void;
+		auto SetVertexAttributeDivisor(GLuint index, GLuint divisor) -> void;
+		/**
+		* @brief Points a float attribute at a buffer, binding the buffer only if the pointer has to be respecified
+		* @note Integer types are converted as they are, or mapped to 0 to 1 if normalized is set
+		*/
+		auto SetVertexAttributePointer(
+			GLuint index,
+			GLuint buffer,
+			GLint size,
+			GLsizei stride,
+			size_t offset,
+			GLenum type = GL_FLOAT,
+			bool normalized = false
+		) -> void;
+
+		auto Stats() const -> const FrameStats& { return _stats; }
+		auto ResetStats() -> void { _stats = {}; }
+
+	private:
+		// Names GL never hands out, so nothing matches them until the first real call
+		static constexpr GLuint Unknown = UINT32_MAX;
+		static constexpr GLenum UnknownEnum = 0;
+
+		struct VertexAttribute {
+			int8_t enabled = -1;
+			GLuint divisor = Unknown;
+			GLuint buffer = Unknown;
+			GLint size = 0;
+			GLenum type = UnknownEnum;
+			GLsizei stride = 0;
+			size_t offset = 0;
+			bool normalized = false;
+		};
+
+		struct VertexArrayState {
+			GLuint elementBuffer = Unknown;
+			std::array<VertexAttribute, MaxVertexAttributes> attributes;
+		};
+
+		auto Issue() -> void { _stats.stateChanges++; }
+		auto Skip() -> void { _stats.redundantStateChanges++; }
+		auto CurrentVertexArray() -> VertexArrayState&;
+
+		GLuint _program = Unknown;
+		GLuint _vertexArray = Unknown;
+		GLuint _arrayBuffer = Unknown;
+		GLuint _uniformBuffer = Unknown;
+		GLuint _framebuffer = Unknown;
+		// Survives resets, it is a property of the device and not shadowed state
+		GLuint _defaultFramebuffer = 0;
+		std::array<GLuint, MaxUniformBindings> _uniformBindings;
+		GLuint _activeTextureUnit = Unknown;
+		std::array<GLuint, MaxTextureUnits> _textures;
+		int8_t _blend = -1;
+		GLenum _blendSource = UnknownEnum;
+		GLenum _blendDestination = UnknownEnum;
+		int8_t _depthTest = -1;
+		GLenum _depthFunction = UnknownEnum;
+		int8_t _depthWrite = -1;
+		// Not a number until the first bias is set, so it differs from every bias
+		float _depthBias = std::numeric_limits<float>::quiet_NaN();
+		std::unordered_map<GLuint, VertexArrayState> _vertexArrays;
+		FrameStats _stats;
+	};
+}
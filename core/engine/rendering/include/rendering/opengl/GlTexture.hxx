@@ -8,6 +8,24 @@
 namespace kyanite::engine::rendering::opengl {
 	class GlTexture : public Texture {
 	public:
+		// Creates a 1x1 white texture that is replaced once the real image has been uploaded
+		GlTexture() {
+			const uint8_t white[4] = { 255, 255, 255, 255 };
+
+			glGenTextures(1, &_id);
+			glBindTexture(GL_TEXTURE_2D, _id);
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_BGRA, GL_UNSIGNED_BYTE, white);
+
+			// Unbind
+			glBindTexture(GL_TEXTURE_2D, 0);
+		}
+
 		GlTexture(
 			uint32_t width,
 			uint32_t height,
@@ -34,6 +52,25 @@ namespace kyanite::engine::rendering::opengl {
 				data
 			);
 			glGenerateMipmap(GL_TEXTURE_2D);
+			if (width > 1 || height > 1) {
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			}
+
+			// Unbind
+			glBindTexture(GL_TEXTURE_2D, 0);
+		}
+
+		// Creates uninitialised storage a framebuffer renders into, sampled without mips
+		GlTexture(uint32_t width, uint32_t height, GLenum internalFormat) {
+			glGenTextures(1, &_id);
+			glBindTexture(GL_TEXTURE_2D, _id);
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+			glTexStorage2D(GL_TEXTURE_2D, 1, internalFormat, width, height);
 
 			// Unbind
 			glBindTexture(GL_TEXTURE_2D, 0);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../VertexBuffer.hxx"
+#include "GlBufferUsage.hxx"
 
 #include <glad/glad.h>
 
@@ -13,7 +14,8 @@ namespace kyanite::engine::rendering::opengl {
 		GlVertexBuffer(
 			const void* data,
 			size_t size,
-			size_t elemSize
+			size_t elemSize,
+			BufferUsage usage = BufferUsage::Static
 		);
 
 		~GlVertexBuffer();
@@ -21,8 +23,13 @@ namespace kyanite::engine::rendering::opengl {
 		auto Id() const -> uint64_t override { return _id; }
 
 		auto SetData(const void* data, size_t size) -> void override {
-			Bind();
-			glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+			// Respecifying the storage orphans the old one, draws still in flight keep reading it
+			glNamedBufferData(_id, static_cast<GLsizeiptr>(size), data, GlBufferUsage(Usage()));
+		}
+
+		auto SetSubData(size_t offset, const void* data, size_t size) -> void override {
+			// Named, so the bindings the state cache shadows stay untouched
+			glNamedBufferSubData(_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
 		}
 
 		auto Bind() const -> void override {
@@ -3,6 +3,7 @@
 #include "rendering/Shader.hxx"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <imgui.h>
 #include <imgui_internal.h>
 
@@ -16,6 +17,14 @@ void Rendering_Shutdown() {
 	rendering::Shutdown();
 }
 
+void Rendering_StartRenderThread(uint32_t maxFramesInFlight) {
+	rendering::StartRenderThread(maxFramesInFlight);
+}
+
+void Rendering_StopRenderThread() {
+	rendering::StopRenderThread();
+}
+
 inline void Rendering_PreFrame() {
 	rendering::PreFrame();
 }
@@ -50,6 +59,50 @@ inline void Rendering_DrawSprite(
 	rendering::DrawSprite(transformMatrix, materialId);
 }
 
+inline void Rendering_DrawSpriteRegion(
+	const float* transform,
+	uint32_t materialId,
+	const float* uvRect
+) {
+	glm::mat4 transformMatrix = glm::make_mat4(transform);
+
+	rendering::DrawSprite(transformMatrix, materialId, glm::make_vec4(uvRect));
+}
+
+void Rendering_DrawSpriteLayer(
+	const float* transform,
+	uint32_t materialId,
+	const float* uvRect,
+	uint16_t layer
+) {
+	rendering::DrawSprite(glm::make_mat4(transform), materialId, glm::make_vec4(uvRect), layer);
+}
+
+void Rendering_DrawSprites(
+	size_t count,
+	const float* positions,
+	const float* rotations,
+	const float* scales,
+	const uint32_t* materialIds,
+	const float* uvRects
+) {
+	rendering::DrawSprites(count, positions, rotations, scales, materialIds, uvRects);
+}
+
+void Rendering_DrawBatchedSprite(
+	float x,
+	float y,
+	float rotation,
+	float scaleX,
+	float scaleY,
+	const float* uvRect,
+	uint32_t color,
+	uint16_t layer,
+	uint32_t materialId
+) {
+	rendering::DrawBatchedSprite({ x, y }, rotation, { scaleX, scaleY }, glm::make_vec4(uvRect), color, layer, materialId);
+}
+
 void Rendering_SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
 	rendering::SetViewport(x, y, width, height);
 }
@@ -59,8 +112,16 @@ uint32_t Rendering_CreateVertexBuffer(const float* vertices, size_t length, size
 	return rendering::CreateVertexBuffer(vertices, length, elemSize);
 }
 
+uint32_t Rendering_CreateDynamicVertexBuffer(const float* vertices, size_t length, size_t elemSize) {
+	return rendering::CreateVertexBuffer(vertices, length, elemSize, rendering::BufferUsage::Dynamic);
+}
+
 void Rendering_UpdateVertexBuffer(uint32_t vertexBufferId, NativePointer vertices, size_t length) {
+	rendering::UpdateVertexBuffer(vertexBufferId, vertices, length);
+}
 
+void Rendering_UpdateVertexBufferRange(uint32_t vertexBufferId, size_t offset, NativePointer vertices, size_t length) {
+	rendering::UpdateVertexBufferRange(vertexBufferId, offset, vertices, length);
 }
 
 void Rendering_FreeVertexBuffer(uint32_t vertexBufferId) {
@@ -75,9 +136,12 @@ uint32_t Rendering_CreateIndexBuffer(const uint32_t* indices, size_t length) {
 	return rendering::CreateIndexBuffer(indices, length);
 }
 
-void Rendering_UpdateIndexBuffer(uint32_t indexBufferId, NativePointer indices) {
-	// TODO: Implement
-	return;
+uint32_t Rendering_CreateDynamicIndexBuffer(const uint32_t* indices, size_t length) {
+	return rendering::CreateIndexBuffer(indices, length, rendering::BufferUsage::Dynamic);
+}
+
+void Rendering_UpdateIndexBuffer(uint32_t indexBufferId, NativePointer indices, size_t length) {
+	rendering::UpdateIndexBuffer(indexBufferId, indices, length * sizeof(uint32_t));
 }
 
 void Rendering_FreeIndexBuffer(uint32_t indexBufferId);
@@ -86,6 +150,45 @@ uint32_t Rendering_CreateVertexArray(uint32_t vertexBufferId, uint32_t indexBuff
 	return rendering::CreateVertexArray(vertexBufferId, indexBufferId);
 }
 
+uint32_t Rendering_CreateMesh(const float* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount) {
+	return rendering::CreateMesh(reinterpret_cast<const rendering::Vertex*>(vertices), vertexCount, indices, indexCount);
+}
+
+void Rendering_DestroyMesh(uint32_t meshId) {
+	rendering::DestroyMesh(meshId);
+}
+
+uint32_t Rendering_CreateTilemap(
+	uint32_t width,
+	uint32_t height,
+	float tileWidth,
+	float tileHeight,
+	uint32_t atlasColumns,
+	uint32_t atlasRows,
+	uint32_t materialId
+) {
+	return rendering::CreateTilemap(width, height, glm::vec2(tileWidth, tileHeight), atlasColumns, atlasRows, materialId);
+}
+
+void Rendering_SetTilemapTiles(
+	uint32_t tilemapId,
+	uint32_t x,
+	uint32_t y,
+	uint32_t width,
+	uint32_t height,
+	const uint16_t* tiles
+) {
+	rendering::SetTilemapTiles(tilemapId, x, y, width, height, tiles);
+}
+
+void Rendering_DrawTilemap(uint32_t tilemapId, float x, float y, float z, uint16_t layer) {
+	rendering::DrawTilemap(tilemapId, glm::vec3(x, y, z), layer);
+}
+
+void Rendering_DestroyTilemap(uint32_t tilemapId) {
+	rendering::DestroyTilemap(tilemapId);
+}
+
 uint32_t Rendering_CreateShader(const char* shader, uint8_t shaderType) {
 	return rendering::LoadShader(shader, rendering::ShaderType(shaderType));
 }
@@ -98,6 +201,24 @@ uint32_t Rendering_LoadTexture(const uint8_t* data, size_t len) {
 	return rendering::LoadTexture(data, len);
 }
 
+uint32_t Rendering_LoadTextureFile(const char* path) {
+	return rendering::LoadTextureFile(path);
+}
+
+uint32_t Rendering_LoadAtlas(const uint8_t* data, size_t len) {
+	return rendering::LoadAtlas(data, len);
+}
+
+uint32_t Rendering_GetAtlasRegion(uint32_t atlasId, const char* name, float* uvRect) {
+	glm::vec4 rect;
+	auto page = rendering::GetAtlasRegion(atlasId, name, rect);
+	if (page != rendering::InvalidAtlasPage) {
+		std::copy_n(glm::value_ptr(rect), 4, uvRect);
+	}
+
+	return page;
+}
+
 uint32_t Rendering_CreateMaterial(uint32_t pixelShader, uint32_t vertexShader, bool isInstanced) {
 	return rendering::CreateMaterial(pixelShader, vertexShader, isInstanced);
 }
@@ -108,4 +229,65 @@ uint32_t Rendering_CopyMaterial(uint32_t materialId) {
 
 void Rendering_SetMaterialTexture(uint32_t materialId, uint32_t textureId, const char* name) {
 	rendering::SetMaterialTexture(materialId, textureId, name);
+}
+
+void Rendering_SetMaterialOpaque(uint32_t materialId, bool opaque) {
+	rendering::SetMaterialOpaque(materialId, opaque);
+}
+
+bool Rendering_IsMaterialReady(uint32_t materialId) {
+	return rendering::IsMaterialReady(materialId);
+}
+
+void Rendering_SetMaterialFloat(uint32_t materialId, const char* name, float value) {
+	rendering::SetMaterialFloat(materialId, name, value);
+}
+
+void Rendering_SetMaterialInt(uint32_t materialId, const char* name, uint32_t value) {
+	rendering::SetMaterialInt(materialId, name, value);
+}
+
+void Rendering_SetMaterialVector(uint32_t materialId, const char* name, const float* values, size_t count) {
+	rendering::SetMaterialVector(materialId, name, values, count);
+}
+
+void Rendering_GetStateStats(uint64_t* stateChanges, uint64_t* redundantStateChanges) {
+	auto stats = rendering::GetFrameStats();
+	*stateChanges = stats.stateChanges;
+	*redundantStateChanges = stats.redundantStateChanges;
+}
+
+void Rendering_GetFrameTimings(double* cpuFrame, double* preFrame, double* postFrame, double* render, double* swap, double* gpuFrame) {
+	auto timings = rendering::GetFrameTimings();
+	*cpuFrame = timings.cpuFrame;
+	*preFrame = timings.preFrame;
+	*postFrame = timings.postFrame;
+	*render = timings.render;
+	*swap = timings.swap;
+	*gpuFrame = timings.gpuFrame;
+}
+
+size_t Rendering_GetPassTimingCount() {
+	return rendering::GetFrameTimings().scopes.size();
+}
+
+bool Rendering_GetPassTiming(size_t index, char* name, size_t nameLength, double* gpuTime) {
+	auto timings = rendering::GetFrameTimings();
+	if (index >= timings.scopes.size()) {
+		return false;
+	}
+
+	auto& scope = timings.scopes[index];
+	if (nameLength > 0) {
+		auto length = std::min(scope.name.size(), nameLength - 1);
+		std::copy_n(scope.name.data(), length, name);
+		name[length] = '\0';
+	}
+	*gpuTime = scope.milliseconds;
+
+	return true;
+}
+
+void Rendering_SetTimingOverlay(bool visible) {
+	rendering::SetTimingOverlay(visible);
 }
\ No newline at end of file
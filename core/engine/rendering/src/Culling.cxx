@@ -0,0 +1,161 @@
+#include "rendering/Culling.hxx"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KYANITE_CULLING_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define KYANITE_CULLING_NEON
+#endif
+
+namespace kyanite::engine::rendering {
+	namespace {
+#if defined(KYANITE_CULLING_SSE)
+		using Vec4 = __m128;
+		inline auto Load(const float* values) -> Vec4 { return _mm_loadu_ps(values); }
+		inline auto Store(float* values, Vec4 a) -> void { _mm_storeu_ps(values, a); }
+		inline auto Splat(float value) -> Vec4 { return _mm_set1_ps(value); }
+		inline auto Add(Vec4 a, Vec4 b) -> Vec4 { return _mm_add_ps(a, b); }
+		inline auto Mul(Vec4 a, Vec4 b) -> Vec4 { return _mm_mul_ps(a, b); }
+		inline auto MulAdd(Vec4 a, Vec4 b, Vec4 c) -> Vec4 { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+		inline auto Abs(Vec4 a) -> Vec4 { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+		inline auto AnyNegative(Vec4 a) -> bool { return _mm_movemask_ps(_mm_cmplt_ps(a, _mm_setzero_ps())) != 0; }
+#elif defined(KYANITE_CULLING_NEON)
+		using Vec4 = float32x4_t;
+		inline auto Load(const float* values) -> Vec4 { return vld1q_f32(values); }
+		inline auto Store(float* values, Vec4 a) -> void { vst1q_f32(values, a); }
+		inline auto Splat(float value) -> Vec4 { return vdupq_n_f32(value); }
+		inline auto Add(Vec4 a, Vec4 b) -> Vec4 { return vaddq_f32(a, b); }
+		inline auto Mul(Vec4 a, Vec4 b) -> Vec4 { return vmulq_f32(a, b); }
+		inline auto MulAdd(Vec4 a, Vec4 b, Vec4 c) -> Vec4 { return vmlaq_f32(c, a, b); }
+		inline auto Abs(Vec4 a) -> Vec4 { return vabsq_f32(a); }
+		inline auto AnyNegative(Vec4 a) -> bool { return vmaxvq_u32(vcltq_f32(a, vdupq_n_f32(0.0f))) != 0; }
+#else
+		struct Vec4 { float v[4]; };
+		inline auto Load(const float* values) -> Vec4 { return { values[0], values[1], values[2], values[3] }; }
+		inline auto Store(float* values, Vec4 a) -> void {
+			for (int x = 0; x < 4; x++) { values[x] = a.v[x]; }
+		}
+		inline auto Splat(float value) -> Vec4 { return { value, value, value, value }; }
+		inline auto Add(Vec4 a, Vec4 b) -> Vec4 {
+			return { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] };
+		}
+		inline auto Mul(Vec4 a, Vec4 b) -> Vec4 {
+			return { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] };
+		}
+		inline auto MulAdd(Vec4 a, Vec4 b, Vec4 c) -> Vec4 { return Add(Mul(a, b), c); }
+		inline auto Abs(Vec4 a) -> Vec4 {
+			return { std::fabs(a.v[0]), std::fabs(a.v[1]), std::fabs(a.v[2]), std::fabs(a.v[3]) };
+		}
+		inline auto AnyNegative(Vec4 a) -> bool {
+			return a.v[0] < 0.0f || a.v[1] < 0.0f || a.v[2] < 0.0f || a.v[3] < 0.0f;
+		}
+#endif
+
+		struct PlaneSet {
+			Vec4 x;
+			Vec4 y;
+			Vec4 z;
+			Vec4 w;
+			Vec4 absX;
+			Vec4 absY;
+			Vec4 absZ;
+		};
+
+		inline auto LoadPlanes(const Frustum& frustum, int offset) -> PlaneSet {
+			PlaneSet planes;
+			planes.x = Load(frustum.x + offset);
+			planes.y = Load(frustum.y + offset);
+			planes.z = Load(frustum.z + offset);
+			planes.w = Load(frustum.w + offset);
+			planes.absX = Abs(planes.x);
+			planes.absY = Abs(planes.y);
+			planes.absZ = Abs(planes.z);
+
+			return planes;
+		}
+
+		// A box is outside when it lies fully behind any one of the four planes
+		inline auto OutsideAny(const PlaneSet& planes, const float* center, const float* extent) -> bool {
+			auto distance = MulAdd(planes.x, Splat(center[0]), MulAdd(planes.y, Splat(center[1]), MulAdd(planes.z, Splat(center[2]), planes.w)));
+			auto radius = MulAdd(planes.absX, Splat(extent[0]), MulAdd(planes.absY, Splat(extent[1]), Mul(planes.absZ, Splat(extent[2]))));
+
+			return AnyNegative(Add(distance, radius));
+		}
+	}
+
+	auto Frustum::FromViewProjection(const glm::mat4& m) -> Frustum {
+		Frustum frustum;
+
+		// Gribb/Hartmann plane extraction. glm is column major, so row i is m[0][i], m[1][i], m[2][i], m[3][i]
+		const float sign[6] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+		const int row[6] = { 0, 0, 1, 1, 2, 2 };
+		for (int plane = 0; plane < 8; plane++) {
+			auto index = plane < 6 ? plane : 5;
+			auto r = row[index];
+			float x = m[0][3] + sign[index] * m[0][r];
+			float y = m[1][3] + sign[index] * m[1][r];
+			float z = m[2][3] + sign[index] * m[2][r];
+			float w = m[3][3] + sign[index] * m[3][r];
+
+			// Normalise so distances are in world units
+			float length = std::sqrt(x * x + y * y + z * z);
+			if (length > 0.0f) {
+				x /= length;
+				y /= length;
+				z /= length;
+				w /= length;
+			}
+
+			frustum.x[plane] = x;
+			frustum.y[plane] = y;
+			frustum.z[plane] = z;
+			frustum.w[plane] = w;
+		}
+
+		return frustum;
+	}
+
+	auto CullBounds(
+		const Frustum& frustum,
+		const glm::mat4* models,
+		const Bounds* bounds,
+		size_t count,
+		uint8_t* visible
+	) -> void {
+		const auto lowPlanes = LoadPlanes(frustum, 0);
+		const auto highPlanes = LoadPlanes(frustum, 4);
+
+		alignas(16) float center[4];
+		alignas(16) float extent[4];
+
+		for (size_t x = 0; x < count; x++) {
+			const auto& local = bounds[x];
+			if (!local.IsValid()) {
+				visible[x] = 1;
+				continue;
+			}
+
+			// Transform the box: the center by the full matrix, the extent by the absolute linear part
+			const float* model = &models[x][0][0];
+			auto column0 = Load(model);
+			auto column1 = Load(model + 4);
+			auto column2 = Load(model + 8);
+			auto column3 = Load(model + 12);
+
+			auto localCenterX = (local.min.x + local.max.x) * 0.5f;
+			auto localCenterY = (local.min.y + local.max.y) * 0.5f;
+			auto localCenterZ = (local.min.z + local.max.z) * 0.5f;
+			auto localExtentX = (local.max.x - local.min.x) * 0.5f;
+			auto localExtentY = (local.max.y - local.min.y) * 0.5f;
+			auto localExtentZ = (local.max.z - local.min.z) * 0.5f;
+
+			Store(center, MulAdd(column0, Splat(localCenterX), MulAdd(column1, Splat(localCenterY), MulAdd(column2, Splat(localCenterZ), column3))));
+			Store(extent, MulAdd(Abs(column0), Splat(localExtentX), MulAdd(Abs(column1), Splat(localExtentY), Mul(Abs(column2), Splat(localExtentZ)))));
+
+			visible[x] = !(OutsideAny(lowPlanes, center, extent) || OutsideAny(highPlanes, center, extent));
+		}
+	}
+}
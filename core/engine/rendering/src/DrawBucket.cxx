@@ -0,0 +1,81 @@
+#include "rendering/DrawBucket.hxx"
+
+namespace kyanite::engine::rendering {
+	namespace {
+		auto Merge(DrawBucket& bucket, std::vector<DrawCall>& drawCalls) -> void {
+			const auto count = bucket.Size();
+			for (size_t x = 0; x < count; x++) {
+				drawCalls.push_back(DrawCall { bucket.models[x], bucket.uvRects[x], bucket.vaos[x], bucket.materials[x], bucket.layers[x] });
+			}
+			bucket.Clear();
+		}
+	}
+
+	auto DrawBucketRegistry::Local() -> ThreadDrawBuckets& {
+		// The registry is a process wide singleton, so one cached pointer per thread is enough
+		thread_local ThreadDrawBuckets* buckets = nullptr;
+
+		if (buckets == nullptr) {
+			std::scoped_lock lock { _registrationLock };
+			_buckets.push_back(std::make_unique<ThreadDrawBuckets>());
+			buckets = _buckets.back().get();
+		}
+
+		return *buckets;
+	}
+
+	auto DrawBucketRegistry::MergeIndexed(std::vector<DrawCall>& drawCalls) -> void {
+		std::scoped_lock lock { _registrationLock };
+
+		size_t total = drawCalls.size();
+		for (const auto& buckets : _buckets) {
+			total += buckets->indexed.Size();
+		}
+		drawCalls.reserve(total);
+
+		for (auto& buckets : _buckets) {
+			Merge(buckets->indexed, drawCalls);
+		}
+	}
+
+	auto DrawBucketRegistry::MergeInstanced(std::vector<DrawCall>& drawCalls) -> void {
+		std::scoped_lock lock { _registrationLock };
+
+		size_t total = drawCalls.size();
+		for (const auto& buckets : _buckets) {
+			total += buckets->instanced.Size();
+		}
+		drawCalls.reserve(total);
+
+		for (auto& buckets : _buckets) {
+			Merge(buckets->instanced, drawCalls);
+		}
+	}
+
+	auto DrawBucketRegistry::MergeSprites(std::vector<SpriteInstance>& sprites, std::vector<uint32_t>& materials) -> void {
+		std::scoped_lock lock { _registrationLock };
+
+		size_t total = sprites.size();
+		for (const auto& buckets : _buckets) {
+			total += buckets->sprites.Size();
+		}
+		sprites.reserve(total);
+		materials.reserve(total);
+
+		for (auto& buckets : _buckets) {
+			sprites.insert(sprites.end(), buckets->sprites.sprites.begin(), buckets->sprites.sprites.end());
+			materials.insert(materials.end(), buckets->sprites.materials.begin(), buckets->sprites.materials.end());
+			buckets->sprites.Clear();
+		}
+	}
+
+	auto DrawBucketRegistry::Clear() -> void {
+		std::scoped_lock lock { _registrationLock };
+
+		for (auto& buckets : _buckets) {
+			buckets->indexed.Clear();
+			buckets->instanced.Clear();
+			buckets->sprites.Clear();
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#include "rendering/GpuTimerPool.hxx"
+
+namespace kyanite::engine::rendering {
+	auto GpuTimerPool::BeginFrame() -> void {
+		_frame = (_frame + 1) % FrameLatency;
+		_open.clear();
+		_untimed = 0;
+
+		auto& frame = _frames[_frame];
+		auto closed = [](const Scope& scope) { return scope.end != InvalidQuery; };
+
+		// Timestamps complete in the order they were written, so all of them are there once the one written last is
+		if (frame.lastEnd != InvalidQuery && IsAvailable(frame.lastEnd)) {
+			_results.clear();
+			for (auto& scope : frame.scopes) {
+				if (!closed(scope)) {
+					continue;
+				}
+
+				auto elapsed = Timestamp(scope.end) - Timestamp(scope.begin);
+				_results.push_back({ scope.name, static_cast<double>(elapsed) / 1'000'000.0 });
+			}
+		}
+
+		frame.scopes.clear();
+		frame.lastEnd = InvalidQuery;
+	}
+
+	auto GpuTimerPool::BeginScope(std::string name) -> uint32_t {
+		auto& scopes = _frames[_frame].scopes;
+		if (scopes.size() >= MaxScopes || _untimed > 0) {
+			_untimed++;
+			return InvalidQuery;
+		}
+
+		auto index = static_cast<uint32_t>(scopes.size());
+		auto begin = _frame * QueriesPerFrame + index * 2;
+		scopes.push_back({ std::move(name), begin, InvalidQuery });
+		_open.push_back(index);
+
+		return begin;
+	}
+
+	auto GpuTimerPool::EndScope() -> uint32_t {
+		if (_untimed > 0) {
+			_untimed--;
+			return InvalidQuery;
+		}
+
+		if (_open.empty()) {
+			return InvalidQuery;
+		}
+
+		auto& frame = _frames[_frame];
+		auto& scope = frame.scopes[_open.back()];
+		_open.pop_back();
+		scope.end = scope.begin + 1;
+		frame.lastEnd = scope.end;
+
+		return scope.end;
+	}
+}
@@ -11,12 +11,25 @@ namespace kyanite::engine::rendering {
         _commandQueue->Execute({ _commandList });
     }
 
+    auto GraphicsContext::Finish(const std::vector<GraphicsContext*>& recorded) -> void {
+        std::vector<std::shared_ptr<CommandList>> commandLists = { _commandList };
+        for (auto context : recorded) {
+            commandLists.push_back(context->_commandList);
+        }
+
+        _commandQueue->Execute(commandLists);
+    }
+
     auto GraphicsContext::ClearRenderTarget() -> void {
         _commandList->ClearRenderTarget({ 0.2f, 0.1f, 0.1f, 1.f });
     }
 
     auto GraphicsContext::SetRenderTarget(std::shared_ptr<RenderTarget> target) -> void {
+        _commandList->BindRenderTarget(std::move(target));
+    }
 
+    auto GraphicsContext::TransitionRenderTarget(std::shared_ptr<RenderTarget> target, ResourceState before, ResourceState after) -> void {
+        _commandList->TransitionRenderTarget(std::move(target), before, after);
     }
 
     auto GraphicsContext::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t minDepth, uint32_t maxDepth) -> void {
@@ -31,6 +44,18 @@ namespace kyanite::engine::rendering {
         _commandList->SetPrimitiveTopology(topology);
     }
 
+    auto GraphicsContext::SetBlending(bool enabled) -> void {
+        _commandList->SetBlending(enabled);
+    }
+
+    auto GraphicsContext::SetDepthMode(DepthMode mode) -> void {
+        _commandList->SetDepthMode(mode);
+    }
+
+    auto GraphicsContext::SetDepthBias(float bias) -> void {
+        _commandList->SetDepthBias(bias);
+    }
+
     auto GraphicsContext::SetViewMatrix(glm::mat4 view) -> void {
 		_commandList->SetViewMatrix(view);
 	}
@@ -58,11 +83,67 @@ namespace kyanite::engine::rendering {
         _commandList->SetMaterial(material);
     }
 
-    auto GraphicsContext::DrawIndexed(glm::mat4& model, uint32_t numIndices, uint32_t startIndex) -> void {
-        _commandList->DrawIndexed(model, numIndices, startIndex);
+    auto GraphicsContext::DrawIndexed(glm::mat4& model, glm::vec4& uvRect, uint32_t numIndices, uint32_t startIndex, int32_t baseVertex) -> void {
+        _commandList->DrawIndexed(model, uvRect, numIndices, startIndex, baseVertex);
     }
 
     auto GraphicsContext::DrawIndexedInstanced(uint32_t numIndices, uint32_t instanceCount, uint32_t startIndexLocation, int32_t baseVertexLocation) -> void {
         _commandList->DrawIndexedInstanced(numIndices, instanceCount, startIndexLocation, baseVertexLocation);
     }
+
+    auto GraphicsContext::SetIndirectDraws(std::vector<DrawIndirectCommand> commands, std::vector<DrawData> draws) -> void {
+        _commandList->SetIndirectDraws(std::move(commands), std::move(draws));
+    }
+
+    auto GraphicsContext::MultiDrawIndexedIndirect(uint32_t firstCommand, uint32_t commandCount) -> void {
+        _commandList->MultiDrawIndexedIndirect(firstCommand, commandCount);
+    }
+
+    auto GraphicsContext::SetSpriteInstances(std::vector<SpriteInstance> instances) -> void {
+        _commandList->SetSpriteInstances(std::move(instances));
+    }
+
+    auto GraphicsContext::DrawSpriteInstances(uint32_t numIndices, uint32_t startIndex, int32_t baseVertex, uint32_t firstInstance, uint32_t instanceCount) -> void {
+        _commandList->DrawSpriteInstances(numIndices, startIndex, baseVertex, firstInstance, instanceCount);
+    }
+
+    auto GraphicsContext::BeginFrameTimers() -> void {
+        if (_timers == nullptr) {
+            _timers = _device->CreateTimerPool();
+        }
+
+        if (_timers != nullptr) {
+            _timers->BeginFrame();
+        }
+    }
+
+    auto GraphicsContext::BeginTimer(std::string name) -> void {
+        if (_timers == nullptr) {
+            return;
+        }
+
+        auto query = _timers->BeginScope(std::move(name));
+        if (query != GpuTimerPool::InvalidQuery) {
+            _commandList->WriteTimestamp(_timers, query);
+        }
+    }
+
+    auto GraphicsContext::EndTimer() -> void {
+        if (_timers == nullptr) {
+            return;
+        }
+
+        auto query = _timers->EndScope();
+        if (query != GpuTimerPool::InvalidQuery) {
+            _commandList->WriteTimestamp(_timers, query);
+        }
+    }
+
+    auto GraphicsContext::GpuTimes() const -> std::vector<GpuScopeTime> {
+        if (_timers == nullptr) {
+            return {};
+        }
+
+        return _timers->Results();
+    }
 }
\ No newline at end of file
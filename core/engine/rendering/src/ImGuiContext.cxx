@@ -16,15 +16,27 @@ namespace kyanite::engine::rendering {
 		ImGuiContext* imGuiContext
 	) : _window(window), Context(CommandListType::Graphics, device, queue) {
 		ImGui::SetCurrentContext(imGuiContext);
-		ImGui_ImplSDL2_InitForOpenGL(window, context);
-		ImGui_ImplOpenGL3_Init("#version 130");
-
+		// Headless devices have no window, they set the display size themselves
+		if (window != nullptr) {
+			ImGui_ImplSDL2_InitForOpenGL(window, context);
+		}
 		_backend = backend;
+		if (_backend == RenderBackendType::OpenGL) {
+			ImGui_ImplOpenGL3_Init("#version 130");
+		}
+		else {
+			// No renderer backend builds the font atlas, which every frame needs
+			ImGui::GetIO().Fonts->Build();
+		}
 	}
 
 	auto ImmediateGuiContext::Begin() -> void {
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplSDL2_NewFrame(_window);
+		if (_backend == RenderBackendType::OpenGL) {
+			ImGui_ImplOpenGL3_NewFrame();
+		}
+		if (_window != nullptr) {
+			ImGui_ImplSDL2_NewFrame(_window);
+		}
 		ImGui::NewFrame();
 		ImGuiDockNodeFlags dockspace_flags = ImGuiDockNodeFlags_PassthruCentralNode;
 		ImGuiWindowFlags window_flags = 0;
@@ -37,13 +49,21 @@ namespace kyanite::engine::rendering {
 	}
 
 	ImmediateGuiContext::~ImmediateGuiContext() {
-		ImGui_ImplSDL2_Shutdown();
-		ImGui_ImplOpenGL3_Shutdown();
+		if (_window != nullptr) {
+			ImGui_ImplSDL2_Shutdown();
+		}
+		if (_backend == RenderBackendType::OpenGL) {
+			ImGui_ImplOpenGL3_Shutdown();
+		}
 		ImGui::DestroyContext();
 	}
 
 	auto ImmediateGuiContext::Finish() -> void {
 		ImGui::Render();
+		if (_backend != RenderBackendType::OpenGL) {
+			return;
+		}
+
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 		if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
 			SDL_Window* backup_current_window = SDL_GL_GetCurrentWindow();
@@ -53,4 +73,39 @@ namespace kyanite::engine::rendering {
 			SDL_GL_MakeCurrent(backup_current_window, backup_current_context);
 		}
 	}
+
+	auto ImmediateGuiContext::CreateDeviceObjects() -> void {
+		if (_backend == RenderBackendType::OpenGL) {
+			ImGui_ImplOpenGL3_CreateDeviceObjects();
+		}
+	}
+
+	auto ImmediateGuiContext::Capture(GuiSnapshot& snapshot) -> void {
+		ImGui::Render();
+		snapshot.Capture(*ImGui::GetDrawData());
+	}
+
+	auto ImmediateGuiContext::Render(GuiSnapshot& snapshot) -> void {
+		if (auto drawData = snapshot.DrawData(); drawData != nullptr && _backend == RenderBackendType::OpenGL) {
+			ImGui_ImplOpenGL3_RenderDrawData(drawData);
+		}
+	}
+
+	auto GuiSnapshot::Capture(const ImDrawData& source) -> void {
+		Clear();
+		_drawData.Valid = source.Valid;
+		_drawData.DisplayPos = source.DisplayPos;
+		_drawData.DisplaySize = source.DisplaySize;
+		_drawData.FramebufferScale = source.FramebufferScale;
+		for (auto list : source.CmdLists) {
+			_drawData.AddDrawList(list->CloneOutput());
+		}
+	}
+
+	auto GuiSnapshot::Clear() -> void {
+		for (auto list : _drawData.CmdLists) {
+			IM_DELETE(list);
+		}
+		_drawData.Clear();
+	}
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "rendering/MeshBuffer.hxx"
+
+#include <algorithm>
+
+namespace kyanite::engine::rendering {
+	MeshBuffer::MeshBuffer(std::shared_ptr<Device> device) : _device(std::move(device)) {}
+
+	auto MeshBuffer::Allocate(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) -> std::shared_ptr<MeshRange> {
+		if (vertexCount == 0 || indexCount == 0) {
+			return nullptr;
+		}
+
+		auto place = [&](Page& page, uint32_t pageIndex) -> std::shared_ptr<MeshRange> {
+			auto baseVertex = page.vertices.Allocate(vertexCount);
+			if (!baseVertex) {
+				return nullptr;
+			}
+			auto firstIndex = page.indices.Allocate(indexCount);
+			if (!firstIndex) {
+				page.vertices.Free(*baseVertex, vertexCount);
+				return nullptr;
+			}
+
+			page.vertexArray->VertexBuffer()->SetSubData(*baseVertex * sizeof(Vertex), vertices, vertexCount * sizeof(Vertex));
+			page.vertexArray->IndexBuffer()->SetSubData(*firstIndex * sizeof(uint32_t), indices, indexCount * sizeof(uint32_t));
+
+			Bounds bounds;
+			for (uint32_t x = 0; x < vertexCount; x++) {
+				bounds.Encapsulate(vertices[x].position);
+			}
+
+			return std::make_shared<MeshRange>(page.vertexArray, pageIndex, *baseVertex, vertexCount, *firstIndex, indexCount, bounds);
+		};
+
+		for (size_t x = 0; x < _pages.size(); x++) {
+			if (auto range = place(_pages[x], static_cast<uint32_t>(x))) {
+				return range;
+			}
+		}
+
+		// Meshes larger than a page get a page of their own size
+		auto& page = AddPage(std::max(vertexCount, PageVertices), std::max(indexCount, PageIndices));
+		return place(page, static_cast<uint32_t>(_pages.size() - 1));
+	}
+
+	auto MeshBuffer::Free(const MeshRange& range) -> void {
+		if (range.Page() >= _pages.size()) {
+			return;
+		}
+
+		// GL orders later writes to the freed storage after the draws already submitted from it
+		auto& page = _pages[range.Page()];
+		page.vertices.Free(static_cast<uint32_t>(range.BaseVertex()), range.VertexCount());
+		page.indices.Free(range.FirstIndex(), range.Indices());
+	}
+
+	auto MeshBuffer::AddPage(uint32_t vertexCapacity, uint32_t indexCapacity) -> Page& {
+		auto vertexBuffer = _device->CreateVertexBuffer(nullptr, vertexCapacity, sizeof(Vertex));
+		auto indexBuffer = _device->CreateIndexBuffer(nullptr, indexCapacity);
+		auto vertexArray = _device->CreateVertexArray(vertexBuffer, indexBuffer);
+
+		_pages.push_back(Page { vertexArray, RangeAllocator(vertexCapacity), RangeAllocator(indexCapacity) });
+
+		return _pages.back();
+	}
+}
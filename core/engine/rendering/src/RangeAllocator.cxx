@@ -0,0 +1,63 @@
+#include "rendering/RangeAllocator.hxx"
+
+#include <iterator>
+
+namespace kyanite::engine::rendering {
+	RangeAllocator::RangeAllocator(uint32_t capacity) : _capacity(capacity), _available(capacity) {
+		if (capacity > 0) {
+			_free[0] = capacity;
+		}
+	}
+
+	auto RangeAllocator::Allocate(uint32_t count) -> std::optional<uint32_t> {
+		if (count == 0 || count > _available) {
+			return std::nullopt;
+		}
+
+		for (auto range = _free.begin(); range != _free.end(); range++) {
+			if (range->second < count) {
+				continue;
+			}
+
+			// Take the front of the range, the rest stays free in place
+			auto offset = range->first;
+			auto remaining = range->second - count;
+			_free.erase(range);
+			if (remaining > 0) {
+				_free[offset + count] = remaining;
+			}
+			_available -= count;
+
+			return offset;
+		}
+
+		return std::nullopt;
+	}
+
+	auto RangeAllocator::Free(uint32_t offset, uint32_t count) -> void {
+		if (count == 0) {
+			return;
+		}
+		_available += count;
+
+		auto next = _free.lower_bound(offset);
+
+		// Merge with the range directly before
+		if (next != _free.begin()) {
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset) {
+				offset = previous->first;
+				count += previous->second;
+				_free.erase(previous);
+			}
+		}
+
+		// and with the one directly after
+		if (next != _free.end() && offset + count == next->first) {
+			count += next->second;
+			_free.erase(next);
+		}
+
+		_free[offset] = count;
+	}
+}
@@ -0,0 +1,265 @@
+#include "rendering/RenderGraph.hxx"
+#include "rendering/Device.hxx"
+#include "rendering/GraphicsContext.hxx"
+
+#include <algorithm>
+#include <iostream>
+
+namespace kyanite::engine::rendering {
+	RenderTargetPool::RenderTargetPool(std::shared_ptr<Device> device) : _device(std::move(device)) {}
+
+	auto RenderTargetPool::Acquire(const RenderTargetDesc& desc) -> std::shared_ptr<RenderTarget> {
+		// The most recently released match first, it is the one most likely to still be resident
+		for (auto entry = _free.rbegin(); entry != _free.rend(); entry++) {
+			if (entry->target->Desc() == desc) {
+				auto target = std::move(entry->target);
+				_free.erase(std::next(entry).base());
+				return target;
+			}
+		}
+
+		_size++;
+		return _device->CreateRenderTarget(desc);
+	}
+
+	auto RenderTargetPool::Release(std::shared_ptr<RenderTarget> target) -> void {
+		if (target == nullptr) {
+			return;
+		}
+
+		_free.push_back(Entry { std::move(target), _frame });
+	}
+
+	auto RenderTargetPool::EndFrame() -> void {
+		_frame++;
+
+		auto idle = std::remove_if(_free.begin(), _free.end(), [this](const Entry& entry) {
+			return _frame - entry.releasedFrame > MaxIdleFrames;
+		});
+		_size -= std::distance(idle, _free.end());
+		_free.erase(idle, _free.end());
+	}
+
+	auto RenderGraphBuilder::Create(std::string name, const RenderTargetDesc& desc) -> RenderResourceHandle {
+		auto handle = static_cast<RenderResourceHandle>(_graph._resources.size());
+		_graph._resources.push_back({ std::move(name), desc, nullptr, false, ResourceState::Undefined });
+
+		return Write(handle);
+	}
+
+	auto RenderGraphBuilder::Read(RenderResourceHandle resource) -> RenderResourceHandle {
+		if (resource >= _graph._resources.size()) {
+			std::cerr << "Pass " << _pass._name << " reads an unknown render target" << std::endl;
+			return resource;
+		}
+
+		if (std::find(_pass._writes.begin(), _pass._writes.end(), resource) != _pass._writes.end()) {
+			std::cerr << "Pass " << _pass._name << " reads " << _graph._resources[resource].name << ", which it renders to" << std::endl;
+			return resource;
+		}
+
+		if (std::find(_pass._reads.begin(), _pass._reads.end(), resource) == _pass._reads.end()) {
+			_pass._reads.push_back(resource);
+		}
+
+		return resource;
+	}
+
+	auto RenderGraphBuilder::Write(RenderResourceHandle resource) -> RenderResourceHandle {
+		if (resource >= _graph._resources.size()) {
+			std::cerr << "Pass " << _pass._name << " writes an unknown render target" << std::endl;
+			return resource;
+		}
+
+		if (!_pass._writes.empty()) {
+			if (_pass._writes.front() != resource) {
+				std::cerr << "Pass " << _pass._name << " already renders to " << _graph._resources[_pass._writes.front()].name << std::endl;
+			}
+			return resource;
+		}
+
+		_pass._writes.push_back(resource);
+		_graph._resources[resource].writers.push_back(_graph._passes.size() - 1);
+
+		return resource;
+	}
+
+	auto RenderGraphBuilder::SideEffects() -> void {
+		_pass._sideEffects = true;
+	}
+
+	auto RenderPassContext::Target(RenderResourceHandle resource) const -> std::shared_ptr<RenderTarget> {
+		if (resource >= _graph._resources.size()) {
+			return nullptr;
+		}
+
+		return _graph._resources[resource].target;
+	}
+
+	auto RenderGraph::Import(
+		std::string name,
+		std::shared_ptr<RenderTarget> target,
+		const RenderTargetDesc& desc,
+		ResourceState state
+	) -> RenderResourceHandle {
+		auto handle = static_cast<RenderResourceHandle>(_resources.size());
+		_resources.push_back({ std::move(name), desc, std::move(target), true, state });
+
+		return handle;
+	}
+
+	auto RenderGraph::AddPass(
+		std::string name,
+		const std::function<void(RenderGraphBuilder&)>& setup,
+		std::function<void(RenderPassContext&)> execute
+	) -> void {
+		_passes.emplace_back(std::move(name), std::move(execute));
+
+		RenderGraphBuilder builder(*this, _passes.back());
+		setup(builder);
+	}
+
+	auto RenderGraph::Compile() -> void {
+		// Count who depends on what. Imported targets are read by whoever owns them after the graph
+		for (auto& pass : _passes) {
+			pass._refCount = static_cast<uint32_t>(pass._writes.size()) + (pass._sideEffects ? 1 : 0);
+			pass._culled = false;
+			pass._barriers.clear();
+			pass._acquires.clear();
+			pass._releases.clear();
+		}
+		for (auto& resource : _resources) {
+			resource.refCount = resource.imported ? 1 : 0;
+		}
+		for (auto& pass : _passes) {
+			for (auto read : pass._reads) {
+				_resources[read].refCount++;
+			}
+		}
+
+		// A pass that writes nothing and has no side effects contributes nothing, so it goes first
+		for (auto& pass : _passes) {
+			if (pass._refCount == 0) {
+				pass._culled = true;
+				for (auto read : pass._reads) {
+					_resources[read].refCount--;
+				}
+			}
+		}
+
+		// Then cull backwards from the targets nobody reads, a pass goes once nothing it writes is read
+		std::vector<RenderResourceHandle> unreferenced;
+		for (RenderResourceHandle x = 0; x < _resources.size(); x++) {
+			if (_resources[x].refCount == 0) {
+				unreferenced.push_back(x);
+			}
+		}
+
+		while (!unreferenced.empty()) {
+			auto resource = unreferenced.back();
+			unreferenced.pop_back();
+
+			for (auto writer : _resources[resource].writers) {
+				auto& pass = _passes[writer];
+				if (pass._refCount == 0 || --pass._refCount > 0) {
+					continue;
+				}
+
+				pass._culled = true;
+				for (auto read : pass._reads) {
+					if (--_resources[read].refCount == 0) {
+						unreferenced.push_back(read);
+					}
+				}
+			}
+		}
+
+		// Lifetimes of the transient targets, as the first and last pass that uses them
+		constexpr size_t Unused = SIZE_MAX;
+		std::vector<std::pair<size_t, size_t>> lifetimes(_resources.size(), { Unused, 0 });
+		std::vector<ResourceState> states(_resources.size());
+		for (size_t x = 0; x < _resources.size(); x++) {
+			states[x] = _resources[x].initialState;
+		}
+
+		for (size_t x = 0; x < _passes.size(); x++) {
+			auto& pass = _passes[x];
+			if (pass._culled) {
+				continue;
+			}
+
+			auto use = [&](RenderResourceHandle resource, ResourceState state) {
+				if (!_resources[resource].imported) {
+					auto& lifetime = lifetimes[resource];
+					lifetime.first = std::min(lifetime.first, x);
+					lifetime.second = x;
+				}
+
+				if (states[resource] != state) {
+					pass._barriers.push_back({ resource, states[resource], state });
+					states[resource] = state;
+				}
+			};
+
+			for (auto read : pass._reads) {
+				use(read, ResourceState::ShaderResource);
+			}
+			for (auto write : pass._writes) {
+				use(write, ResourceState::RenderTarget);
+			}
+		}
+
+		// A target goes back to the pool after its last pass, so a later one of the same kind takes its memory over
+		for (size_t x = 0; x < _resources.size(); x++) {
+			auto [first, last] = lifetimes[x];
+			if (first == Unused) {
+				continue;
+			}
+
+			_passes[first]._acquires.push_back(static_cast<RenderResourceHandle>(x));
+			_passes[last]._releases.push_back(static_cast<RenderResourceHandle>(x));
+		}
+	}
+
+	auto RenderGraph::Execute(GraphicsContext& context, RenderTargetPool& pool) -> void {
+		for (auto& pass : _passes) {
+			if (pass._culled) {
+				continue;
+			}
+
+			for (auto resource : pass._acquires) {
+				_resources[resource].target = pool.Acquire(_resources[resource].desc);
+			}
+
+			for (auto& barrier : pass._barriers) {
+				context.TransitionRenderTarget(_resources[barrier.resource].target, barrier.before, barrier.after);
+			}
+
+			if (!pass._writes.empty()) {
+				context.SetRenderTarget(_resources[pass._writes.front()].target);
+			}
+
+			context.BeginTimer(pass._name);
+
+			RenderPassContext passContext(*this, context);
+			pass._execute(passContext);
+
+			// Contexts recorded in parallel run before anything of the following passes
+			if (!passContext._recorded.empty()) {
+				context.Finish(passContext._recorded);
+				context.Begin();
+			}
+
+			// Closed after the recorded contexts, so their work counts towards the pass
+			context.EndTimer();
+
+			for (auto resource : pass._releases) {
+				pool.Release(std::move(_resources[resource].target));
+			}
+		}
+	}
+
+	auto RenderGraph::CulledPasses() const -> size_t {
+		return std::count_if(_passes.begin(), _passes.end(), [](const RenderPass& pass) { return pass._culled; });
+	}
+}
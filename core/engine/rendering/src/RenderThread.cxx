@@ -0,0 +1,76 @@
+#include "rendering/RenderThread.hxx"
+
+#include <algorithm>
+
+namespace kyanite::engine::rendering {
+	RenderThread::RenderThread(
+		size_t maxFramesInFlight,
+		std::function<void()> attach,
+		std::function<void(FramePacket&)> render,
+		std::function<void()> detach
+	) :
+		_attach(std::move(attach)),
+		_render(std::move(render)),
+		_detach(std::move(detach)),
+		_maxFramesInFlight(std::max<size_t>(1, maxFramesInFlight)),
+		_thread([this]() { Run(); }) {
+	}
+
+	RenderThread::~RenderThread() {
+		{
+			std::scoped_lock lock { _lock };
+			_stopping = true;
+		}
+		_workSignal.notify_one();
+		_thread.join();
+	}
+
+	auto RenderThread::Submit(std::unique_ptr<FramePacket> packet) -> void {
+		// std::function has to be copyable, so the packet is shared with the job that draws it
+		std::shared_ptr<FramePacket> shared = std::move(packet);
+		{
+			std::unique_lock lock { _lock };
+			_frameSignal.wait(lock, [this]() { return _framesInFlight < _maxFramesInFlight; });
+			_framesInFlight++;
+			_work.push_back([this, shared]() {
+				_render(*shared);
+
+				{
+					std::scoped_lock lock { _lock };
+					_framesInFlight--;
+				}
+				_frameSignal.notify_one();
+			});
+		}
+		_workSignal.notify_one();
+	}
+
+	auto RenderThread::Post(std::function<void()> job) -> void {
+		{
+			std::scoped_lock lock { _lock };
+			_work.push_back(std::move(job));
+		}
+		_workSignal.notify_one();
+	}
+
+	auto RenderThread::Run() -> void {
+		_attach();
+
+		while (true) {
+			std::function<void()> job;
+			{
+				std::unique_lock lock { _lock };
+				_workSignal.wait(lock, [this]() { return _stopping || !_work.empty(); });
+				if (_stopping && _work.empty()) {
+					break;
+				}
+				job = std::move(_work.front());
+				_work.pop_front();
+			}
+
+			job();
+		}
+
+		_detach();
+	}
+}
@@ -1,91 +1,194 @@
 #include "rendering/Rendering.hxx"
 #include "rendering/Device.hxx"
-#include "rendering/opengl/GLDevice.hxx"
+#include "rendering/opengl/GlDevice.hxx"
 #include "rendering/GraphicsContext.hxx"
 #include "rendering/ImGuiContext.hxx"
 #include "rendering/UploadContext.hxx"
 #include "rendering/VertexArray.hxx"
 #include "rendering/VertexBuffer.hxx"
 #include "rendering/DeviceFactory.hxx"
+#include "rendering/Culling.hxx"
+#include "rendering/DrawBucket.hxx"
+#include "rendering/DrawCall.hxx"
+#include "rendering/FramePacket.hxx"
+#include "rendering/FrameTimings.hxx"
+#include "rendering/MeshBuffer.hxx"
+#include "rendering/RenderGraph.hxx"
+#include "rendering/RenderThread.hxx"
+#include "rendering/SlotMap.hxx"
+#include "rendering/SpriteAtlas.hxx"
+#include "rendering/SpriteBatch.hxx"
+#include "rendering/SpriteTransforms.hxx"
+#include "rendering/TextureLoader.hxx"
+#include "rendering/Tilemap.hxx"
+#include "rendering/Vertex.hxx"
+#include "rendering/WorkerPool.hxx"
+
+#include <shared/MeshFormat.hxx>
 
-#include <concurrentqueue/concurrentqueue.h>
-#include <FreeImagePlus.h>
 #include <glad/glad.h>
 #include <SDL.h>
 #include <imgui.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
 #include <filesystem>
+#include <iostream>
+#include <limits>
 #include <stdexcept>
-#include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <rendering/renderdoc_app.h>
 
 uint32_t CreateSpriteVao() {
-	std::vector<float> vertices = {
-		-0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
-		0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
-		0.5f, 0.5f, 0.0f, 1.0f, 1.0f,
-		-0.5f, 0.5f, 0.0f, 0.0f, 1.0f
+	std::vector<kyanite::engine::rendering::Vertex> vertices = {
+		{ { -0.5f, -0.5f, 0.0f }, { 0.0f, 0.0f } },
+		{ { 0.5f, -0.5f, 0.0f }, { 1.0f, 0.0f } },
+		{ { 0.5f, 0.5f, 0.0f }, { 1.0f, 1.0f } },
+		{ { -0.5f, 0.5f, 0.0f }, { 0.0f, 1.0f } }
 	};
-	uint32_t vb = kyanite::engine::rendering::CreateVertexBuffer(vertices.data(), vertices.size(), sizeof(float));
 
 	// Create the index buffer
 	std::vector<uint32_t> indices = {
 		0, 1, 2,
 		2, 3, 0
 	};
-	uint32_t ib = kyanite::engine::rendering::CreateIndexBuffer(indices.data(), indices.size());
 
-	// Create the vertex array
-	uint32_t vao = kyanite::engine::rendering::CreateVertexArray(vb, ib);
-
-	return vao;
+	// The quad lives in the mesh buffer, so sprites and meshes share one vertex array
+	return kyanite::engine::rendering::CreateMesh(vertices.data(), vertices.size(), indices.data(), indices.size());
 }
 
-struct DrawCall {
-	glm::mat4 model;
-	uint32_t vao;
-	uint32_t material;
-};
-
-struct InstancedDrawCall {
-	uint32_t vao;
-	uint32_t material;
-	std::vector<glm::mat4> models;
-};
-
 namespace kyanite::engine::rendering {
 	std::shared_ptr<Device> device = nullptr;
 	SDL_Window* window = nullptr;
 
-	// Resource management
-	std::map<uint64_t, std::shared_ptr<VertexBuffer>> vertexBuffers = {};
-	std::map<uint64_t, std::shared_ptr<IndexBuffer>> indexBuffers = {};
-	std::map<uint64_t, std::shared_ptr<VertexArray>> vertexArrays = {};
-	std::map<uint32_t, std::shared_ptr<Texture>> textures = {};
-	std::map<uint32_t, std::shared_ptr<Shader>> shaders = {};
-	std::map<uint32_t, std::shared_ptr<Material>> materials = {};
-	std::map<uint32_t, std::shared_ptr<Mesh>> meshes = {};
+	// Resource management. Handles are generational, so stale or unknown ids resolve to nullptr
+	SlotMap<std::shared_ptr<VertexBuffer>> vertexBuffers = {};
+	SlotMap<std::shared_ptr<IndexBuffer>> indexBuffers = {};
+	SlotMap<std::shared_ptr<VertexArray>> vertexArrays = {};
+	SlotMap<std::shared_ptr<Texture>> textures = {};
+	SlotMap<std::shared_ptr<Shader>> shaders = {};
+	SlotMap<std::shared_ptr<Material>> materials = {};
+	SlotMap<std::shared_ptr<Mesh>> meshes = {};
+	SlotMap<SpriteAtlas> atlases = {};
+	SlotMap<std::shared_ptr<Tilemap>> tilemaps = {};
+	// Guards the buffer, vertex array, texture and material maps. While the render thread runs it is the only one that
+	// inserts into and removes from them, and it reads them without the lock. Every other thread resolves handles through
+	// Find, which holds the lock shared.
+	std::shared_mutex resourceLock;
+
+	// Resolves a handle on any thread. The value is copied out, pointers into the map move when the render thread inserts.
+	template<typename T>
+	auto Find(const SlotMap<std::shared_ptr<T>>& map, uint32_t handle) -> std::shared_ptr<T> {
+		std::shared_lock lock { resourceLock };
+		auto value = map.Get(handle);
+
+		return value != nullptr ? *value : nullptr;
+	}
+
+	// Tilemaps drawn with dirty chunks, each once. Draws run on the workers, so their chunks are rebuilt at the start of the next frame.
+	std::mutex tilemapRebuildLock;
+	std::vector<uint32_t> tilemapRebuilds;
+	auto RebuildTilemapChunks(Tilemap& tilemap) -> void;
 
 	std::unique_ptr<GraphicsContext> graphicsContext = nullptr;
 	std::unique_ptr<ImmediateGuiContext> imguiContext = nullptr;
 	std::unique_ptr<UploadContext> uploadContext = nullptr;
 	std::unique_ptr<Swapchain> swapchain = nullptr;
-	moodycamel::ConcurrentQueue<DrawCall> drawCalls;
-	moodycamel::ConcurrentQueue<DrawCall> instancedDrawCalls;
-	std::vector<DrawCall> mergedDrawCalls;
-	std::vector<std::shared_ptr<VertexBuffer>> instanceBuffers;
+	DrawBucketRegistry drawBuckets;
+
+	// Culling
+	constexpr size_t CullingBatchSize = 256;
+	std::unique_ptr<WorkerPool> workerPool = nullptr;
+	std::unique_ptr<TextureLoader> textureLoader = nullptr;
+	Frustum frustum = {};
+	std::vector<uint8_t> visibility;
+	// Batched sprites of all threads before culling, kept so frames do not allocate
+	std::vector<SpriteInstance> submittedSprites;
+	std::vector<uint32_t> submittedSpriteMaterials;
 
 	uint32_t spriteVao = 0;
+	std::unique_ptr<MeshBuffer> meshBuffer;
+
+	// Draw recording. The sorted draws are split into ranges that are recorded in parallel, one context per range,
+	// and replayed after the main context in range order, so the frame comes out the same on any core count.
+	constexpr size_t RecordingBatchSize = 1024;
+	std::vector<std::unique_ptr<GraphicsContext>> recordingContexts;
+	std::vector<GraphicsContext*> recordedContexts;
+
+	// Transient targets of the frame graph, kept across frames and shared by passes that do not overlap
+	std::unique_ptr<RenderTargetPool> renderTargets;
+
+	// Frame state the simulation sets, captured into the packet of every frame
+	glm::mat4 frameView = glm::mat4(1.0f);
+	glm::mat4 frameProjection = glm::mat4(1.0f);
+	Rect frameViewport = { 0, 0, 1920, 1080 };
+
+	// Counters of the last presented frame, the device starts collecting the next one after the swap
+	FrameStats lastFrameStats = {};
+	// Filled in by both threads, each writes its own fields
+	FrameTimings lastFrameTimings = {};
+	std::mutex statsLock;
+	std::chrono::steady_clock::time_point frameStart = {};
+	bool timingOverlay = false;
+
+	auto MillisecondsSince(std::chrono::steady_clock::time_point start) -> double {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	// Optional. Without it packets are drawn on the simulation thread at the end of PostFrame.
+	// With it, everything that touches GL or changes the resource maps runs on the render thread.
+	std::unique_ptr<RenderThread> renderThread = nullptr;
+
+	// Runs a job on the thread that owns the graphics context and waits for its result
+	template<typename Job>
+	auto OnRenderThread(Job&& job) -> std::invoke_result_t<Job&> {
+		if (renderThread == nullptr) {
+			return job();
+		}
+
+		return renderThread->Invoke(std::forward<Job>(job));
+	}
+
+	// Same without waiting, for setters that scripts may call every frame
+	auto PostToRenderThread(std::function<void()> job) -> void {
+		if (renderThread == nullptr) {
+			job();
+			return;
+		}
+
+		renderThread->Post(std::move(job));
+	}
+
+	// Everything after the device is the same for every kind of device
+	auto InitDevice(std::shared_ptr<Device> createdDevice, ImGuiContext* context) -> void {
+		device = std::move(createdDevice);
+		workerPool = std::make_unique<WorkerPool>();
+
+		graphicsContext = device->CreateGraphicsContext();
+		imguiContext = device->CreateImGuiContext(context);
+		uploadContext = device->CreateUploadContext();
+		swapchain = device->CreateSwapchain();
+		textureLoader = std::make_unique<TextureLoader>(*workerPool, *uploadContext);
+		meshBuffer = std::make_unique<MeshBuffer>(device);
+		renderTargets = std::make_unique<RenderTargetPool>(device);
+
+		// Register the sprite vertex array
+		spriteVao = CreateSpriteVao();
+	}
 
 	auto Init(NativePointer window, ImGuiContext* context) -> void {
 		SDL_InitSubSystem(SDL_INIT_VIDEO);
 		auto sdlWindow = reinterpret_cast<SDL_Window*>(window);
 		kyanite::engine::rendering::window = sdlWindow;
 
+#ifdef _WIN32
 		RENDERDOC_API_1_1_2* rdoc_api = NULL;
 
 		// At init, on windows
@@ -96,34 +199,71 @@ namespace kyanite::engine::rendering {
 			int ret = RENDERDOC_GetAPI(eRENDERDOC_API_Version_1_1_2, (void**)&rdoc_api);
 			assert(ret == 1);
 		}
+#endif
 
 		// Create a device
-		device = DeviceFactory::CreateDevice(RenderBackendType::OpenGL, sdlWindow);
-
-		graphicsContext = device->CreateGraphicsContext();
-		imguiContext = device->CreateImGuiContext(context);
-		uploadContext = device->CreateUploadContext();
-		swapchain = device->CreateSwapchain();
+		InitDevice(DeviceFactory::CreateDevice(RenderBackendType::OpenGL, sdlWindow), context);
+	}
 
-		// Register the sprite vertex array
-		spriteVao = CreateSpriteVao();
+	auto InitHeadless(uint32_t width, uint32_t height, ImGuiContext* context, RenderBackendType backend) -> void {
+		InitDevice(DeviceFactory::CreateHeadlessDevice(backend, width, height), context);
+		SetViewport(0, 0, width, height);
 	}
 
 	auto Shutdown() -> void {
+		StopRenderThread();
+
 		// Cleanup
+		drawBuckets.Clear();
+		// Recorded lists still hold the resources of the last frame
+		recordedContexts.clear();
+		recordingContexts.clear();
+		meshes.Clear();
+		atlases.Clear();
+		tilemapRebuilds.clear();
+		tilemaps.Clear();
+		materials.Clear();
+		textures.Clear();
+		shaders.Clear();
+		vertexArrays.Clear();
+		indexBuffers.Clear();
+		vertexBuffers.Clear();
+		meshBuffer = nullptr;
+		renderTargets = nullptr;
+		// Stop the workers first, pending decodes still reference the upload context
+		workerPool = nullptr;
+		textureLoader = nullptr;
+		swapchain = nullptr;
 		device = nullptr;
 		SDL_QuitSubSystem(SDL_INIT_VIDEO);
 	}
 
 	inline auto PreFrame() -> void {
-		// ImGui new frame, resource loading, etc.
-		// Start the ImGui frame
-		graphicsContext->Begin();
+		auto start = std::chrono::steady_clock::now();
+		if (frameStart != std::chrono::steady_clock::time_point {}) {
+			std::scoped_lock lock { statsLock };
+			lastFrameTimings.cpuFrame = std::chrono::duration<double, std::milli>(start - frameStart).count();
+		}
+		frameStart = start;
+
+		// No system runs yet, so chunks are rebuilt before any of them draws the map again
+		std::vector<uint32_t> rebuilds;
+		{
+			std::scoped_lock lock { tilemapRebuildLock };
+			rebuilds.swap(tilemapRebuilds);
+		}
+		for (auto tilemapId : rebuilds) {
+			// Maps destroyed since they were drawn resolve to nullptr
+			auto tilemap = Find(tilemaps, tilemapId);
+			if (tilemap != nullptr) {
+				tilemap->StartRebuild();
+				RebuildTilemapChunks(*tilemap);
+			}
+		}
+
+		// Start the ImGui frame, it is built by the simulation and ended in PostFrame
 		imguiContext->Begin();
-		uploadContext->Begin();
-		graphicsContext->ClearRenderTarget();
-		graphicsContext->SetViewport(0, 0, 1920, 1080, 0.0, 1.0);
-		graphicsContext->SetScissorRect(0, 0, 640, 360);
+
 		// View Matrix
 		glm::mat4 view = glm::lookAtLH(
 			glm::vec3(0.0f, 0.0f, -1.0f),    // Camera position (Z = -1)
@@ -140,321 +280,1256 @@ namespace kyanite::engine::rendering {
 			0.1f,         // Near plane
 			100.0f        // Far plane
 		);
-		graphicsContext->SetViewMatrix(view);
-		graphicsContext->SetProjectionMatrix(projection);
-		graphicsContext->SetPrimitiveTopology(PrimitiveTopology::TRIANGLE_LIST);
+		frameView = view;
+		frameProjection = projection;
+		frustum = Frustum::FromViewProjection(projection * view);
 
-		// Upload all the resources before rendering
+		std::scoped_lock lock { statsLock };
+		lastFrameTimings.preFrame = MillisecondsSince(start);
 	}
 
 	inline auto Update(float deltaTime) -> void {
-		uploadContext->Finish();
+		// Uploads belong to the packet of the frame and are done when it is drawn
 	}
 
-	inline auto PostFrame() -> void {
-		uint32_t lastVao = 0;
+	// Moves the bounds of updated vertex buffers to the frame their vertices are drawn in
+	auto ApplyStagedBounds(const StagedBuffers& staged) -> void {
+		for (const auto& update : staged.bounds) {
+			auto bounds = update.bounds;
+			if (!update.replace) {
+				bounds.Encapsulate(update.buffer->LocalBounds().min);
+				bounds.Encapsulate(update.buffer->LocalBounds().max);
+			}
+			update.buffer->SetLocalBounds(bounds);
+		}
+	}
+
+	// Drops all draw calls whose bounds are outside of the current frustum. Runs in batches on the worker pool.
+	auto CullDrawCalls(std::vector<DrawCall>& drawCalls) -> void {
+		visibility.resize(drawCalls.size());
+
+		workerPool->Dispatch(drawCalls.size(), CullingBatchSize, [&drawCalls](size_t begin, size_t end) {
+			thread_local std::vector<glm::mat4> models;
+			thread_local std::vector<Bounds> bounds;
+			models.clear();
+			bounds.clear();
+
+			// Held for the whole batch, the bounds are read straight from the map
+			std::shared_lock lock { resourceLock };
+			uint32_t lastVao = 0;
+			Bounds lastBounds = {};
+			for (size_t x = begin; x < end; x++) {
+				const auto& drawCall = drawCalls[x];
+				if (drawCall.vao != lastVao) {
+					auto vertexArray = vertexArrays.Get(drawCall.vao);
+					lastBounds = vertexArray != nullptr ? (*vertexArray)->LocalBounds() : Bounds {};
+					lastVao = drawCall.vao;
+				}
+				models.push_back(drawCall.model);
+				bounds.push_back(lastBounds);
+			}
+
+			CullBounds(frustum, models.data(), bounds.data(), models.size(), visibility.data() + begin);
+		});
+
+		size_t kept = 0;
+		for (size_t x = 0; x < drawCalls.size(); x++) {
+			if (visibility[x]) {
+				drawCalls[kept++] = drawCalls[x];
+			}
+		}
+		drawCalls.resize(kept);
+	}
+
+	// Maps a float to an unsigned integer with the same order
+	inline auto SortableDepth(float depth) -> uint32_t {
+		auto bits = std::bit_cast<uint32_t>(depth);
+		return (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+	}
+
+	/**
+	* @brief Splits draws into the opaque and the blended pass by their material and orders both
+	* @note Opaque draws go by layer, highest first, then front to back in coarse depth buckets, then by material and
+	* vertex array. Early depth tests reject what they hide, while draws at similar depths still share state.
+	* Blended draws go by layer, lowest first, then back to front, ties in the order they were submitted.
+	*/
+	auto SortDrawCalls(std::vector<DrawCall>& drawCalls, std::vector<DrawCall>& blendedDrawCalls, const glm::mat4& view) -> void {
+		struct SortEntry {
+			uint64_t key;
+			uint32_t vao;
+			uint32_t index;
+		};
+
+		thread_local std::vector<SortEntry> opaqueOrder;
+		thread_local std::vector<SortEntry> blendedOrder;
+		thread_local std::vector<DrawCall> sorted;
+		opaqueOrder.clear();
+		blendedOrder.clear();
+		sorted.clear();
+
+		// The row of the view matrix that gives the view space depth, larger is further away
+		const glm::vec4 depthRow = { view[0][2], view[1][2], view[2][2], view[3][2] };
+
 		uint32_t lastMaterialId = 0;
+		bool resolved = false;
+		bool opaque = false;
+		for (size_t x = 0; x < drawCalls.size(); x++) {
+			const auto& drawCall = drawCalls[x];
+			if (!resolved || drawCall.material != lastMaterialId) {
+				auto material = Find(materials, drawCall.material);
+				opaque = material != nullptr && material->isOpaque;
+				lastMaterialId = drawCall.material;
+				resolved = true;
+			}
+
+			auto depth = SortableDepth(glm::dot(depthRow, drawCall.model[3]));
+			auto index = static_cast<uint32_t>(x);
+			if (opaque) {
+				auto key = static_cast<uint64_t>(static_cast<uint16_t>(~drawCall.layer)) << 48 | static_cast<uint64_t>(depth >> 16) << 32 | drawCall.material;
+				opaqueOrder.push_back({ key, drawCall.vao, index });
+			}
+			else {
+				auto key = static_cast<uint64_t>(drawCall.layer) << 32 | static_cast<uint32_t>(~depth);
+				blendedOrder.push_back({ key, drawCall.vao, index });
+			}
+		}
 
-		// Turn the draw calls into a vector
-		mergedDrawCalls.clear();
-		mergedDrawCalls.reserve(drawCalls.size_approx());
+		std::ranges::sort(opaqueOrder, [](const SortEntry& a, const SortEntry& b) {
+			if (a.key != b.key) {
+				return a.key < b.key;
+			}
+			if (a.vao != b.vao) {
+				return a.vao < b.vao;
+			}
+			return a.index < b.index;
+		});
+		std::ranges::sort(blendedOrder, [](const SortEntry& a, const SortEntry& b) {
+			if (a.key != b.key) {
+				return a.key < b.key;
+			}
+			return a.index < b.index;
+		});
 
-		// Turn the draw calls into a vector
-		DrawCall call;
-		while (drawCalls.try_dequeue(call)) {
-			mergedDrawCalls.push_back(call);
+		blendedDrawCalls.reserve(blendedDrawCalls.size() + blendedOrder.size());
+		for (auto& entry : blendedOrder) {
+			blendedDrawCalls.push_back(drawCalls[entry.index]);
 		}
 
-		if (!mergedDrawCalls.empty()) {
-			// Sort the draw calls by material and then by vertex array
-			std::ranges::sort(mergedDrawCalls.begin(), mergedDrawCalls.end(), [](const DrawCall& a, const DrawCall& b) {
-				if (a.material == b.material) {
-					return a.vao < b.vao;
-				}
-				return a.material < b.material;
-				});
+		sorted.reserve(opaqueOrder.size());
+		for (auto& entry : opaqueOrder) {
+			sorted.push_back(drawCalls[entry.index]);
+		}
+		drawCalls.swap(sorted);
+	}
+
+	// Gets the recording context of a slot and starts it with the frame wide state and the state of its pass,
+	// command lists do not share any
+	auto BeginRecording(size_t slot, const FramePacket& packet, bool blended) -> GraphicsContext& {
+		while (recordingContexts.size() <= slot) {
+			recordingContexts.push_back(device->CreateGraphicsContext());
+		}
 
-			lastMaterialId = mergedDrawCalls.front().material;
-			lastVao = mergedDrawCalls.front().vao;
+		auto& context = *recordingContexts[slot];
+		context.Begin();
+		context.SetViewMatrix(packet.view);
+		context.SetProjectionMatrix(packet.projection);
+		context.SetPrimitiveTopology(PrimitiveTopology::TRIANGLE_LIST);
+		context.SetBlending(blended);
+		context.SetDepthMode(blended ? DepthMode::TestOnly : DepthMode::TestAndWrite);
 
-			graphicsContext->SetVertexArray(vertexArrays[lastVao]);
-			graphicsContext->SetIndexBuffer(vertexArrays[lastVao]->IndexBuffer());
-			graphicsContext->SetVertexBuffer(0, vertexArrays[lastVao]->VertexBuffer());
-			graphicsContext->SetMaterial(materials[lastMaterialId]);
+		return context;
+	}
+
+	// Records a range of sorted indexed draws. Only reads resources, so ranges can be recorded on any thread.
+	auto RecordIndexedDraws(GraphicsContext& context, const DrawCall* begin, const DrawCall* end) -> void {
+		uint32_t lastVao = 0;
+		uint32_t lastMaterialId = 0;
+		uint32_t boundVertexArray = UINT32_MAX;
+		uint32_t biasLayer = UINT32_MAX;
 
-			glm::mat4 model = glm::mat4(1.0f);
-			// Process each identical group
-			for (const auto& drawCall : mergedDrawCalls) {
-				model = drawCall.model;
+		// Handles are resolved once per state change, not once per draw
+		std::shared_ptr<VertexArray>* vertexArray = nullptr;
+		std::shared_ptr<Material>* material = nullptr;
 
-				if (lastVao != drawCall.vao) {
-					// If the vertex array has changed, we need to bind the new vertex array
-					graphicsContext->SetVertexArray(vertexArrays[drawCall.vao]);
-					graphicsContext->SetIndexBuffer(vertexArrays[drawCall.vao]->IndexBuffer());
-					graphicsContext->SetVertexBuffer(0, vertexArrays[drawCall.vao]->VertexBuffer());
-					lastVao = drawCall.vao;
+		// Process each identical group
+		for (auto drawCall = begin; drawCall != end; drawCall++) {
+			if (vertexArray == nullptr || lastVao != drawCall->vao) {
+				// If the vertex array has changed, we need to bind the new vertex array
+				vertexArray = vertexArrays.Get(drawCall->vao);
+				lastVao = drawCall->vao;
+				if (vertexArray == nullptr) {
+					continue;
 				}
 
-				if (lastMaterialId != drawCall.material) {
-					// If the material has changed, we need to bind the new material
-					graphicsContext->SetMaterial(materials[drawCall.material]);
-					lastMaterialId = drawCall.material;
+				// Meshes of one mesh buffer page share their vertex array, only the offsets of the draw change
+				if ((*vertexArray)->Id() != boundVertexArray) {
+					context.SetVertexArray(*vertexArray);
+					context.SetIndexBuffer((*vertexArray)->IndexBuffer());
+					context.SetVertexBuffer(0, (*vertexArray)->VertexBuffer());
+					boundVertexArray = (*vertexArray)->Id();
+				}
+			}
+
+			if (material == nullptr || lastMaterialId != drawCall->material) {
+				// If the material has changed, we need to bind the new material
+				material = materials.Get(drawCall->material);
+				lastMaterialId = drawCall->material;
+				if (material == nullptr) {
+					continue;
 				}
+				context.SetMaterial(*material);
+			}
 
-				// Issue the draw call
-				graphicsContext->DrawIndexed(model, vertexArrays[drawCall.vao]->Indices(), 0);
+			// Draws are sorted by layer first, so the bias only changes between layers
+			if (drawCall->layer != biasLayer) {
+				context.SetDepthBias(LayerDepthBias(drawCall->layer));
+				biasLayer = drawCall->layer;
 			}
 
-			// Process instanced draw calls
-			mergedDrawCalls.clear();
+			// Issue the draw call
+			auto model = drawCall->model;
+			auto uvRect = drawCall->uvRect;
+			context.DrawIndexed(model, uvRect, (*vertexArray)->Indices(), (*vertexArray)->FirstIndex(), (*vertexArray)->BaseVertex());
 		}
+	}
 
-		// Turn the draw calls into a vector
-		std::vector<InstancedDrawCall> instancedDrawCallsVector;
+	// Records sorted indexed draws in ranges on the workers, one new recorded context per range
+	auto RecordDrawCalls(const DrawCall* drawCalls, size_t count, const FramePacket& packet, bool blended) -> void {
+		if (count == 0) {
+			return;
+		}
 
-		DrawCall instancedCall;
-		while (instancedDrawCalls.try_dequeue(instancedCall)) {
-			auto it = std::ranges::find_if(instancedDrawCallsVector, [&](const auto& draw) {
-				return draw.material == instancedCall.material && draw.vao == instancedCall.vao;
-				});
+		// Contexts are created up front, the workers only record into them
+		auto first = recordedContexts.size();
+		auto ranges = (count + RecordingBatchSize - 1) / RecordingBatchSize;
+		for (size_t range = 0; range < ranges; range++) {
+			recordedContexts.push_back(&BeginRecording(first + range, packet, blended));
+		}
+
+		workerPool->Dispatch(count, RecordingBatchSize, [drawCalls, first](size_t begin, size_t end) {
+			auto& context = *recordedContexts[first + begin / RecordingBatchSize];
+			RecordIndexedDraws(context, drawCalls + begin, drawCalls + end);
+		});
+	}
 
-			if (it != instancedDrawCallsVector.end()) {
-				// If we have a draw call with same material and vertex array, increment the number of instances
-				it->models.push_back(instancedCall.model);
+	// Records sorted instanced draws as one indirect command per run of the same mesh and material.
+	// Runs that share a material and a vertex array are submitted together, so the call count follows the buckets, not the draws.
+	auto RecordIndirectDraws(GraphicsContext& context, const DrawCall* begin, const DrawCall* end) -> void {
+		struct Submission {
+			std::shared_ptr<VertexArray> vertexArray;
+			std::shared_ptr<Material> material;
+			uint16_t layer;
+			uint32_t firstCommand;
+			uint32_t commandCount;
+		};
+
+		std::vector<DrawIndirectCommand> commands;
+		std::vector<DrawData> draws;
+		std::vector<Submission> submissions;
+		draws.reserve(end - begin);
+
+		uint32_t lastVao = 0;
+		uint32_t lastMaterialId = 0;
+		uint16_t lastLayer = 0;
+		std::shared_ptr<VertexArray>* vertexArray = nullptr;
+		std::shared_ptr<Material>* material = nullptr;
+		bool extendsCommand = false;
+
+		for (auto drawCall = begin; drawCall != end; drawCall++) {
+			// Every layer has its own depth bias, so a command never spans two
+			extendsCommand = vertexArray != nullptr && material != nullptr && lastVao == drawCall->vao && lastMaterialId == drawCall->material && lastLayer == drawCall->layer;
+			lastLayer = drawCall->layer;
+			if (vertexArray == nullptr || lastVao != drawCall->vao) {
+				vertexArray = vertexArrays.Get(drawCall->vao);
+				lastVao = drawCall->vao;
 			}
-			else {
-				// If we don't have a draw call with same material and vertex array, add a new draw call with 1 instance
-				instancedDrawCallsVector.push_back(
-					InstancedDrawCall{ instancedCall.vao, instancedCall.material, {instancedCall.model} }
-				);
+			if (material == nullptr || lastMaterialId != drawCall->material) {
+				material = materials.Get(drawCall->material);
+				lastMaterialId = drawCall->material;
+			}
+			if (vertexArray == nullptr || material == nullptr) {
+				continue;
+			}
+
+			draws.push_back({ drawCall->model, drawCall->uvRect });
+
+			// The same mesh again only adds an instance, its record follows the ones before it
+			if (extendsCommand) {
+				commands.back().instanceCount++;
+				continue;
 			}
+
+			commands.push_back({
+				(*vertexArray)->Indices(),
+				1,
+				(*vertexArray)->FirstIndex(),
+				(*vertexArray)->BaseVertex(),
+				static_cast<uint32_t>(draws.size() - 1)
+			});
+
+			if (submissions.empty() ||
+				submissions.back().material != *material ||
+				submissions.back().vertexArray->Id() != (*vertexArray)->Id() ||
+				submissions.back().layer != drawCall->layer) {
+				submissions.push_back({ *vertexArray, *material, drawCall->layer, static_cast<uint32_t>(commands.size() - 1), 0 });
+			}
+			submissions.back().commandCount++;
 		}
 
-		uint32_t instances = 0;
-		// Process each identical group
-		std::vector<glm::mat4> matrices;
-		for (const auto& drawCall : instancedDrawCallsVector) {
-			auto material = drawCall.material;
-			auto modelId = drawCall.vao;
+		if (submissions.empty()) {
+			return;
+		}
 
-			if(lastVao != modelId) {
-				// If the vertex array has changed, we need to bind the new vertex array
-				vertexArrays[modelId]->Bind();
-				lastVao = modelId;
+		context.SetIndirectDraws(std::move(commands), std::move(draws));
+
+		uint32_t boundVertexArray = UINT32_MAX;
+		uint32_t biasLayer = UINT32_MAX;
+		std::shared_ptr<Material> boundMaterial;
+		for (auto& submission : submissions) {
+			if (submission.layer != biasLayer) {
+				context.SetDepthBias(LayerDepthBias(submission.layer));
+				biasLayer = submission.layer;
+			}
+			if (submission.material != boundMaterial) {
+				context.SetMaterial(submission.material);
+				boundMaterial = submission.material;
+			}
+			if (submission.vertexArray->Id() != boundVertexArray) {
+				context.SetVertexArray(submission.vertexArray);
+				context.SetIndexBuffer(submission.vertexArray->IndexBuffer());
+				context.SetVertexBuffer(0, submission.vertexArray->VertexBuffer());
+				boundVertexArray = submission.vertexArray->Id();
 			}
 
-			if(lastMaterialId != material) {
-				// If the material has changed, we need to bind the new material
-				graphicsContext->SetMaterial(materials[material]);
-				lastMaterialId = material;
+			context.MultiDrawIndexedIndirect(submission.firstCommand, submission.commandCount);
+		}
+	}
+
+	// Records a range of sprite batches, every batch expands the shared quad once per sprite.
+	// Only the instances of the range are uploaded, batches are ordered so theirs are next to each other.
+	auto RecordSpriteBatches(GraphicsContext& context, const FramePacket& packet, const SpriteBatch* begin, const SpriteBatch* end) -> void {
+		auto quad = vertexArrays.Get(spriteVao);
+		if (begin == end || quad == nullptr) {
+			return;
+		}
+
+		auto firstInstance = begin->firstInstance;
+		auto lastInstance = (end - 1)->firstInstance + (end - 1)->instanceCount;
+		context.SetSpriteInstances(std::vector<SpriteInstance>(packet.sprites.begin() + firstInstance, packet.sprites.begin() + lastInstance));
+		context.SetVertexArray(*quad);
+		context.SetIndexBuffer((*quad)->IndexBuffer());
+		context.SetVertexBuffer(0, (*quad)->VertexBuffer());
+
+		uint32_t boundMaterial = 0;
+		uint32_t biasLayer = UINT32_MAX;
+		for (auto batch = begin; batch != end; batch++) {
+			if (batch->layer != biasLayer) {
+				context.SetDepthBias(LayerDepthBias(batch->layer));
+				biasLayer = batch->layer;
+			}
+			if (batch->material != boundMaterial) {
+				auto material = materials.Get(batch->material);
+				if (material == nullptr) {
+					continue;
+				}
+				context.SetMaterial(*material);
+				boundMaterial = batch->material;
 			}
 
-			// Bind the vertex array.
-			graphicsContext->SetVertexArray(vertexArrays[modelId]);
-			graphicsContext->SetIndexBuffer(vertexArrays[modelId]->IndexBuffer());
-			graphicsContext->SetVertexBuffer(0, vertexArrays[modelId]->VertexBuffer());
+			context.DrawSpriteInstances((*quad)->Indices(), (*quad)->FirstIndex(), (*quad)->BaseVertex(), batch->firstInstance - firstInstance, batch->instanceCount);
+		}
+	}
 
-			// Create a vector of matrices
-			matrices.reserve(drawCall.models.size());
-			for(const auto& model : drawCall.models) {
-				matrices.push_back(model);
+	// Records the blended draws one layer at a time, lowest first, so a higher layer is in front whichever way it was drawn.
+	// Within a layer indexed draws go first, then instanced ones and then batched sprites.
+	auto RecordBlendedLayers(const FramePacket& packet) -> void {
+		const auto& blended = packet.blendedDrawCalls;
+		const auto& blendedInstanced = packet.blendedInstancedDrawCalls;
+		const auto& batches = packet.spriteBatches;
+		size_t nextDraw = 0;
+		size_t nextInstanced = 0;
+		size_t nextBatch = 0;
+		while (nextDraw < blended.size() || nextInstanced < blendedInstanced.size() || nextBatch < batches.size()) {
+			auto layer = std::numeric_limits<uint16_t>::max();
+			if (nextDraw < blended.size()) {
+				layer = std::min(layer, blended[nextDraw].layer);
+			}
+			if (nextInstanced < blendedInstanced.size()) {
+				layer = std::min(layer, blendedInstanced[nextInstanced].layer);
+			}
+			if (nextBatch < batches.size()) {
+				layer = std::min(layer, batches[nextBatch].layer);
 			}
 
-			// Create an instance buffer
-			auto instanceBuffer = device->CreateVertexBuffer(matrices.data(), drawCall.models.size(), sizeof(glm::mat4));
-			instanceBuffers.push_back(instanceBuffer);
+			auto drawEnd = nextDraw;
+			while (drawEnd < blended.size() && blended[drawEnd].layer == layer) {
+				drawEnd++;
+			}
+			auto instancedEnd = nextInstanced;
+			while (instancedEnd < blendedInstanced.size() && blendedInstanced[instancedEnd].layer == layer) {
+				instancedEnd++;
+			}
+			auto batchEnd = nextBatch;
+			while (batchEnd < batches.size() && batches[batchEnd].layer == layer) {
+				batchEnd++;
+			}
 
-			// Bind the instance buffer
-			graphicsContext->SetVertexBuffer(1, instanceBuffer);
+			RecordDrawCalls(blended.data() + nextDraw, drawEnd - nextDraw, packet, true);
+			if (instancedEnd > nextInstanced || batchEnd > nextBatch) {
+				auto& blendedContext = BeginRecording(recordedContexts.size(), packet, true);
+				recordedContexts.push_back(&blendedContext);
+				RecordIndirectDraws(blendedContext, blendedInstanced.data() + nextInstanced, blendedInstanced.data() + instancedEnd);
+				RecordSpriteBatches(blendedContext, packet, batches.data() + nextBatch, batches.data() + batchEnd);
+			}
 
-			// Bind the material
-			graphicsContext->SetMaterial(materials[material]);
-			// Issue the draw call
-			graphicsContext->DrawIndexedInstanced(vertexArrays[modelId]->Indices(), drawCall.models.size(), 0, 0);
+			nextDraw = drawEnd;
+			nextInstanced = instancedEnd;
+			nextBatch = batchEnd;
+		}
+	}
+
+	// Records, submits and presents one packet. Runs on the render thread if there is one.
+	auto RecordScene(RenderPassContext& pass, FramePacket& packet) -> void {
+		auto& context = pass.Context();
+		context.ClearRenderTarget();
+		context.SetViewport(packet.viewport.X, packet.viewport.Y, packet.viewport.Width, packet.viewport.Height, 0.0, 1.0);
+		context.SetScissorRect(0, 0, 640, 360);
+		context.SetViewMatrix(packet.view);
+		context.SetProjectionMatrix(packet.projection);
+		context.SetPrimitiveTopology(PrimitiveTopology::TRIANGLE_LIST);
+
+		// Opaque draws first, so the blended ones are only drawn where nothing opaque is in front of them.
+		// Instanced materials read their per draw data from attributes, so they are submitted indirectly on this thread.
+		RecordDrawCalls(packet.drawCalls.data(), packet.drawCalls.size(), packet, false);
+		auto& opaqueContext = BeginRecording(recordedContexts.size(), packet, false);
+		recordedContexts.push_back(&opaqueContext);
+		RecordIndirectDraws(opaqueContext, packet.instancedDrawCalls.data(), packet.instancedDrawCalls.data() + packet.instancedDrawCalls.size());
+
+		RecordBlendedLayers(packet);
+
+		// Every recorded range runs after the frame setup of the pass, in range order
+		for (auto recorded : recordedContexts) {
+			pass.Submit(*recorded);
+		}
+	}
+
+	auto RenderPacket(FramePacket& packet) -> void {
+		auto start = std::chrono::steady_clock::now();
+		recordedContexts.clear();
+
+		// The buffer contents of this frame and any textures that fit the budget, before anything is drawn
+		uploadContext->UploadStagedBuffers(std::move(packet.buffers));
+		uploadContext->Finish();
+
+		// Materials that are not drawn are asked too, so IsMaterialReady turns true for them as well
+		for (auto& material : materials) {
+			if (!material->WasReady()) {
+				material->IsReady();
+			}
+		}
 
-			matrices.clear();
+		// The frame as a graph, passes that do not contribute to the backbuffer are culled
+		RenderGraph graph;
+		auto backbuffer = graph.Import(
+			"Backbuffer",
+			nullptr,
+			{ packet.viewport.Width, packet.viewport.Height, RenderTargetFormat::RGBA8, false }
+		);
+		graph.AddPass(
+			"Scene",
+			[&](RenderGraphBuilder& builder) { builder.Write(backbuffer); },
+			[&](RenderPassContext& pass) { RecordScene(pass, packet); }
+		);
+		graph.Compile();
+
+		graphicsContext->Begin();
+		graphicsContext->BeginFrameTimers();
+		graphicsContext->BeginTimer("Frame");
+		graph.Execute(*graphicsContext, *renderTargets);
+		graphicsContext->BeginTimer("GUI");
+		graphicsContext->Finish();
+		renderTargets->EndFrame();
+
+		// Packets drawn on the render thread carry a copy of the GUI, otherwise the live ImGui frame is ended here
+		if (packet.gui.DrawData() != nullptr) {
+			imguiContext->Render(packet.gui);
+		}
+		else {
+			imguiContext->Finish();
 		}
 
-		// Render the actual frame
+		// ImGui draws outside of the context, so the timers around it are submitted on their own
+		graphicsContext->Begin();
+		graphicsContext->EndTimer();
+		graphicsContext->EndTimer();
 		graphicsContext->Finish();
-		imguiContext->Finish();
+		auto render = MillisecondsSince(start);
 
 		// Finally, swap the buffers
+		auto swapStart = std::chrono::steady_clock::now();
 		swapchain->Swap();
+		auto swap = MillisecondsSince(swapStart);
 
-		// Cleanup
-		instanceBuffers.clear();
+		auto scopes = graphicsContext->GpuTimes();
+		auto gpuFrame = swapchain->GpuFrameTime();
+		if (gpuFrame == 0.0) {
+			auto frame = std::find_if(scopes.begin(), scopes.end(), [](const GpuScopeTime& scope) { return scope.name == "Frame"; });
+			gpuFrame = frame != scopes.end() ? frame->milliseconds : 0.0;
+		}
+
+		{
+			std::scoped_lock lock { statsLock };
+			lastFrameStats = device->Stats();
+			lastFrameStats.gpuFrameTime = gpuFrame;
+			lastFrameTimings.render = render;
+			lastFrameTimings.swap = swap;
+			lastFrameTimings.gpuFrame = gpuFrame;
+			lastFrameTimings.scopes = std::move(scopes);
+		}
+		device->ResetStats();
 	}
 
-	auto LoadTexture(const uint8_t* data, size_t len) -> uint32_t {
-		uint32_t key = 0;
+	// Where the last frames spent their time, drawn into the ImGui frame of the simulation
+	auto DrawTimingOverlay() -> void {
+		FrameTimings timings;
+		{
+			std::scoped_lock lock { statsLock };
+			timings = lastFrameTimings;
+		}
+
+		ImGui::SetNextWindowPos({ 10.0f, 10.0f }, ImGuiCond_FirstUseEver);
+		ImGui::Begin("Frame timings", &timingOverlay, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing);
+		ImGui::Text("CPU frame  %7.3f ms", timings.cpuFrame);
+		ImGui::Text("PreFrame   %7.3f ms", timings.preFrame);
+		ImGui::Text("PostFrame  %7.3f ms", timings.postFrame);
+		ImGui::Text("Render     %7.3f ms", timings.render);
+		ImGui::Text("Swap       %7.3f ms", timings.swap);
+		ImGui::Separator();
+		ImGui::Text("GPU frame  %7.3f ms", timings.gpuFrame);
+		for (auto& scope : timings.scopes) {
+			ImGui::Text("  %-16s %7.3f ms", scope.name.c_str(), scope.milliseconds);
+		}
+		ImGui::Separator();
+
+		// The swap is left out, it blocks on the GPU or the display and would make every frame look CPU bound
+		auto simulation = timings.preFrame + timings.postFrame;
+		auto cpu = renderThread == nullptr ? simulation + timings.render : std::max(simulation, timings.render);
+		if (timings.gpuFrame == 0.0) {
+			ImGui::TextUnformatted("No GPU times on this device");
+		}
+		else {
+			ImGui::TextUnformatted(timings.gpuFrame > cpu ? "GPU bound" : "CPU bound");
+		}
+		ImGui::End();
+	}
+
+	inline auto PostFrame() -> void {
+		auto start = std::chrono::steady_clock::now();
+		if (timingOverlay) {
+			DrawTimingOverlay();
+		}
+
+		auto packet = std::make_unique<FramePacket>();
+		packet->view = frameView;
+		packet->projection = frameProjection;
+		packet->viewport = frameViewport;
+
+		// Updates staged from here on belong to the next frame. The bounds are applied now, before this frame is culled.
+		packet->buffers = uploadContext->TakeStagedBuffers();
+		ApplyStagedBounds(packet->buffers);
+
+		// Collect the draw calls of all submitting threads
+		drawBuckets.MergeIndexed(packet->drawCalls);
+		CullDrawCalls(packet->drawCalls);
+		SortDrawCalls(packet->drawCalls, packet->blendedDrawCalls, packet->view);
+
+		drawBuckets.MergeInstanced(packet->instancedDrawCalls);
+		CullDrawCalls(packet->instancedDrawCalls);
+		SortDrawCalls(packet->instancedDrawCalls, packet->blendedInstancedDrawCalls, packet->view);
+
+		drawBuckets.MergeSprites(submittedSprites, submittedSpriteMaterials);
+		BatchSprites(frustum, submittedSprites, submittedSpriteMaterials, packet->sprites, packet->spriteBatches);
+		submittedSprites.clear();
+		submittedSpriteMaterials.clear();
+
+		if (renderThread == nullptr) {
+			{
+				std::scoped_lock lock { statsLock };
+				lastFrameTimings.postFrame = MillisecondsSince(start);
+			}
 
-		// If there are no textures, set the key to 0
-		if(textures.empty()) {
-			key = 0;
-		} else if(auto lastTexture = --textures.end(); lastTexture != textures.end()) {
-			key = lastTexture->first + 1;
+			RenderPacket(*packet);
+			return;
 		}
 
-		// Load the texture from memory using FreeImage
-		FIMEMORY* memory = FreeImage_OpenMemory((BYTE*)data, len);
-		auto bitmap = FreeImage_LoadFromMemory(FIF_PNG, memory);
+		// The render thread draws this packet while the next frame is simulated
+		imguiContext->Capture(packet->gui);
+		renderThread->Submit(std::move(packet));
 
-		// Get width, height, channels and data as RGBA
-		uint32_t width = FreeImage_GetWidth(bitmap);
-		uint32_t height = FreeImage_GetHeight(bitmap);
-		uint32_t pitch = FreeImage_GetPitch(bitmap);
-		uint8_t channels = FreeImage_GetLine(bitmap) / width;
-		auto bits = FreeImage_GetBits(bitmap);
+		std::scoped_lock lock { statsLock };
+		lastFrameTimings.postFrame = MillisecondsSince(start);
+	}
+
+	auto StartRenderThread(size_t maxFramesInFlight) -> void {
+		if (renderThread != nullptr) {
+			return;
+		}
 
-		// Create pixeldata vev<uint8_t> from bits
-		std::vector<uint8_t> pixelData(bits, bits + pitch * height);
+		// The ImGui backend creates its GL objects on the first frame, which would happen on the wrong thread
+		imguiContext->CreateDeviceObjects();
+		device->DetachFromCurrentThread();
 
-		auto texture = device->CreateTexture(width, height, channels, pixelData.data());
+		renderThread = std::make_unique<RenderThread>(
+			maxFramesInFlight,
+			[]() { device->AttachToCurrentThread(); },
+			[](FramePacket& packet) { RenderPacket(packet); },
+			[]() { device->DetachFromCurrentThread(); }
+		);
+	}
 
-		textures[key] = texture;
+	auto StopRenderThread() -> void {
+		if (renderThread == nullptr) {
+			return;
+		}
 
-		return key;
+		// Draws the packets still in flight and hands the context back to this thread
+		renderThread = nullptr;
+		device->AttachToCurrentThread();
+	}
+
+	auto LoadTexture(const uint8_t* data, size_t len) -> uint32_t {
+		return OnRenderThread([&]() -> uint32_t {
+			// Hand out a placeholder right away, the image is decoded and uploaded in the background
+			auto texture = device->CreatePlaceholderTexture();
+			textureLoader->Load(texture, data, len);
+
+			std::unique_lock lock { resourceLock };
+			return textures.Insert(texture);
+		});
+	}
+
+	auto LoadTextureFile(std::string_view path) -> uint32_t {
+		return OnRenderThread([&]() -> uint32_t {
+			auto file = io::MappedFile::Open(std::filesystem::path(path));
+			if (file == nullptr) {
+				std::cerr << "Failed to open texture " << path << std::endl;
+				return SlotMap<std::shared_ptr<Texture>>::InvalidHandle;
+			}
+
+			auto texture = device->CreatePlaceholderTexture();
+			textureLoader->Load(texture, std::move(file));
+
+			std::unique_lock lock { resourceLock };
+			return textures.Insert(texture);
+		});
 	}
 
 	auto LoadShader(
 		std::string code,
 		ShaderType type
 	) -> uint32_t {
-		uint32_t key = 0;
-		// If there are no shaders, set the key to 0
-		if (shaders.empty()) {
-			key = 0;
-		}
-		else if (auto lastShader = --shaders.end(); lastShader != shaders.end()) {
-			key = lastShader->first + 1;
-		}
+		return OnRenderThread([&]() -> uint32_t {
+			auto shader = device->CompileShader(code, type);
 
-		auto shader = device->CompileShader(code, type);
-		shaders[key] = shader;
-
-		return key;
+			return shaders.Insert(shader);
+		});
 	}
 
-	auto UnloadShader(uint64_t shader) -> void {
-		device->DestroyShader(shader);
+	auto UnloadShader(uint64_t shaderId) -> void {
+		OnRenderThread([&]() {
+			auto shader = shaders.Get(static_cast<uint32_t>(shaderId));
+			if (shader == nullptr) {
+				std::cerr << "Tried to unload an unknown shader" << std::endl;
+				return;
+			}
+
+			device->DestroyShader((*shader)->id);
+			shaders.Remove(static_cast<uint32_t>(shaderId));
+		});
 	}
 
 	auto LoadModel(std::string_view path) -> std::vector<Mesh> {
-		return std::vector<Mesh>();
+		static_assert(static_cast<uint32_t>(VertexLayout::Half16) == static_cast<uint32_t>(shared::VertexFormat::Half16));
+		static_assert(shared::VertexStride(shared::VertexFormat::Float32) == sizeof(Vertex));
+
+		return OnRenderThread([&]() -> std::vector<Mesh> {
+			auto file = io::MappedFile::Open(std::filesystem::path(path));
+			shared::MeshHeader header;
+			std::vector<shared::MeshEntry> entries;
+			if (file == nullptr || !shared::ReadMeshHeader(file->Data(), file->Size(), header, entries)) {
+				std::cerr << "Failed to open model " << path << std::endl;
+				return {};
+			}
+
+			// Cooked ranges are already optimized and in their GPU layout, they are uploaded from the mapping as they are
+			std::vector<Mesh> meshes;
+			meshes.reserve(entries.size());
+			for (const auto& entry : entries) {
+				auto vertexBuffer = device->CreateVertexBuffer(
+					file->Data() + entry.vertexOffset,
+					entry.vertexCount,
+					shared::VertexStride(entry.format)
+				);
+				vertexBuffer->SetLayout(static_cast<VertexLayout>(entry.format));
+
+				Bounds bounds;
+				bounds.Encapsulate(glm::vec3(entry.boundsMin[0], entry.boundsMin[1], entry.boundsMin[2]));
+				bounds.Encapsulate(glm::vec3(entry.boundsMax[0], entry.boundsMax[1], entry.boundsMax[2]));
+				vertexBuffer->SetLocalBounds(bounds);
+
+				auto indexBuffer = device->CreateIndexBuffer(
+					reinterpret_cast<const uint32_t*>(file->Data() + entry.indexOffset),
+					entry.indexCount
+				);
+
+				std::unique_lock lock { resourceLock };
+				meshes.push_back({
+					vertexBuffers.Insert(vertexBuffer),
+					indexBuffers.Insert(indexBuffer),
+					entry.vertexCount,
+					entry.indexCount
+				});
+			}
+
+			return meshes;
+		});
 	}
 
 	auto CreateMaterial(uint32_t pixelShader, uint32_t vertexShader, bool isInstanced) -> uint32_t {
-		auto material = device->CreateMaterial(
-			{
+		return OnRenderThread([&]() -> uint32_t {
+			auto vertex = shaders.Get(vertexShader);
+			auto fragment = shaders.Get(pixelShader);
+			if (vertex == nullptr || fragment == nullptr) {
+				std::cerr << "Tried to create a material from an unknown shader" << std::endl;
+				return SlotMap<std::shared_ptr<Material>>::InvalidHandle;
+			}
+
+			auto material = device->CreateMaterial(
 				{
-					ShaderType::VERTEX, shaders[vertexShader]
+					{
+						ShaderType::VERTEX, *vertex
+					},
+					{
+						ShaderType::FRAGMENT, *fragment
+					}
 				},
-				{
-					ShaderType::FRAGMENT, shaders[pixelShader]
-				}
-			},
-			isInstanced
-		);
+				isInstanced
+			);
+
+			std::unique_lock lock { resourceLock };
+			return materials.Insert(material);
+		});
+	}
+
+	auto CopyMaterial(uint32_t materialId) -> uint32_t {
+		return OnRenderThread([&]() -> uint32_t {
+			auto material = materials.Get(materialId);
+			if (material == nullptr) {
+				std::cerr << "Tried to copy an unknown material" << std::endl;
+				return SlotMap<std::shared_ptr<Material>>::InvalidHandle;
+			}
 
-		uint32_t key = 0;
+			// The copy shares the linked program, only its textures and parameters are duplicated
+			auto copy = device->CreateMaterial((*material)->shaders, (*material)->isInstanced);
+			copy->CopyParameters(**material);
+			copy->isOpaque = (*material)->isOpaque;
 
-		// If there are no materials, set the key to 0
-		if (materials.empty()) {
-			key = 0;
+			std::unique_lock lock { resourceLock };
+			return materials.Insert(copy);
+		});
+	}
+
+	// Vertex buffers are bound with the Vertex layout, so their local bounds can be taken from the positions
+	auto EncapsulateVertices(Bounds& bounds, const void* data, size_t bytes) -> bool {
+		if (data == nullptr || bytes % sizeof(Vertex) != 0) {
+			return false;
 		}
-		else if (auto lastMaterial = --materials.end(); lastMaterial != materials.end()) {
-			key = lastMaterial->first + 1;
+
+		auto vertices = reinterpret_cast<const Vertex*>(data);
+		for (size_t x = 0; x < bytes / sizeof(Vertex); x++) {
+			bounds.Encapsulate(vertices[x].position);
 		}
 
-		materials[key] = material;
+		return true;
+	}
+
+	auto CreateVertexBuffer(const void* data, size_t size, size_t elemSize, BufferUsage usage) -> uint32_t {
+		return OnRenderThread([&]() -> uint32_t {
+			auto buffer = device->CreateVertexBuffer(data, size, elemSize, usage);
 
-		return key;
+			if (Bounds bounds; EncapsulateVertices(bounds, data, size * elemSize)) {
+				buffer->SetLocalBounds(bounds);
+			}
+
+			std::unique_lock lock { resourceLock };
+			return vertexBuffers.Insert(buffer);
+		});
 	}
 
-	auto CopyMaterial(uint32_t materialId) -> uint32_t {
-		auto material = materials[materialId];
+	auto CreateIndexBuffer(const uint32_t* indices, size_t len, BufferUsage usage) -> uint32_t {
+		return OnRenderThread([&]() -> uint32_t {
+			auto buffer = device->CreateIndexBuffer(indices, len, usage);
+
+			std::unique_lock lock { resourceLock };
+			return indexBuffers.Insert(buffer);
+		});
+	}
+
+	// Updates only copy the bytes into the upload context, so they do not wait for the render thread.
+	// They become part of the packet of this frame, the GPU sees them right before that packet is drawn.
+	auto UpdateVertexBuffer(uint32_t buffer, const void* data, size_t size) -> void {
+		auto vertexBuffer = Find(vertexBuffers, buffer);
+		if (vertexBuffer == nullptr) {
+			std::cerr << "Tried to update an unknown vertex buffer" << std::endl;
+			return;
+		}
+
+		Bounds bounds;
+		auto hasBounds = vertexBuffer->Layout() == VertexLayout::Float32 && EncapsulateVertices(bounds, data, size);
+		uploadContext->UpdateVertexBuffer(vertexBuffer, data, size, hasBounds ? &bounds : nullptr);
+	}
+
+	auto UpdateVertexBufferRange(uint32_t buffer, size_t offset, const void* data, size_t size) -> void {
+		auto vertexBuffer = Find(vertexBuffers, buffer);
+		if (vertexBuffer == nullptr) {
+			std::cerr << "Tried to update an unknown vertex buffer" << std::endl;
+			return;
+		}
+
+		// The old vertices are gone, but the bounds can only grow without them. That stays conservative for culling.
+		Bounds bounds;
+		auto hasBounds = vertexBuffer->Layout() == VertexLayout::Float32 && offset % sizeof(Vertex) == 0 && EncapsulateVertices(bounds, data, size);
+		uploadContext->UpdateBufferRange(vertexBuffer, offset, data, size, hasBounds ? &bounds : nullptr);
+	}
+
+	auto UpdateIndexBuffer(uint32_t buffer, const void* data, size_t size) -> void {
+		auto indexBuffer = Find(indexBuffers, buffer);
+		if (indexBuffer == nullptr) {
+			std::cerr << "Tried to update an unknown index buffer" << std::endl;
+			return;
+		}
+
+		uploadContext->UpdateIndexBuffer(indexBuffer, data, size);
+	}
+
+	auto UpdateIndexBufferRange(uint32_t buffer, size_t offset, const void* data, size_t size) -> void {
+		auto indexBuffer = Find(indexBuffers, buffer);
+		if (indexBuffer == nullptr) {
+			std::cerr << "Tried to update an unknown index buffer" << std::endl;
+			return;
+		}
+
+		uploadContext->UpdateBufferRange(indexBuffer, offset, data, size);
+	}
+
+	auto CreateVertexArray(uint32_t vertexBufferId, uint32_t indexBufferId) -> uint32_t {
+		return OnRenderThread([&]() -> uint32_t {
+			auto vertexBuffer = vertexBuffers.Get(vertexBufferId);
+			auto indexBuffer = indexBuffers.Get(indexBufferId);
+			if (vertexBuffer == nullptr || indexBuffer == nullptr) {
+				std::cerr << "Tried to create a vertex array from an unknown buffer" << std::endl;
+				return SlotMap<std::shared_ptr<VertexArray>>::InvalidHandle;
+			}
+
+			auto vertexArray = device->CreateVertexArray(*vertexBuffer, *indexBuffer);
+
+			std::unique_lock lock { resourceLock };
+			return vertexArrays.Insert(vertexArray);
+		});
+	}
+
+	auto CreateMesh(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount) -> uint32_t {
+		return OnRenderThread([&]() -> uint32_t {
+			auto range = meshBuffer->Allocate(vertices, static_cast<uint32_t>(vertexCount), indices, static_cast<uint32_t>(indexCount));
+			if (range == nullptr) {
+				std::cerr << "Tried to create an empty mesh" << std::endl;
+				return SlotMap<std::shared_ptr<VertexArray>>::InvalidHandle;
+			}
+
+			std::unique_lock lock { resourceLock };
+			return vertexArrays.Insert(range);
+		});
+	}
+
+	// Returns the storage of a mesh buffer range, on the render thread
+	auto FreeMesh(uint32_t meshId) -> bool {
+		auto vertexArray = vertexArrays.Get(meshId);
+		auto range = vertexArray != nullptr ? std::dynamic_pointer_cast<MeshRange>(*vertexArray) : nullptr;
+		if (range == nullptr) {
+			return false;
+		}
 
-		return CreateMaterial(
-			material->shaders[ShaderType::FRAGMENT]->id, 
-			material->shaders[ShaderType::VERTEX]->id,
-			material->isInstanced
+		meshBuffer->Free(*range);
+		std::unique_lock lock { resourceLock };
+		vertexArrays.Remove(meshId);
+
+		return true;
+	}
+
+	auto DestroyMesh(uint32_t meshId) -> void {
+		OnRenderThread([&]() {
+			if (!FreeMesh(meshId)) {
+				std::cerr << "Tried to destroy an unknown mesh" << std::endl;
+			}
+		});
+	}
+
+	auto CreateTilemap(
+		uint32_t width,
+		uint32_t height,
+		glm::vec2 tileSize,
+		uint32_t atlasColumns,
+		uint32_t atlasRows,
+		uint32_t material
+	) -> uint32_t {
+		if (width == 0 || height == 0) {
+			std::cerr << "Tried to create a tilemap without tiles" << std::endl;
+			return SlotMap<Tilemap>::InvalidHandle;
+		}
+
+		auto tilemap = std::make_shared<Tilemap>(
+			width,
+			height,
+			tileSize,
+			atlasColumns,
+			atlasRows,
+			material,
+			SlotMap<std::shared_ptr<VertexArray>>::InvalidHandle
 		);
+
+		std::unique_lock lock { resourceLock };
+		return tilemaps.Insert(std::move(tilemap));
 	}
 
-	auto CreateVertexBuffer(const void* data, size_t size, size_t elemSize) -> uint32_t {
-		auto buffer = device->CreateVertexBuffer(data, size, elemSize);
-		auto id = buffer->Id();
+	auto SetTilemapTiles(uint32_t tilemapId, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint16_t* tiles) -> void {
+		auto tilemap = Find(tilemaps, tilemapId);
+		if (tilemap == nullptr) {
+			std::cerr << "Tried to change the tiles of an unknown tilemap" << std::endl;
+			return;
+		}
 
-		vertexBuffers[id] = buffer;
+		tilemap->SetTiles(x, y, width, height, tiles);
+	}
+
+	// Rebuilds the meshes of the chunks whose tiles changed. The meshes are built here, only placing them waits for the render thread.
+	// Runs between frames on the thread that runs them, never on the workers.
+	auto RebuildTilemapChunks(Tilemap& tilemap) -> void {
+		struct Rebuild {
+			size_t chunk;
+			std::vector<Vertex> vertices;
+			std::vector<uint32_t> indices;
+		};
+
+		auto& chunks = tilemap.Chunks();
+		std::vector<Rebuild> rebuilds;
+		for (size_t x = 0; x < chunks.size(); x++) {
+			if (!chunks[x].dirty) {
+				continue;
+			}
 
-		return id;
+			auto& rebuild = rebuilds.emplace_back();
+			rebuild.chunk = x;
+			tilemap.BuildChunk(x, rebuild.vertices, rebuild.indices);
+			chunks[x].dirty = false;
+		}
+
+		if (rebuilds.empty()) {
+			return;
+		}
+
+		OnRenderThread([&]() {
+			for (auto& rebuild : rebuilds) {
+				auto& chunk = chunks[rebuild.chunk];
+				FreeMesh(chunk.mesh);
+				chunk.mesh = SlotMap<std::shared_ptr<VertexArray>>::InvalidHandle;
+
+				auto range = meshBuffer->Allocate(
+					rebuild.vertices.data(),
+					static_cast<uint32_t>(rebuild.vertices.size()),
+					rebuild.indices.data(),
+					static_cast<uint32_t>(rebuild.indices.size())
+				);
+				if (range != nullptr) {
+					std::unique_lock lock { resourceLock };
+					chunk.mesh = vertexArrays.Insert(range);
+				}
+			}
+		});
 	}
 
-	auto CreateIndexBuffer(const uint32_t* indices, size_t len) -> uint32_t {
-		auto buffer = device->CreateIndexBuffer(indices, len);
-		auto id = buffer->Id();
+	auto DrawTilemap(uint32_t tilemapId, glm::vec3 position, uint16_t layer) -> void {
+		auto tilemap = Find(tilemaps, tilemapId);
+		if (tilemap == nullptr) {
+			return;
+		}
+
+		auto material = Find(materials, tilemap->MaterialId());
+		if (material == nullptr) {
+			return;
+		}
 
-		indexBuffers[id] = buffer;
+		// Dirty chunks keep their old mesh for this frame. The map is queued once, however often it is drawn
+		if (tilemap->HasDirtyChunks() && tilemap->QueueRebuild()) {
+			std::scoped_lock lock { tilemapRebuildLock };
+			tilemapRebuilds.push_back(tilemapId);
+		}
 
-		return id;
+		// Whole chunks are culled here, so chunks out of view never reach the merge and the sort
+		const auto& chunks = tilemap->Chunks();
+		auto model = glm::translate(glm::mat4(1.0f), position);
+		thread_local std::vector<glm::mat4> models;
+		thread_local std::vector<Bounds> bounds;
+		thread_local std::vector<uint8_t> visible;
+		models.assign(chunks.size(), model);
+		bounds.resize(chunks.size());
+		visible.resize(chunks.size());
+		for (size_t x = 0; x < chunks.size(); x++) {
+			bounds[x] = chunks[x].bounds;
+		}
+		CullBounds(frustum, models.data(), bounds.data(), chunks.size(), visible.data());
+
+		auto& buckets = drawBuckets.Local();
+		auto& bucket = material->isInstanced ? buckets.instanced : buckets.indexed;
+		for (size_t x = 0; x < chunks.size(); x++) {
+			if (visible[x] && chunks[x].mesh != SlotMap<std::shared_ptr<VertexArray>>::InvalidHandle) {
+				bucket.Push(model, FullUvRect, chunks[x].mesh, tilemap->MaterialId(), layer);
+			}
+		}
 	}
 
-	auto UpdateVertexBuffer(uint32_t buffer, const void* data, size_t size) -> void {
+	auto DestroyTilemap(uint32_t tilemapId) -> void {
+		auto tilemap = Find(tilemaps, tilemapId);
+		if (tilemap == nullptr) {
+			std::cerr << "Tried to destroy an unknown tilemap" << std::endl;
+			return;
+		}
 
+		{
+			std::unique_lock lock { resourceLock };
+			tilemaps.Remove(tilemapId);
+		}
+		OnRenderThread([&]() {
+			for (auto& chunk : tilemap->Chunks()) {
+				FreeMesh(chunk.mesh);
+			}
+		});
 	}
 
-	auto UpdateIndexBuffer(uint32_t buffer, const void* data, size_t size) -> void {
+	auto LoadAtlas(const uint8_t* data, size_t len) -> uint32_t {
+		SpriteAtlas atlas;
+		if (!SpriteAtlas::Parse(data, len, atlas)) {
+			std::cerr << "Tried to load an invalid sprite atlas" << std::endl;
+			return SlotMap<SpriteAtlas>::InvalidHandle;
+		}
 
+		return atlases.Insert(std::move(atlas));
 	}
 
-	auto CreateVertexArray(uint32_t vertexBufferId, uint32_t indexBufferId) -> uint32_t {
-		auto buffer = device->CreateVertexArray(vertexBuffers[vertexBufferId], indexBuffers[indexBufferId]);
-		auto id = buffer->Id();
+	auto GetAtlasRegion(uint32_t atlasId, const char* name, glm::vec4& uvRect) -> uint32_t {
+		auto atlas = atlases.Get(atlasId);
+		if (atlas == nullptr) {
+			return InvalidAtlasPage;
+		}
+
+		auto region = atlas->regions.find(name);
+		if (region == atlas->regions.end()) {
+			return InvalidAtlasPage;
+		}
 
-		vertexArrays[id] = buffer;
+		uvRect = region->second.uvRect;
 
-		return id;
+		return region->second.page;
 	}
 
 	auto DrawIndexed(glm::mat4 model, uint32_t vao, uint32_t material) -> void {
-		drawCalls.enqueue(DrawCall { model, vao, material });
+		drawBuckets.Local().indexed.Push(model, FullUvRect, vao, material);
 	}
 
-	auto DrawIndexedInstanced(glm::mat4 model, uint32_t vao, uint32_t material) -> void {
-		instancedDrawCalls.enqueue(DrawCall { model, vao, material });
+	auto DrawIndexedInstanced(glm::mat4 model, glm::vec4 uvRect, uint32_t vao, uint32_t material) -> void {
+		drawBuckets.Local().instanced.Push(model, uvRect, vao, material);
 	}
 
-	auto DrawSprite(glm::mat4 model, uint32_t material) -> void {
+	auto DrawSprite(glm::mat4 model, uint32_t material, glm::vec4 uvRect, uint16_t layer) -> void {
+		auto spriteMaterial = Find(materials, material);
+		if (spriteMaterial == nullptr) {
+			return;
+		}
+
 		// Check if the material is instanced
-		if (materials[material]->isInstanced) {
-			DrawIndexedInstanced(model, spriteVao, material);
+		if (spriteMaterial->isInstanced) {
+			drawBuckets.Local().instanced.Push(model, uvRect, spriteVao, material, layer);
 			return;
 		}
-		DrawIndexed(model, spriteVao, material);
+		drawBuckets.Local().indexed.Push(model, uvRect, spriteVao, material, layer);
+	}
+
+	auto DrawSprites(
+		size_t count,
+		const float* positions,
+		const float* rotations,
+		const float* scales,
+		const uint32_t* materialIds,
+		const float* uvRects
+	) -> void {
+		// Per submitting thread, so tables drawn in parallel do not share it and warm frames do not allocate
+		thread_local std::vector<glm::mat4> models;
+		models.resize(count);
+		BuildSpriteTransforms(count, positions, rotations, scales, models.data());
+
+		// Materials are resolved once per run of equal ids, not once per sprite
+		auto& buckets = drawBuckets.Local();
+		DrawBucket* bucket = nullptr;
+		uint32_t lastMaterialId = 0;
+		bool resolved = false;
+		for (size_t x = 0; x < count; x++) {
+			if (!resolved || materialIds[x] != lastMaterialId) {
+				auto material = Find(materials, materialIds[x]);
+				bucket = material == nullptr ? nullptr : material->isInstanced ? &buckets.instanced : &buckets.indexed;
+				lastMaterialId = materialIds[x];
+				resolved = true;
+			}
+
+			if (bucket != nullptr) {
+				auto uvRect = uvRects == nullptr ? FullUvRect : glm::make_vec4(uvRects + x * 4);
+				bucket->Push(models[x], uvRect, spriteVao, lastMaterialId);
+			}
+		}
+	}
+
+	auto DrawBatchedSprite(
+		glm::vec2 position,
+		float rotation,
+		glm::vec2 scale,
+		glm::vec4 uvRect,
+		uint32_t color,
+		uint16_t layer,
+		uint32_t material
+	) -> void {
+		drawBuckets.Local().sprites.Push(SpriteInstance::Pack(position, rotation, scale, uvRect, color, layer), material);
 	}
 
 	auto SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) -> void {
-		// Recalculate the aspect ratio and adjust the viewport accordingly
+		// Recalculate the aspect ratio and adjust the viewport accordingly, it applies from the next packet on
 		
 		if (float aspectRatio = (float)width / (float)height; aspectRatio > 16.0f / 9.0f) {
 			// If the window is wider than 16:9, adjust the width
 			float newWidth = height * (16.0f / 9.0f);
 			float xOffset = (width - newWidth) / 2;
-			graphicsContext->SetViewport((uint32_t)xOffset, 0, (uint32_t)newWidth, height, 0.0, 1.0);
+			frameViewport = { (uint32_t)xOffset, 0, (uint32_t)newWidth, height };
 		}
 		else {
 			// If the window is taller than 16:9, adjust the height
 			float newHeight = width / (16.0f / 9.0f);
 			float yOffset = (height - newHeight) / 2;
-			graphicsContext->SetViewport(0, (uint32_t)yOffset, width, (uint32_t)newHeight, 0.0, 1.0);
+			frameViewport = { 0, (uint32_t)yOffset, width, (uint32_t)newHeight };
 		}
 	}
 
 	auto SetMaterialTexture(uint32_t materialId, uint32_t textureId, const char* name) -> void {
-		auto material = materials[materialId];
-		auto texture = textures[textureId];
+		// Materials are read while the render thread draws, so they are only changed between its frames
+		PostToRenderThread([materialId, textureId, name = std::string(name)]() {
+			auto material = materials.Get(materialId);
+			auto texture = textures.Get(textureId);
+			if (material == nullptr || texture == nullptr) {
+				std::cerr << "Tried to set an unknown texture or material" << std::endl;
+				return;
+			}
+
+			(*material)->textures[name] = *texture;
+		});
+	}
+
+	auto SetMaterialOpaque(uint32_t materialId, bool opaque) -> void {
+		// Read by the sort on this thread, so it is not deferred to the render thread
+		auto material = Find(materials, materialId);
+		if (material == nullptr) {
+			std::cerr << "Tried to change the blending of an unknown material" << std::endl;
+			return;
+		}
+
+		material->isOpaque = opaque;
+	}
+
+	auto IsMaterialReady(uint32_t materialId) -> bool {
+		// Reads what the render thread found the last time it asked the driver, without waiting for it
+		auto material = Find(materials, materialId);
+		if (material == nullptr) {
+			std::cerr << "Tried to query an unknown material" << std::endl;
+			return false;
+		}
+
+		return material->WasReady();
+	}
+
+	auto SetMaterialFloat(uint32_t materialId, const char* name, float value) -> void {
+		PostToRenderThread([materialId, name = std::string(name), value]() {
+			auto material = materials.Get(materialId);
+			if (material == nullptr) {
+				std::cerr << "Tried to set a parameter of an unknown material" << std::endl;
+				return;
+			}
+
+			(*material)->SetFloat(name, value);
+		});
+	}
+
+	auto SetMaterialInt(uint32_t materialId, const char* name, uint32_t value) -> void {
+		PostToRenderThread([materialId, name = std::string(name), value]() {
+			auto material = materials.Get(materialId);
+			if (material == nullptr) {
+				std::cerr << "Tried to set a parameter of an unknown material" << std::endl;
+				return;
+			}
+
+			(*material)->SetInt(name, value);
+		});
+	}
+
+	auto SetMaterialVector(uint32_t materialId, const char* name, const float* values, size_t count) -> void {
+		std::array<float, 4> components = {};
+		std::copy_n(values, std::min<size_t>(count, components.size()), components.begin());
+
+		PostToRenderThread([materialId, name = std::string(name), components, count]() {
+			auto material = materials.Get(materialId);
+			if (material == nullptr) {
+				std::cerr << "Tried to set a parameter of an unknown material" << std::endl;
+				return;
+			}
+
+			switch (count) {
+			case 2:
+				(*material)->SetVec2(name, { components[0], components[1] });
+				break;
+			case 3:
+				(*material)->SetVec3(name, { components[0], components[1], components[2] });
+				break;
+			case 4:
+				(*material)->SetVec4(name, { components[0], components[1], components[2], components[3] });
+				break;
+			default:
+				std::cerr << "Material vectors need 2, 3 or 4 components" << std::endl;
+				break;
+			}
+		});
+	}
+
+	auto CaptureFrame(std::string_view path) -> void {
+		PostToRenderThread([path = std::filesystem::path(path)]() {
+			swapchain->RequestCapture(path);
+		});
+	}
+
+	auto GetFrameStats() -> FrameStats {
+		std::scoped_lock lock { statsLock };
+		return lastFrameStats;
+	}
+
+	auto GetFrameTimings() -> FrameTimings {
+		std::scoped_lock lock { statsLock };
+		return lastFrameTimings;
+	}
 
-		material->textures[name] = texture;
+	auto SetTimingOverlay(bool visible) -> void {
+		timingOverlay = visible;
 	}
 }
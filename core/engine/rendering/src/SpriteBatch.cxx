@@ -0,0 +1,85 @@
+#include "rendering/SpriteBatch.hxx"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace kyanite::engine::rendering {
+	namespace {
+		// Only the side planes, batched sprites are flat and placed in depth by the shader
+		constexpr int SidePlanes = 4;
+
+		inline auto IsVisible(const Frustum& frustum, const SpriteInstance& sprite) -> bool {
+			auto scale = glm::unpackHalf2x16(sprite.scale);
+			auto radius = 0.5f * std::sqrt(scale.x * scale.x + scale.y * scale.y);
+
+			for (int plane = 0; plane < SidePlanes; plane++) {
+				auto distance = frustum.x[plane] * sprite.position.x + frustum.y[plane] * sprite.position.y + frustum.w[plane];
+				if (distance < -radius) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	auto SpriteInstance::Pack(
+		glm::vec2 position,
+		float rotation,
+		glm::vec2 scale,
+		glm::vec4 uvRect,
+		uint32_t color,
+		uint16_t layer
+	) -> SpriteInstance {
+		SpriteInstance sprite;
+		sprite.position = position;
+		sprite.rotation = rotation;
+		sprite.scale = glm::packHalf2x16(scale);
+		for (int x = 0; x < 4; x++) {
+			sprite.uvRect[x] = static_cast<uint16_t>(std::lround(std::clamp(uvRect[x], 0.0f, 1.0f) * 65535.0f));
+		}
+		sprite.color = color;
+		sprite.layer = layer;
+		sprite.padding = 0;
+
+		return sprite;
+	}
+
+	auto BatchSprites(
+		const Frustum& frustum,
+		const std::vector<SpriteInstance>& sprites,
+		const std::vector<uint32_t>& materials,
+		std::vector<SpriteInstance>& instances,
+		std::vector<SpriteBatch>& batches
+	) -> void {
+		// Sorting keys and indices is cheaper than moving 36 bytes per sprite around
+		struct Key {
+			uint64_t key;
+			uint32_t index;
+		};
+
+		std::vector<Key> keys;
+		keys.reserve(sprites.size());
+		for (size_t x = 0; x < sprites.size(); x++) {
+			if (IsVisible(frustum, sprites[x])) {
+				keys.push_back({ static_cast<uint64_t>(sprites[x].layer) << 32 | materials[x], static_cast<uint32_t>(x) });
+			}
+		}
+
+		std::ranges::stable_sort(keys, [](const Key& a, const Key& b) { return a.key < b.key; });
+
+		instances.reserve(instances.size() + keys.size());
+		for (auto& key : keys) {
+			auto& sprite = sprites[key.index];
+			auto material = materials[key.index];
+			if (batches.empty() || batches.back().layer != sprite.layer || batches.back().material != material) {
+				batches.push_back({ material, sprite.layer, static_cast<uint32_t>(instances.size()), 0 });
+			}
+
+			instances.push_back(sprite);
+			batches.back().instanceCount++;
+		}
+	}
+}
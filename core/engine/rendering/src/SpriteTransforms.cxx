@@ -0,0 +1,229 @@
+#include "rendering/SpriteTransforms.hxx"
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define KYANITE_TRANSFORMS_AVX2
+// The kernel is compiled for AVX2 on its own and only run when the CPU reports it, the rest of the library stays baseline
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define KYANITE_TARGET_AVX2
+#else
+#define KYANITE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define KYANITE_TRANSFORMS_NEON
+#endif
+
+namespace kyanite::engine::rendering {
+	namespace {
+		// Cody-Waite split of pi / 2, so the reduced angle keeps its precision for angles of a few thousand turns
+		constexpr float TwoOverPi = 0.636619772367581343f;
+		constexpr float HalfPi1 = 1.5703125f;
+		constexpr float HalfPi2 = 4.837512969970703125e-4f;
+		constexpr float HalfPi3 = 7.54978995489188216e-8f;
+
+		// Minimax polynomials of sine and cosine on [-pi / 4, pi / 4]
+		constexpr float Sin1 = -1.6666654611e-1f;
+		constexpr float Sin2 = 8.3321608736e-3f;
+		constexpr float Sin3 = -1.9515295891e-4f;
+		constexpr float Cos1 = 4.166664568298827e-2f;
+		constexpr float Cos2 = -1.388731625493765e-3f;
+		constexpr float Cos3 = 2.443315711809948e-5f;
+
+		// The same columns scripts fill in for DrawSprite
+		inline auto WriteModel(glm::mat4& model, float a, float b, float d, float e, const float* position, const float* scale) -> void {
+			model[0] = glm::vec4(a, b, 0.0f, 0.0f);
+			model[1] = glm::vec4(d, e, 0.0f, 0.0f);
+			model[2] = glm::vec4(0.0f, 0.0f, scale[2], 0.0f);
+			model[3] = glm::vec4(position[0], position[1], position[2], 1.0f);
+		}
+
+		inline auto BuildScalar(size_t first, size_t count, const float* positions, const float* rotations, const float* scales, glm::mat4* models) -> void {
+			for (size_t x = first; x < count; x++) {
+				auto sine = std::sin(rotations[x]);
+				auto cosine = std::cos(rotations[x]);
+				auto scale = scales + x * 3;
+
+				WriteModel(models[x], scale[0] * cosine, -scale[1] * sine, scale[0] * sine, scale[1] * cosine, positions + x * 3, scale);
+			}
+		}
+
+#if defined(KYANITE_TRANSFORMS_AVX2)
+		constexpr size_t Lanes = 8;
+
+		auto HasAvx2() -> bool {
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) {
+				return false;
+			}
+
+			// FMA, and an OS that saves the YMM registers
+			__cpuid(info, 1);
+			if ((info[2] & (1 << 12)) == 0 || (info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6) {
+				return false;
+			}
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+		}
+
+		KYANITE_TARGET_AVX2 inline auto SinCos(__m256 angle, __m256& sine, __m256& cosine) -> void {
+			auto quadrant = _mm256_round_ps(_mm256_mul_ps(angle, _mm256_set1_ps(TwoOverPi)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			auto index = _mm256_cvtps_epi32(quadrant);
+
+			auto y = _mm256_fnmadd_ps(quadrant, _mm256_set1_ps(HalfPi1), angle);
+			y = _mm256_fnmadd_ps(quadrant, _mm256_set1_ps(HalfPi2), y);
+			y = _mm256_fnmadd_ps(quadrant, _mm256_set1_ps(HalfPi3), y);
+			auto z = _mm256_mul_ps(y, y);
+
+			auto s = _mm256_fmadd_ps(z, _mm256_set1_ps(Sin3), _mm256_set1_ps(Sin2));
+			s = _mm256_fmadd_ps(z, s, _mm256_set1_ps(Sin1));
+			s = _mm256_fmadd_ps(_mm256_mul_ps(z, y), s, y);
+
+			auto c = _mm256_fmadd_ps(z, _mm256_set1_ps(Cos3), _mm256_set1_ps(Cos2));
+			c = _mm256_fmadd_ps(z, c, _mm256_set1_ps(Cos1));
+			c = _mm256_fmadd_ps(_mm256_mul_ps(z, z), c, _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), _mm256_set1_ps(1.0f)));
+
+			// Odd quadrants swap sine and cosine, the quadrant then decides the signs
+			auto one = _mm256_set1_epi32(1);
+			auto two = _mm256_set1_epi32(2);
+			auto swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(index, one), one));
+			auto sineSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(index, two), 30));
+			auto cosineSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(index, one), two), 30));
+
+			sine = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sineSign);
+			cosine = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosineSign);
+		}
+
+		KYANITE_TARGET_AVX2 auto BuildVector(size_t count, const float* positions, const float* rotations, const float* scales, glm::mat4* models) -> size_t {
+			const auto stride = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+			alignas(32) float a[Lanes];
+			alignas(32) float b[Lanes];
+			alignas(32) float d[Lanes];
+			alignas(32) float e[Lanes];
+
+			size_t x = 0;
+			for (; x + Lanes <= count; x += Lanes) {
+				__m256 sine;
+				__m256 cosine;
+				SinCos(_mm256_loadu_ps(rotations + x), sine, cosine);
+
+				auto scaleX = _mm256_i32gather_ps(scales + x * 3, stride, 4);
+				auto scaleY = _mm256_i32gather_ps(scales + x * 3 + 1, stride, 4);
+				_mm256_store_ps(a, _mm256_mul_ps(scaleX, cosine));
+				_mm256_store_ps(b, _mm256_xor_ps(_mm256_mul_ps(scaleY, sine), _mm256_set1_ps(-0.0f)));
+				_mm256_store_ps(d, _mm256_mul_ps(scaleX, sine));
+				_mm256_store_ps(e, _mm256_mul_ps(scaleY, cosine));
+
+				for (size_t lane = 0; lane < Lanes; lane++) {
+					auto sprite = x + lane;
+					WriteModel(models[sprite], a[lane], b[lane], d[lane], e[lane], positions + sprite * 3, scales + sprite * 3);
+				}
+			}
+
+			return x;
+		}
+
+		const bool vectorSupported = HasAvx2();
+#elif defined(KYANITE_TRANSFORMS_NEON)
+		constexpr size_t Lanes = 4;
+
+		inline auto FlipSign(float32x4_t value, int32x4_t sign) -> float32x4_t {
+			return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(value), vreinterpretq_u32_s32(vshlq_n_s32(sign, 30))));
+		}
+
+		inline auto SinCos(float32x4_t angle, float32x4_t& sine, float32x4_t& cosine) -> void {
+			auto quadrant = vrndnq_f32(vmulq_n_f32(angle, TwoOverPi));
+			auto index = vcvtq_s32_f32(quadrant);
+
+			auto y = vfmsq_f32(angle, quadrant, vdupq_n_f32(HalfPi1));
+			y = vfmsq_f32(y, quadrant, vdupq_n_f32(HalfPi2));
+			y = vfmsq_f32(y, quadrant, vdupq_n_f32(HalfPi3));
+			auto z = vmulq_f32(y, y);
+
+			auto s = vfmaq_f32(vdupq_n_f32(Sin2), z, vdupq_n_f32(Sin3));
+			s = vfmaq_f32(vdupq_n_f32(Sin1), z, s);
+			s = vfmaq_f32(y, vmulq_f32(z, y), s);
+
+			auto c = vfmaq_f32(vdupq_n_f32(Cos2), z, vdupq_n_f32(Cos3));
+			c = vfmaq_f32(vdupq_n_f32(Cos1), z, c);
+			c = vfmaq_f32(vfmsq_f32(vdupq_n_f32(1.0f), z, vdupq_n_f32(0.5f)), vmulq_f32(z, z), c);
+
+			// Odd quadrants swap sine and cosine, the quadrant then decides the signs
+			auto one = vdupq_n_s32(1);
+			auto two = vdupq_n_s32(2);
+			auto swap = vtstq_s32(index, one);
+
+			sine = FlipSign(vbslq_f32(swap, c, s), vandq_s32(index, two));
+			cosine = FlipSign(vbslq_f32(swap, s, c), vandq_s32(vaddq_s32(index, one), two));
+		}
+
+		auto BuildVector(size_t count, const float* positions, const float* rotations, const float* scales, glm::mat4* models) -> size_t {
+			alignas(16) float a[Lanes];
+			alignas(16) float b[Lanes];
+			alignas(16) float d[Lanes];
+			alignas(16) float e[Lanes];
+
+			size_t x = 0;
+			for (; x + Lanes <= count; x += Lanes) {
+				float32x4_t sine;
+				float32x4_t cosine;
+				SinCos(vld1q_f32(rotations + x), sine, cosine);
+
+				// Splits x, y and z of four sprites into one register each
+				auto scale = vld3q_f32(scales + x * 3);
+				vst1q_f32(a, vmulq_f32(scale.val[0], cosine));
+				vst1q_f32(b, vnegq_f32(vmulq_f32(scale.val[1], sine)));
+				vst1q_f32(d, vmulq_f32(scale.val[0], sine));
+				vst1q_f32(e, vmulq_f32(scale.val[1], cosine));
+
+				for (size_t lane = 0; lane < Lanes; lane++) {
+					auto sprite = x + lane;
+					WriteModel(models[sprite], a[lane], b[lane], d[lane], e[lane], positions + sprite * 3, scales + sprite * 3);
+				}
+			}
+
+			return x;
+		}
+
+		const bool vectorSupported = true;
+#endif
+	}
+
+	auto BuildSpriteTransforms(
+		size_t count,
+		const float* positions,
+		const float* rotations,
+		const float* scales,
+		glm::mat4* models
+	) -> void {
+		size_t done = 0;
+#if defined(KYANITE_TRANSFORMS_AVX2) || defined(KYANITE_TRANSFORMS_NEON)
+		if (vectorSupported) {
+			done = BuildVector(count, positions, rotations, scales, models);
+		}
+#endif
+
+		// Whatever does not fill a whole register
+		BuildScalar(done, count, positions, rotations, scales, models);
+	}
+
+	auto BuildSpriteTransformsScalar(
+		size_t count,
+		const float* positions,
+		const float* rotations,
+		const float* scales,
+		glm::mat4* models
+	) -> void {
+		BuildScalar(0, count, positions, rotations, scales, models);
+	}
+}
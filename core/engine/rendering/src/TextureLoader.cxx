@@ -0,0 +1,93 @@
+#include "rendering/TextureLoader.hxx"
+
+#include <shared/TextureFormat.hxx>
+
+#include <FreeImage.h>
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+	auto IsCompressed(const uint8_t* data, size_t len) -> bool {
+		uint32_t magic = 0;
+		if (len >= sizeof(magic)) {
+			std::memcpy(&magic, data, sizeof(magic));
+		}
+		return magic == kyanite::engine::shared::TextureMagic;
+	}
+}
+
+namespace kyanite::engine::rendering {
+	auto TextureLoader::Load(const std::shared_ptr<Texture>& texture, const uint8_t* data, size_t len) -> void {
+		if (IsCompressed(data, len)) {
+			auto copy = std::make_shared<std::vector<uint8_t>>(data, data + len);
+			LoadCompressed(texture, std::shared_ptr<const uint8_t>(copy, copy->data()), len);
+			return;
+		}
+
+		auto encoded = std::make_shared<std::vector<uint8_t>>(data, data + len);
+
+		_pool.Submit([this, texture, encoded]() {
+			FIMEMORY* memory = FreeImage_OpenMemory(encoded->data(), static_cast<DWORD>(encoded->size()));
+
+			auto format = FreeImage_GetFileTypeFromMemory(memory, 0);
+			if (format == FIF_UNKNOWN || !FreeImage_FIFSupportsReading(format)) {
+				std::cerr << "Failed to load texture: Unknown image format" << std::endl;
+				FreeImage_CloseMemory(memory);
+				return;
+			}
+
+			auto bitmap = FreeImage_LoadFromMemory(format, memory);
+			FreeImage_CloseMemory(memory);
+			if (bitmap == nullptr) {
+				std::cerr << "Failed to load texture: Could not decode image" << std::endl;
+				return;
+			}
+
+			// Everything is uploaded as 32 bit BGRA, whatever the source format was
+			auto converted = FreeImage_ConvertTo32Bits(bitmap);
+			FreeImage_Unload(bitmap);
+			if (converted == nullptr) {
+				std::cerr << "Failed to load texture: Could not convert image" << std::endl;
+				return;
+			}
+
+			uint32_t width = FreeImage_GetWidth(converted);
+			uint32_t height = FreeImage_GetHeight(converted);
+			uint32_t pitch = FreeImage_GetPitch(converted);
+			uint32_t rowSize = width * 4;
+
+			auto pixels = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(rowSize) * height);
+			for (uint32_t row = 0; row < height; row++) {
+				std::memcpy(pixels->data() + row * rowSize, FreeImage_GetScanLine(converted, row), rowSize);
+			}
+			FreeImage_Unload(converted);
+
+			_uploadContext.UploadTexture(texture, width, height, pixels);
+		});
+	}
+
+	auto TextureLoader::Load(const std::shared_ptr<Texture>& texture, std::shared_ptr<io::MappedFile> file) -> void {
+		if (!IsCompressed(file->Data(), file->Size())) {
+			Load(texture, file->Data(), file->Size());
+			return;
+		}
+
+		// Alias the mapping so it is only closed once the blocks have been handed to the driver
+		auto data = std::shared_ptr<const uint8_t>(file, file->Data());
+		LoadCompressed(texture, std::move(data), file->Size());
+	}
+
+	auto TextureLoader::LoadCompressed(const std::shared_ptr<Texture>& texture, std::shared_ptr<const uint8_t> data, size_t len) -> void {
+		// Only the level table is read here, the blocks themselves are never touched on the CPU
+		shared::TextureHeader header;
+		std::vector<shared::TextureLevel> levels;
+		if (!shared::ReadTextureHeader(data.get(), len, header, levels)) {
+			std::cerr << "Failed to load texture: Invalid compressed texture" << std::endl;
+			return;
+		}
+
+		_uploadContext.UploadCompressedTexture(texture, header.format, std::move(levels), std::move(data));
+	}
+}
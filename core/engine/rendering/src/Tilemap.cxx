@@ -0,0 +1,97 @@
+#include "rendering/Tilemap.hxx"
+
+#include <algorithm>
+
+namespace kyanite::engine::rendering {
+	Tilemap::Tilemap(
+		uint32_t width,
+		uint32_t height,
+		glm::vec2 tileSize,
+		uint32_t atlasColumns,
+		uint32_t atlasRows,
+		uint32_t material,
+		uint32_t invalidMesh
+	) :
+		_width(width),
+		_height(height),
+		_tileSize(tileSize),
+		_atlasColumns(std::max(atlasColumns, 1u)),
+		_atlasRows(std::max(atlasRows, 1u)),
+		_material(material),
+		_chunkColumns((width + ChunkSize - 1) / ChunkSize),
+		_tiles(static_cast<size_t>(width) * height, EmptyTile) {
+		auto chunkRows = (height + ChunkSize - 1) / ChunkSize;
+		// Chunks hold atomics, so they are created in place and never moved
+		_chunks = std::vector<Chunk>(static_cast<size_t>(_chunkColumns) * chunkRows);
+
+		for (uint32_t row = 0; row < chunkRows; row++) {
+			for (uint32_t column = 0; column < _chunkColumns; column++) {
+				auto& chunk = _chunks[row * _chunkColumns + column];
+				chunk.mesh = invalidMesh;
+
+				// Chunks at the far edges of the map are cut to its size
+				auto endX = std::min((column + 1) * ChunkSize, width);
+				auto endY = std::min((row + 1) * ChunkSize, height);
+				chunk.bounds.Encapsulate(glm::vec3(glm::vec2(column * ChunkSize, row * ChunkSize) * tileSize, 0.0f));
+				chunk.bounds.Encapsulate(glm::vec3(glm::vec2(endX, endY) * tileSize, 0.0f));
+			}
+		}
+	}
+
+	auto Tilemap::SetTiles(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint16_t* tiles) -> void {
+		auto endX = std::min(static_cast<uint64_t>(x) + width, static_cast<uint64_t>(_width));
+		auto endY = std::min(static_cast<uint64_t>(y) + height, static_cast<uint64_t>(_height));
+
+		for (uint64_t row = y; row < endY; row++) {
+			for (uint64_t column = x; column < endX; column++) {
+				auto tile = tiles[(row - y) * width + (column - x)];
+				auto& current = _tiles[row * _width + column];
+				if (current == tile) {
+					continue;
+				}
+
+				current = tile;
+				_chunks[(row / ChunkSize) * _chunkColumns + column / ChunkSize].dirty = true;
+			}
+		}
+	}
+
+	auto Tilemap::HasDirtyChunks() const -> bool {
+		return std::ranges::any_of(_chunks, [](const Chunk& chunk) { return chunk.dirty.load(); });
+	}
+
+	auto Tilemap::BuildChunk(size_t chunk, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const -> void {
+		vertices.clear();
+		indices.clear();
+
+		auto firstX = static_cast<uint32_t>(chunk % _chunkColumns) * ChunkSize;
+		auto firstY = static_cast<uint32_t>(chunk / _chunkColumns) * ChunkSize;
+		auto endX = std::min(firstX + ChunkSize, _width);
+		auto endY = std::min(firstY + ChunkSize, _height);
+		auto cellSize = glm::vec2(1.0f / _atlasColumns, 1.0f / _atlasRows);
+
+		for (auto row = firstY; row < endY; row++) {
+			for (auto column = firstX; column < endX; column++) {
+				auto tile = _tiles[static_cast<size_t>(row) * _width + column];
+				if (tile == EmptyTile) {
+					continue;
+				}
+
+				// Tiles past the last cell of the atlas wrap around to its start
+				auto cell = static_cast<uint32_t>(tile - 1) % (_atlasColumns * _atlasRows);
+				auto uvMin = glm::vec2(cell % _atlasColumns, cell / _atlasColumns) * cellSize;
+				auto uvMax = uvMin + cellSize;
+				auto min = glm::vec2(column, row) * _tileSize;
+				auto max = min + _tileSize;
+
+				// The same winding as the sprite quad
+				auto base = static_cast<uint32_t>(vertices.size());
+				vertices.push_back({ glm::vec3(min.x, min.y, 0.0f), glm::vec2(uvMin.x, uvMin.y) });
+				vertices.push_back({ glm::vec3(max.x, min.y, 0.0f), glm::vec2(uvMax.x, uvMin.y) });
+				vertices.push_back({ glm::vec3(max.x, max.y, 0.0f), glm::vec2(uvMax.x, uvMax.y) });
+				vertices.push_back({ glm::vec3(min.x, max.y, 0.0f), glm::vec2(uvMin.x, uvMax.y) });
+				indices.insert(indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+			}
+		}
+	}
+}
@@ -1,16 +1,15 @@
 #include "rendering/UploadContext.hxx"
 
-#include <glad/glad.h>
+#include <cstring>
 
 namespace kyanite::engine::rendering {
 	auto UploadContext::UpdateVertexBuffer(
 		const std::shared_ptr<VertexBuffer>& buffer,
 		const void* data,
-		size_t size
+		size_t size,
+		const Bounds* bounds
 	) -> void {
-		// TODO: Move this to the commandlist
-		buffer->Bind();
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		Stage(buffer, 0, data, size, true, bounds);
 	}
 
 	auto UploadContext::UpdateIndexBuffer(
@@ -18,16 +17,108 @@ namespace kyanite::engine::rendering {
 		const void* data,
 		size_t size
 	) -> void {
-		// TODO: Move this to the commandlist
-		buffer->Bind();
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data);
+		Stage(buffer, 0, data, size, true, nullptr);
 	}
 
-	auto UploadContext::Begin() -> void {
+	auto UploadContext::UpdateBufferRange(
+		const std::shared_ptr<Buffer>& buffer,
+		size_t offset,
+		const void* data,
+		size_t size,
+		const Bounds* bounds
+	) -> void {
+		Stage(buffer, offset, data, size, false, bounds);
+	}
+
+	auto UploadContext::Stage(const std::shared_ptr<Buffer>& buffer, size_t offset, const void* data, size_t size, bool replace, const Bounds* bounds) -> void {
+		if (buffer == nullptr || data == nullptr || size == 0) {
+			return;
+		}
+
+		std::scoped_lock lock { _stagingLock };
+
+		// Four byte aligned, so index and float data can be copied without splitting a value
+		auto& staging = *_staged.data;
+		auto sourceOffset = (staging.size() + 3) & ~static_cast<size_t>(3);
+		staging.resize(sourceOffset + size);
+		std::memcpy(staging.data() + sourceOffset, data, size);
+
+		_staged.copies.push_back(BufferCopy { buffer, sourceOffset, offset, size, replace });
+
+		// Under the same lock, so the bounds always land in the frame of their vertices
+		if (auto vertexBuffer = std::dynamic_pointer_cast<VertexBuffer>(buffer); vertexBuffer != nullptr && bounds != nullptr) {
+			_staged.bounds.push_back(BoundsUpdate { vertexBuffer, *bounds, replace });
+		}
+	}
+
+	auto UploadContext::UploadTexture(
+		const std::shared_ptr<Texture>& texture,
+		uint32_t width,
+		uint32_t height,
+		std::shared_ptr<std::vector<uint8_t>> pixels
+	) -> void {
+		_pendingTextures.enqueue(TextureUpload { texture, width, height, std::move(pixels) });
+	}
 
+	auto UploadContext::UploadCompressedTexture(
+		const std::shared_ptr<Texture>& texture,
+		shared::TextureFormat format,
+		std::vector<shared::TextureLevel> levels,
+		std::shared_ptr<const uint8_t> data
+	) -> void {
+		size_t size = 0;
+		for (const auto& level : levels) {
+			size += level.size;
+		}
+		_pendingCompressedTextures.enqueue(CompressedTextureUpload { texture, format, std::move(levels), std::move(data), size });
+	}
+
+	auto UploadContext::TakeStagedBuffers() -> StagedBuffers {
+		std::scoped_lock lock { _stagingLock };
+
+		// The next block starts at the size of this one, so steady updates do not grow it again every frame
+		auto reserve = _staged.data->size();
+		auto staged = std::move(_staged);
+		_staged = { std::make_shared<std::vector<uint8_t>>() };
+		_staged.data->reserve(reserve);
+
+		return staged;
+	}
+
+	auto UploadContext::UploadStagedBuffers(StagedBuffers staged) -> void {
+		if (staged.copies.empty()) {
+			return;
+		}
+
+		for (const auto& copy : staged.copies) {
+			// Index counts are read while recording, so they change on this thread together with the contents
+			if (auto indexBuffer = std::dynamic_pointer_cast<IndexBuffer>(copy.buffer); indexBuffer != nullptr && copy.replace) {
+				indexBuffer->Resize(copy.size / sizeof(uint32_t));
+			}
+		}
+		_commandList->UpdateBuffers(std::move(staged.data), std::move(staged.copies));
+	}
+
+	auto UploadContext::Begin() -> void {
+		_commandList->Reset(_commandAllocator);
 	}
 
 	auto UploadContext::Finish() -> void {
+		// Drain pending textures until the frame budget is used up
+		size_t spent = 0;
+		CompressedTextureUpload compressed;
+		while (spent < _budget && _pendingCompressedTextures.try_dequeue(compressed)) {
+			spent += compressed.size;
+			_commandList->UploadCompressedTexture(compressed.texture, compressed.format, std::move(compressed.levels), compressed.data);
+		}
+
+		TextureUpload upload;
+		while (spent < _budget && _pendingTextures.try_dequeue(upload)) {
+			spent += upload.pixels->size();
+			_commandList->UploadTexture(upload.texture, upload.width, upload.height, upload.pixels);
+		}
 
+		_commandQueue->Execute({ _commandList });
+		_commandList->Reset(_commandAllocator);
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,105 @@
+#include "rendering/WorkerPool.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace kyanite::engine::rendering {
+	WorkerPool::WorkerPool(uint32_t threads) {
+		if (threads == 0) {
+			threads = std::max(1u, std::thread::hardware_concurrency() - 1);
+		}
+
+		for (uint32_t x = 0; x < threads; x++) {
+			_threads.emplace_back([this]() { Run(); });
+		}
+	}
+
+	WorkerPool::~WorkerPool() {
+		{
+			std::scoped_lock lock { _lock };
+			_stopping = true;
+		}
+		_signal.notify_all();
+
+		for (auto& thread : _threads) {
+			thread.join();
+		}
+	}
+
+	auto WorkerPool::Submit(std::function<void()> job) -> void {
+		{
+			std::scoped_lock lock { _lock };
+			_jobs.push_back(std::move(job));
+		}
+		_signal.notify_one();
+	}
+
+	auto WorkerPool::Dispatch(
+		size_t count,
+		size_t batchSize,
+		const std::function<void(size_t, size_t)>& job
+	) -> void {
+		if (count == 0) {
+			return;
+		}
+
+		batchSize = std::max<size_t>(1, batchSize);
+		const size_t batches = (count + batchSize - 1) / batchSize;
+
+		// Not worth waking the workers for a single batch
+		if (batches == 1) {
+			job(0, count);
+			return;
+		}
+
+		// Batches are claimed through a shared counter, so the helpers and the caller balance themselves.
+		// Helpers may start after all batches are gone (e.g. behind a long job), so they own the shared state.
+		struct State {
+			std::function<void(size_t, size_t)> job;
+			std::atomic<size_t> nextBatch = 0;
+			std::atomic<size_t> finishedBatches = 0;
+		};
+		auto state = std::make_shared<State>();
+		state->job = job;
+
+		auto work = [state, count, batchSize, batches]() {
+			for (size_t batch = state->nextBatch++; batch < batches; batch = state->nextBatch++) {
+				auto begin = batch * batchSize;
+				state->job(begin, std::min(count, begin + batchSize));
+				if (++state->finishedBatches == batches) {
+					state->finishedBatches.notify_all();
+				}
+			}
+		};
+
+		const auto helpers = std::min(batches - 1, _threads.size());
+		for (size_t x = 0; x < helpers; x++) {
+			Submit(work);
+		}
+
+		work();
+
+		// Only wait for batches that are in flight on other threads
+		for (auto finished = state->finishedBatches.load(); finished < batches; finished = state->finishedBatches.load()) {
+			state->finishedBatches.wait(finished);
+		}
+	}
+
+	auto WorkerPool::Run() -> void {
+		while (true) {
+			std::function<void()> job;
+			{
+				std::unique_lock lock { _lock };
+				_signal.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+				if (_stopping && _jobs.empty()) {
+					return;
+				}
+				job = std::move(_jobs.front());
+				_jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+}
@@ -0,0 +1,149 @@
+#include "rendering/null/NullCommandList.hxx"
+
+#include <bit>
+
+namespace kyanite::engine::rendering::null {
+	auto NullCommandList::ClearRenderTarget(glm::vec4 color) -> void {
+		Record(NullCommandType::Clear);
+	}
+
+	auto NullCommandList::BindRenderTarget(std::shared_ptr<RenderTarget> target) -> void {
+		// The backbuffer binds as 0, like the default framebuffer of GL
+		Record(NullCommandType::BindRenderTarget, target != nullptr ? target->Address() : 0);
+	}
+
+	auto NullCommandList::TransitionRenderTarget(
+		std::shared_ptr<RenderTarget> target,
+		ResourceState before,
+		ResourceState after
+	) -> void {
+		Record(NullCommandType::TransitionRenderTarget, target != nullptr ? target->Address() : 0);
+	}
+
+	auto NullCommandList::SetViewport(
+		uint32_t x,
+		uint32_t y,
+		uint32_t width,
+		uint32_t height,
+		uint32_t minDepth,
+		uint32_t maxDepth
+	) -> void {
+		Record(NullCommandType::SetViewport);
+	}
+
+	auto NullCommandList::SetScissorRect(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) -> void {
+		Record(NullCommandType::SetScissorRect);
+	}
+
+	auto NullCommandList::SetViewMatrix(glm::mat4 viewMatrix) -> void {
+		Record(NullCommandType::SetViewMatrix);
+	}
+
+	auto NullCommandList::SetProjectionMatrix(glm::mat4 projectionMatrix) -> void {
+		Record(NullCommandType::SetProjectionMatrix);
+	}
+
+	auto NullCommandList::SetPrimitiveTopology(PrimitiveTopology topology) -> void {
+		Record(NullCommandType::SetPrimitiveTopology);
+	}
+
+	auto NullCommandList::SetBlending(bool enabled) -> void {
+		Record(NullCommandType::SetBlending, enabled);
+	}
+
+	auto NullCommandList::SetDepthMode(DepthMode mode) -> void {
+		Record(NullCommandType::SetDepthMode, static_cast<uint64_t>(mode));
+	}
+
+	auto NullCommandList::SetDepthBias(float bias) -> void {
+		Record(NullCommandType::SetDepthBias, std::bit_cast<uint32_t>(bias));
+	}
+
+	auto NullCommandList::SetMaterial(std::shared_ptr<Material> material) -> void {
+		Record(NullCommandType::SetMaterial, reinterpret_cast<uint64_t>(material.get()));
+	}
+
+	auto NullCommandList::BindVertexArray(std::shared_ptr<VertexArray> vertexArray) -> void const {
+		Record(NullCommandType::BindVertexArray, vertexArray->Id());
+	}
+
+	auto NullCommandList::BindVertexBuffer(uint8_t index, std::shared_ptr<VertexBuffer> vertexBuffer) -> void const {
+		Record(NullCommandType::BindVertexBuffer, vertexBuffer->Id());
+	}
+
+	auto NullCommandList::BindIndexBuffer(std::shared_ptr<IndexBuffer> indexBuffer) -> void const {
+		Record(NullCommandType::BindIndexBuffer, indexBuffer->Id());
+	}
+
+	auto NullCommandList::DrawIndexed(glm::mat4 model, glm::vec4 uvRect, uint32_t numIndices, uint32_t startIndex, int32_t baseVertex) -> void {
+		// The builtins go out as uniforms with every draw
+		Record(NullCommandType::Upload, sizeof(model) + sizeof(uvRect));
+		Record(NullCommandType::Draw, numIndices);
+	}
+
+	auto NullCommandList::DrawIndexedInstanced(
+		uint32_t numIndices,
+		uint32_t instanceCount,
+		uint32_t startIndexLocation,
+		int32_t baseVertexLocation
+	) -> void {
+		Record(NullCommandType::DrawInstanced, instanceCount);
+	}
+
+	auto NullCommandList::SetIndirectDraws(std::vector<DrawIndirectCommand> commands, std::vector<DrawData> draws) -> void {
+		Record(NullCommandType::Upload, commands.size() * sizeof(DrawIndirectCommand) + draws.size() * sizeof(DrawData));
+	}
+
+	auto NullCommandList::MultiDrawIndexedIndirect(uint32_t firstCommand, uint32_t commandCount) -> void {
+		Record(NullCommandType::MultiDrawIndirect, commandCount);
+	}
+
+	auto NullCommandList::SetSpriteInstances(std::vector<SpriteInstance> instances) -> void {
+		Record(NullCommandType::Upload, instances.size() * sizeof(SpriteInstance));
+	}
+
+	auto NullCommandList::DrawSpriteInstances(
+		uint32_t numIndices,
+		uint32_t startIndex,
+		int32_t baseVertex,
+		uint32_t firstInstance,
+		uint32_t instanceCount
+	) -> void {
+		Record(NullCommandType::DrawInstanced, instanceCount);
+	}
+
+	auto NullCommandList::WriteTimestamp(std::shared_ptr<GpuTimerPool> pool, uint32_t query) -> void {
+		Record(NullCommandType::WriteTimestamp, query);
+	}
+
+	auto NullCommandList::UploadTexture(
+		std::shared_ptr<Texture> texture,
+		uint32_t width,
+		uint32_t height,
+		std::shared_ptr<std::vector<uint8_t>> pixels
+	) -> void {
+		Record(NullCommandType::Upload, pixels != nullptr ? pixels->size() : 0);
+	}
+
+	auto NullCommandList::UploadCompressedTexture(
+		std::shared_ptr<Texture> texture,
+		shared::TextureFormat format,
+		std::vector<shared::TextureLevel> levels,
+		std::shared_ptr<const uint8_t> data
+	) -> void {
+		uint64_t bytes = 0;
+		for (auto& level : levels) {
+			bytes += level.size;
+		}
+
+		Record(NullCommandType::Upload, bytes);
+	}
+
+	auto NullCommandList::UpdateBuffers(
+		std::shared_ptr<const std::vector<uint8_t>> staging,
+		std::vector<BufferCopy> copies
+	) -> void {
+		// One transfer of the staging data, the copies stay on the GPU
+		Record(NullCommandType::Upload, staging != nullptr ? staging->size() : 0);
+	}
+}
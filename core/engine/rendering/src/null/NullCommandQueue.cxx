@@ -0,0 +1,19 @@
+#include "rendering/null/NullCommandQueue.hxx"
+#include "rendering/null/NullCommandList.hxx"
+
+namespace kyanite::engine::rendering::null {
+	auto NullCommandQueue::Execute(const std::vector<std::shared_ptr<CommandList>>& commandLists) -> void {
+		// Same as GlCommandQueue, every execution starts without assumptions about the bound state
+		_tracker->Reset();
+
+		for (auto& commandList : commandLists) {
+			for (auto& command : std::static_pointer_cast<NullCommandList>(commandList)->_commands) {
+				_tracker->Execute(command);
+			}
+		}
+	}
+
+	auto NullCommandQueue::Signal(Fence& fence, uint64_t value) -> void {
+		fence.SetOnCompletion(value, nullptr);
+	}
+}
@@ -0,0 +1,142 @@
+#include "rendering/null/NullDevice.hxx"
+#include "rendering/null/NullCommandList.hxx"
+#include "rendering/null/NullCommandQueue.hxx"
+#include "rendering/null/NullResources.hxx"
+#include "rendering/RenderBackendType.hxx"
+#include "rendering/GraphicsContext.hxx"
+#include "rendering/ImGuiContext.hxx"
+#include "rendering/UploadContext.hxx"
+
+#include <imgui.h>
+
+namespace kyanite::engine::rendering::null {
+	NullDevice::NullDevice(uint32_t width, uint32_t height) :
+		_width(width),
+		_height(height),
+		_tracker(std::make_shared<NullStateTracker>()) {
+		_graphicsQueue = CreateCommandQueue(CommandListType::Graphics);
+		_computeQueue = CreateCommandQueue(CommandListType::Compute);
+		_copyQueue = CreateCommandQueue(CommandListType::Copy);
+		_directQueue = CreateCommandQueue(CommandListType::Transfer);
+	}
+
+	auto NullDevice::CreateGraphicsContext() -> std::unique_ptr<GraphicsContext> {
+		return std::make_unique<GraphicsContext>(this->shared_from_this(), _graphicsQueue);
+	}
+
+	auto NullDevice::CreateImGuiContext(ImGuiContext* context) -> std::unique_ptr<ImmediateGuiContext> {
+		auto gui = std::make_unique<ImmediateGuiContext>(
+			this->shared_from_this(),
+			nullptr,
+			nullptr,
+			RenderBackendType::Null,
+			_graphicsQueue,
+			context
+		);
+
+		// Without a platform backend nothing else tells ImGui how large the screen is
+		ImGui::GetIO().DisplaySize = ImVec2(static_cast<float>(_width), static_cast<float>(_height));
+
+		return gui;
+	}
+
+	auto NullDevice::CreateUploadContext() -> std::unique_ptr<UploadContext> {
+		return std::make_unique<UploadContext>(this->shared_from_this(), _copyQueue);
+	}
+
+	auto NullDevice::CreateCommandList(CommandListType type) -> std::shared_ptr<CommandList> {
+		return std::make_shared<NullCommandList>(type);
+	}
+
+	auto NullDevice::CreateCommandQueue(CommandListType type) -> std::shared_ptr<CommandQueue> {
+		return std::make_shared<NullCommandQueue>(type, _tracker);
+	}
+
+	auto NullDevice::CreateCommandAllocator() -> std::shared_ptr<CommandAllocator> {
+		return std::make_shared<NullCommandAllocator>();
+	}
+
+	auto NullDevice::CreateFence() -> std::shared_ptr<Fence> {
+		return std::make_shared<NullFence>();
+	}
+
+	auto NullDevice::CreateSwapchain() -> std::unique_ptr<Swapchain> {
+		return std::make_unique<NullSwapchain>();
+	}
+
+	auto NullDevice::CreateTimerPool() -> std::shared_ptr<GpuTimerPool> {
+		return std::make_shared<NullGpuTimerPool>();
+	}
+
+	auto NullDevice::CreateBuffer(uint64_t size) -> std::shared_ptr<Buffer> {
+		return nullptr;
+	}
+
+	auto NullDevice::CreateRenderTarget(const RenderTargetDesc& desc) -> std::shared_ptr<RenderTarget> {
+		auto id = NextId();
+		return std::make_shared<NullRenderTarget>(id, desc, NextId());
+	}
+
+	auto NullDevice::CreateMaterial(
+		std::map<ShaderType, std::shared_ptr<Shader>> shaders,
+		bool isInstanced
+	) -> std::shared_ptr<Material> {
+		return std::make_shared<NullMaterial>(shaders, isInstanced);
+	}
+
+	auto NullDevice::CompileShader(
+		const std::string& shaderSource,
+		ShaderType type
+	) -> std::shared_ptr<Shader> {
+		return std::make_shared<Shader>("", type, NextId());
+	}
+
+	auto NullDevice::CreateVertexBuffer(const void* data, uint64_t size, size_t elemSize, BufferUsage usage) -> std::shared_ptr<VertexBuffer> {
+		if (data != nullptr) {
+			_tracker->Upload(size * elemSize);
+		}
+
+		return std::make_shared<NullVertexBuffer>(NextId(), size, usage);
+	}
+
+	auto NullDevice::UpdateVertexBuffer(std::shared_ptr<VertexBuffer> buffer, const void* data, uint64_t size) -> void {
+		_tracker->Upload(size);
+	}
+
+	auto NullDevice::CreateIndexBuffer(const uint32_t* indices, size_t len, BufferUsage usage) -> std::shared_ptr<IndexBuffer> {
+		if (indices != nullptr) {
+			_tracker->Upload(len * sizeof(uint32_t));
+		}
+
+		return std::make_shared<NullIndexBuffer>(NextId(), len, usage);
+	}
+
+	auto NullDevice::UpdateIndexBuffer(std::shared_ptr<IndexBuffer> buffer, std::vector<uint32_t> indices) -> void {
+		_tracker->Upload(indices.size() * sizeof(uint32_t));
+		buffer->Resize(indices.size());
+	}
+
+	auto NullDevice::CreateVertexArray(
+		std::shared_ptr<VertexBuffer> vertexBuffer,
+		std::shared_ptr<IndexBuffer> indexBuffer
+	) -> std::shared_ptr<VertexArray> {
+		return std::make_shared<NullVertexArray>(NextId(), vertexBuffer, indexBuffer);
+	}
+
+	auto NullDevice::CreateTexture(
+		uint32_t width,
+		uint32_t height,
+		uint32_t channels,
+		const uint8_t* data
+	) -> std::shared_ptr<Texture> {
+		if (data != nullptr) {
+			_tracker->Upload(static_cast<uint64_t>(width) * height * channels);
+		}
+
+		return std::make_shared<NullTexture>(NextId());
+	}
+
+	auto NullDevice::CreatePlaceholderTexture() -> std::shared_ptr<Texture> {
+		return std::make_shared<NullTexture>(NextId());
+	}
+}
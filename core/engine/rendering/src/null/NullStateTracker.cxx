@@ -0,0 +1,65 @@
+#include "rendering/null/NullStateTracker.hxx"
+
+namespace kyanite::engine::rendering::null {
+	auto NullStateTracker::Reset() -> void {
+		_renderTarget = Unknown;
+		_material = Unknown;
+		_vertexArray = Unknown;
+		_vertexBuffer = Unknown;
+		_indexBuffer = Unknown;
+		_blending = Unknown;
+		_depthMode = Unknown;
+		_depthBias = Unknown;
+	}
+
+	auto NullStateTracker::Execute(const NullCommand& command) -> void {
+		_stats.commands++;
+
+		switch (command.type) {
+		case NullCommandType::BindRenderTarget:
+			Bind(_renderTarget, command.value);
+			break;
+		case NullCommandType::SetMaterial:
+			Bind(_material, command.value);
+			break;
+		case NullCommandType::BindVertexArray:
+			Bind(_vertexArray, command.value);
+			break;
+		case NullCommandType::BindVertexBuffer:
+			Bind(_vertexBuffer, command.value);
+			break;
+		case NullCommandType::BindIndexBuffer:
+			Bind(_indexBuffer, command.value);
+			break;
+		case NullCommandType::SetBlending:
+			Bind(_blending, command.value);
+			break;
+		case NullCommandType::SetDepthMode:
+			Bind(_depthMode, command.value);
+			break;
+		case NullCommandType::SetDepthBias:
+			Bind(_depthBias, command.value);
+			break;
+		case NullCommandType::Draw:
+		case NullCommandType::DrawInstanced:
+		case NullCommandType::MultiDrawIndirect:
+			_stats.drawCalls++;
+			break;
+		case NullCommandType::Upload:
+			_stats.uploadedBytes += command.value;
+			break;
+		default:
+			break;
+		}
+	}
+
+	auto NullStateTracker::Bind(uint64_t& bound, uint64_t value) -> void {
+		if (bound == value) {
+			_stats.redundantStateChanges++;
+			return;
+		}
+
+		bound = value;
+		_stats.stateChanges++;
+	}
+}
@@ -1,23 +1,49 @@
 #include "rendering/IndexBuffer.hxx"
 #include "rendering/PrimitiveTopology.hxx"
 #include "rendering/VertexBuffer.hxx"
+#include "rendering/opengl/GlBufferUsage.hxx"
+#include "rendering/opengl/GlGpuTimerPool.hxx"
 #include "rendering/opengl/GlCommandList.hxx"
 #include "rendering/opengl/GlIndexBuffer.hxx"
 #include "rendering/opengl/GlMaterial.hxx"
+#include "rendering/opengl/GlRenderTarget.hxx"
 #include "rendering/opengl/GlVertexBuffer.hxx"
 
 #include "glad/glad.h"
 
 #include <glm/gtc/type_ptr.hpp>
+#include <cstring>
 #include <stdexcept>
 
+// EXT_texture_compression_s3tc is not part of the generated loader, but every desktop driver exposes it
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 namespace kyanite::engine::rendering::opengl {
-	GlCommandList::GlCommandList(CommandListType type) : CommandList(type) {
+	GlCommandList::GlCommandList(CommandListType type, std::shared_ptr<GlStateCache> state) :
+		CommandList(type),
+		_state(std::move(state)) {
 
 	}
 
 	GlCommandList::~GlCommandList() {
-
+		if (!_pixelBuffers.empty()) {
+			glDeleteBuffers(static_cast<GLsizei>(_pixelBuffers.size()), _pixelBuffers.data());
+		}
+		if (!_stagingBuffers.empty()) {
+			glDeleteBuffers(static_cast<GLsizei>(_stagingBuffers.size()), _stagingBuffers.data());
+		}
+		if (_indirectBuffer != 0) {
+			glDeleteBuffers(1, &_indirectBuffer);
+			glDeleteBuffers(1, &_drawDataBuffer);
+		}
+		if (_spriteBuffer != 0) {
+			glDeleteBuffers(1, &_spriteBuffer);
+		}
 	}
 
 	auto GlCommandList::Begin() -> void {
@@ -35,11 +61,43 @@ namespace kyanite::engine::rendering::opengl {
 	}
 
 	auto GlCommandList::ClearRenderTarget(glm::vec4 color) -> void {
-		_commands.push_back([color]() {
+		_commands.push_back([this, color]() {
 			glClearColor(color.r, color.g, color.b, color.a);
-			glClear(GL_COLOR_BUFFER_BIT);
-			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			// Depth writes gate depth clears, so they are turned on first
+			_state->SetDepthWrite(true);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			_state->SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		});
+	}
+
+	auto GlCommandList::BindRenderTarget(std::shared_ptr<RenderTarget> target) -> void {
+		auto glTarget = std::static_pointer_cast<GlRenderTarget>(target);
+		_commands.push_back([this, glTarget]() {
+			_state->BindFramebuffer(glTarget != nullptr ? glTarget->Framebuffer() : _state->DefaultFramebuffer());
+		});
+	}
+
+	auto GlCommandList::TransitionRenderTarget(
+		std::shared_ptr<RenderTarget> target,
+		ResourceState before,
+		ResourceState after
+	) -> void {
+		auto glTarget = std::static_pointer_cast<GlRenderTarget>(target);
+		if (glTarget == nullptr) {
+			return;
+		}
+
+		_commands.push_back([this, glTarget, before, after]() {
+			// GL orders framebuffer writes before later texture fetches on its own, it only has to stop being a feedback loop
+			if (after == ResourceState::ShaderResource && _state->BoundFramebuffer() == glTarget->Framebuffer()) {
+				_state->BindFramebuffer(_state->DefaultFramebuffer());
+			}
+
+			// Contents nobody reads again are dropped instead of being kept, which tilers do not have to write back
+			if (before == ResourceState::Undefined && after == ResourceState::RenderTarget) {
+				const GLenum attachments[] = { GL_COLOR_ATTACHMENT0, GL_DEPTH_STENCIL_ATTACHMENT };
+				glInvalidateNamedFramebufferData(glTarget->Framebuffer(), glTarget->HasDepth() ? 2 : 1, attachments);
+			}
 		});
 	}
 
@@ -62,6 +120,38 @@ namespace kyanite::engine::rendering::opengl {
 		});
 	}
 
+	auto GlCommandList::SetBlending(bool enabled) -> void {
+		_commands.push_back([this, enabled]() {
+			_state->SetBlend(enabled, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		});
+	}
+
+	auto GlCommandList::SetDepthMode(DepthMode mode) -> void {
+		_commands.push_back([this, mode]() {
+			switch (mode) {
+			case DepthMode::Disabled:
+				_state->SetDepthTest(false, GL_LESS);
+				_state->SetDepthWrite(false);
+				break;
+			case DepthMode::TestAndWrite:
+				_state->SetDepthTest(true, GL_LESS);
+				_state->SetDepthWrite(true);
+				break;
+			case DepthMode::TestOnly:
+				// Blended draws at the depth of an opaque one still show on top of it
+				_state->SetDepthTest(true, GL_LEQUAL);
+				_state->SetDepthWrite(false);
+				break;
+			}
+		});
+	}
+
+	auto GlCommandList::SetDepthBias(float bias) -> void {
+		_commands.push_back([this, bias]() {
+			_state->SetDepthBias(bias);
+		});
+	}
+
 	auto GlCommandList::SetPrimitiveTopology(PrimitiveTopology topology) -> void {
 			_commands.push_back([this, topology]() {
 			switch (topology) {
@@ -97,7 +187,7 @@ namespace kyanite::engine::rendering::opengl {
 
 	auto GlCommandList::BindVertexArray(std::shared_ptr<VertexArray> vertexArray) -> void const {
 		_commands.push_back([this, vertexArray]() {
-			vertexArray->Bind();
+			_state->BindVertexArray(vertexArray->Id());
 		});
 	}
 
@@ -112,52 +202,62 @@ namespace kyanite::engine::rendering::opengl {
 
 	auto GlCommandList::BindVertexBuffer(uint8_t index, std::shared_ptr<VertexBuffer> vertexBuffer) -> void const {
 		_commands.push_back([this, vertexBuffer, index]() {
-			vertexBuffer->Bind();
+			auto buffer = static_cast<GLuint>(vertexBuffer->Id());
 
-			if (index == 0) {
-				glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-				glEnableVertexAttribArray(0);
+			if (index == 0 && vertexBuffer->Layout() == VertexLayout::Half16) {
+				// Cooked meshes, x y z and a padding half followed by u v
+				_state->SetVertexAttributePointer(0, buffer, 3, 12, 0, GL_HALF_FLOAT);
+				_state->EnableVertexAttribute(0, true);
+				_state->SetVertexAttributePointer(1, buffer, 2, 12, 8, GL_HALF_FLOAT);
+				_state->EnableVertexAttribute(1, true);
+			}
+			else if (index == 0) {
+				_state->SetVertexAttributePointer(0, buffer, 3, sizeof(Vertex), offsetof(Vertex, position));
+				_state->EnableVertexAttribute(0, true);
 
 				// Texture coordinate attribute
-				glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, uvs));
-				glEnableVertexAttribArray(1);
+				_state->SetVertexAttributePointer(1, buffer, 2, sizeof(Vertex), offsetof(Vertex, uvs));
+				_state->EnableVertexAttribute(1, true);
+			}
+			else if (index == 2) {
+				// Per instance texture region (u0, v0, u1, v1)
+				_state->SetVertexAttributePointer(6, buffer, 4, sizeof(glm::vec4), 0);
+				_state->EnableVertexAttribute(6, true);
+				_state->SetVertexAttributeDivisor(6, 1);
 			}
 			else {
-				// Set up instance attributes (model matrix as 4 vec4s)
-				glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)0);
-				glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4)));
-				glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(2 * sizeof(glm::vec4)));
-				glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(3 * sizeof(glm::vec4)));
-				glEnableVertexAttribArray(2);
-				glEnableVertexAttribArray(3);
-				glEnableVertexAttribArray(4);
-				glEnableVertexAttribArray(5);
-
-				// Set divisors for instanced attributes
-				glVertexAttribDivisor(2, 1);
-				glVertexAttribDivisor(3, 1);
-				glVertexAttribDivisor(4, 1);
-				glVertexAttribDivisor(5, 1);
+				// Set up instance attributes (model matrix as 4 vec4s), one instance per element
+				for (GLuint column = 0; column < 4; column++) {
+					_state->SetVertexAttributePointer(2 + column, buffer, 4, sizeof(glm::mat4), column * sizeof(glm::vec4));
+					_state->EnableVertexAttribute(2 + column, true);
+					_state->SetVertexAttributeDivisor(2 + column, 1);
+				}
 			}
 		});
 	}
 
 	auto GlCommandList::BindIndexBuffer(std::shared_ptr<IndexBuffer> indexBuffer) -> void const {
 		_commands.push_back([this, indexBuffer]() {
-			indexBuffer->Bind();
+			_state->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLuint>(indexBuffer->Id()));
 		});
 	}
 
-	auto GlCommandList::DrawIndexed(glm::mat4 model, uint32_t numIndices, uint32_t startIndex) -> void {
-		_commands.emplace_back([this, numIndices, startIndex, model]() {
-			_currentMaterial->SetBuiltins(model, _viewMatrix, _projectionMatrix);
+	auto GlCommandList::DrawIndexed(glm::mat4 model, glm::vec4 uvRect, uint32_t numIndices, uint32_t startIndex, int32_t baseVertex) -> void {
+		_commands.emplace_back([this, numIndices, startIndex, baseVertex, model, uvRect]() {
+			// Neither the material nor its fallback finished linking yet
+			if (!_currentMaterial->CanDraw()) {
+				return;
+			}
+
+			_currentMaterial->SetBuiltins(model, uvRect, _viewMatrix, _projectionMatrix);
 
 			GLenum error = glGetError();
 			if (error != GL_NO_ERROR) {
 				std::cerr << "OpenGL Error: " << error << std::endl;
 			}
 
-			glDrawElements(_primitiveTopology, numIndices, GL_UNSIGNED_INT, (void*)(startIndex * sizeof(uint32_t)));
+			// Meshes in a shared buffer keep indices relative to their own first vertex
+			glDrawElementsBaseVertex(_primitiveTopology, numIndices, GL_UNSIGNED_INT, (void*)(startIndex * sizeof(uint32_t)), baseVertex);
 		});
 	}
 
@@ -167,15 +267,26 @@ namespace kyanite::engine::rendering::opengl {
 		uint32_t startIndexLocation,
 		int32_t baseVertexLocation
 	) -> void {
-		_commands.emplace_back([this, numIndices, instanceCount, startIndexLocation]() {
-			_currentMaterial->SetBuiltins(glm::mat4(1), _viewMatrix, _projectionMatrix);
+		_commands.emplace_back([this, numIndices, instanceCount, startIndexLocation, baseVertexLocation]() {
+			if (!_currentMaterial->CanDraw()) {
+				return;
+			}
+
+			_currentMaterial->SetBuiltins(glm::mat4(1), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), _viewMatrix, _projectionMatrix);
 
 			GLenum error = glGetError();
 			if (error != GL_NO_ERROR) {
 				std::cerr << "OpenGL Error: " << error << std::endl;
 			}
 
-			glDrawElementsInstanced(_primitiveTopology, numIndices, GL_UNSIGNED_INT, (void*)(startIndexLocation * sizeof(uint32_t)), instanceCount);
+			glDrawElementsInstancedBaseVertex(
+				_primitiveTopology,
+				numIndices,
+				GL_UNSIGNED_INT,
+				(void*)(startIndexLocation * sizeof(uint32_t)),
+				instanceCount,
+				baseVertexLocation
+			);
 
 			error = glGetError();
 			if (error != GL_NO_ERROR) {
@@ -183,4 +294,205 @@ namespace kyanite::engine::rendering::opengl {
 			}
 		});
 	}
-}
\ No newline at end of file
+
+	auto GlCommandList::UpdateBuffers(
+		std::shared_ptr<const std::vector<uint8_t>> staging,
+		std::vector<BufferCopy> copies
+	) -> void {
+		_commands.push_back([this, staging, copies = std::move(copies)]() {
+			if (_stagingBuffers.empty()) {
+				_stagingBuffers.resize(StagingBufferCount);
+				glCreateBuffers(static_cast<GLsizei>(_stagingBuffers.size()), _stagingBuffers.data());
+			}
+
+			auto stagingBuffer = _stagingBuffers[_nextStagingBuffer];
+			_nextStagingBuffer = (_nextStagingBuffer + 1) % _stagingBuffers.size();
+
+			// Respecifying orphans the storage copies of earlier frames may still read from
+			glNamedBufferData(stagingBuffer, static_cast<GLsizeiptr>(staging->size()), staging->data(), GL_STREAM_DRAW);
+
+			for (const auto& copy : copies) {
+				auto buffer = static_cast<GLuint>(copy.buffer->Id());
+
+				// Draws in flight keep the old storage, so replacing never waits for them
+				if (copy.replace) {
+					glNamedBufferData(buffer, static_cast<GLsizeiptr>(copy.size), nullptr, GlBufferUsage(copy.buffer->Usage()));
+				}
+
+				glCopyNamedBufferSubData(
+					stagingBuffer,
+					buffer,
+					static_cast<GLintptr>(copy.sourceOffset),
+					static_cast<GLintptr>(copy.offset),
+					static_cast<GLsizeiptr>(copy.size)
+				);
+			}
+		});
+	}
+
+	auto GlCommandList::SetIndirectDraws(std::vector<DrawIndirectCommand> commands, std::vector<DrawData> draws) -> void {
+		_commands.push_back([this, commands = std::move(commands), draws = std::move(draws)]() {
+			if (_indirectBuffer == 0) {
+				glCreateBuffers(1, &_indirectBuffer);
+				glCreateBuffers(1, &_drawDataBuffer);
+			}
+
+			glNamedBufferData(_indirectBuffer, commands.size() * sizeof(DrawIndirectCommand), commands.data(), GL_STREAM_DRAW);
+			glNamedBufferData(_drawDataBuffer, draws.size() * sizeof(DrawData), draws.data(), GL_STREAM_DRAW);
+		});
+	}
+
+	auto GlCommandList::MultiDrawIndexedIndirect(uint32_t firstCommand, uint32_t commandCount) -> void {
+		_commands.emplace_back([this, firstCommand, commandCount]() {
+			if (!_currentMaterial->CanDraw()) {
+				return;
+			}
+
+			_currentMaterial->SetBuiltins(glm::mat4(1), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), _viewMatrix, _projectionMatrix);
+
+			// The draw data replaces the instance buffers, the model matrix columns and then the texture region
+			for (GLuint column = 0; column < 4; column++) {
+				_state->SetVertexAttributePointer(2 + column, _drawDataBuffer, 4, sizeof(DrawData), offsetof(DrawData, model) + column * sizeof(glm::vec4));
+				_state->EnableVertexAttribute(2 + column, true);
+				_state->SetVertexAttributeDivisor(2 + column, 1);
+			}
+			_state->SetVertexAttributePointer(6, _drawDataBuffer, 4, sizeof(DrawData), offsetof(DrawData, uvRect));
+			_state->EnableVertexAttribute(6, true);
+			_state->SetVertexAttributeDivisor(6, 1);
+
+			_state->BindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBuffer);
+			glMultiDrawElementsIndirect(
+				_primitiveTopology,
+				GL_UNSIGNED_INT,
+				reinterpret_cast<const void*>(static_cast<uintptr_t>(firstCommand) * sizeof(DrawIndirectCommand)),
+				static_cast<GLsizei>(commandCount),
+				0
+			);
+		});
+	}
+
+	auto GlCommandList::SetSpriteInstances(std::vector<SpriteInstance> instances) -> void {
+		_commands.push_back([this, instances = std::move(instances)]() {
+			if (_spriteBuffer == 0) {
+				glCreateBuffers(1, &_spriteBuffer);
+			}
+
+			glNamedBufferData(_spriteBuffer, instances.size() * sizeof(SpriteInstance), instances.data(), GL_STREAM_DRAW);
+		});
+	}
+
+	auto GlCommandList::DrawSpriteInstances(
+		uint32_t numIndices,
+		uint32_t startIndex,
+		int32_t baseVertex,
+		uint32_t firstInstance,
+		uint32_t instanceCount
+	) -> void {
+		_commands.emplace_back([this, numIndices, startIndex, baseVertex, firstInstance, instanceCount]() {
+			if (!_currentMaterial->CanDraw()) {
+				return;
+			}
+
+			_currentMaterial->SetBuiltins(glm::mat4(1), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), _viewMatrix, _projectionMatrix);
+
+			// The compact instances replace the instance buffers, attribute 6 is not read by batched materials
+			_state->SetVertexAttributePointer(2, _spriteBuffer, 3, sizeof(SpriteInstance), offsetof(SpriteInstance, position));
+			_state->SetVertexAttributePointer(3, _spriteBuffer, 2, sizeof(SpriteInstance), offsetof(SpriteInstance, scale), GL_HALF_FLOAT);
+			_state->SetVertexAttributePointer(4, _spriteBuffer, 4, sizeof(SpriteInstance), offsetof(SpriteInstance, uvRect), GL_UNSIGNED_SHORT, true);
+			_state->SetVertexAttributePointer(5, _spriteBuffer, 4, sizeof(SpriteInstance), offsetof(SpriteInstance, color), GL_UNSIGNED_BYTE, true);
+			for (GLuint attribute = 2; attribute <= 5; attribute++) {
+				_state->EnableVertexAttribute(attribute, true);
+				_state->SetVertexAttributeDivisor(attribute, 1);
+			}
+
+			glDrawElementsInstancedBaseVertexBaseInstance(
+				_primitiveTopology,
+				numIndices,
+				GL_UNSIGNED_INT,
+				reinterpret_cast<const void*>(static_cast<uintptr_t>(startIndex) * sizeof(uint32_t)),
+				instanceCount,
+				baseVertex,
+				firstInstance
+			);
+		});
+	}
+
+	auto GlCommandList::WriteTimestamp(std::shared_ptr<GpuTimerPool> pool, uint32_t query) -> void {
+		auto glPool = std::static_pointer_cast<GlGpuTimerPool>(pool);
+		_commands.push_back([glPool, query]() {
+			glQueryCounter(glPool->Query(query), GL_TIMESTAMP);
+		});
+	}
+
+	auto GlCommandList::UploadTexture(
+		std::shared_ptr<Texture> texture,
+		uint32_t width,
+		uint32_t height,
+		std::shared_ptr<std::vector<uint8_t>> pixels
+	) -> void {
+		_commands.push_back([this, texture, width, height, pixels]() {
+			if (_pixelBuffers.empty()) {
+				_pixelBuffers.resize(PixelBufferCount);
+				glGenBuffers(static_cast<GLsizei>(_pixelBuffers.size()), _pixelBuffers.data());
+			}
+
+			auto pixelBuffer = _pixelBuffers[_nextPixelBuffer];
+			_nextPixelBuffer = (_nextPixelBuffer + 1) % _pixelBuffers.size();
+
+			// Orphan the previous storage so we never wait for an upload that is still in flight
+			auto size = static_cast<GLsizeiptr>(pixels->size());
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+			glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+			if (auto mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT)) {
+				std::memcpy(mapped, pixels->data(), pixels->size());
+				glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			}
+
+			// The texture keeps its name, so materials that already reference it pick up the new image
+			_state->EditTexture(texture->ID());
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+			glGenerateMipmap(GL_TEXTURE_2D);
+
+			// The placeholder was sampled without mips, anything larger than a texel reads the chain it just got
+			if (width > 1 || height > 1) {
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			}
+
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		});
+	}
+
+	auto GlCommandList::UploadCompressedTexture(
+		std::shared_ptr<Texture> texture,
+		shared::TextureFormat format,
+		std::vector<shared::TextureLevel> levels,
+		std::shared_ptr<const uint8_t> data
+	) -> void {
+		_commands.push_back([this, texture, format, levels = std::move(levels), data]() {
+			auto internalFormat = format == shared::TextureFormat::BC1
+				? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+				: GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+			// The blocks already hold every level, so there is nothing left to generate
+			_state->EditTexture(texture->ID());
+			for (size_t level = 0; level < levels.size(); level++) {
+				glCompressedTexImage2D(
+					GL_TEXTURE_2D,
+					static_cast<GLint>(level),
+					internalFormat,
+					levels[level].width,
+					levels[level].height,
+					0,
+					static_cast<GLsizei>(levels[level].size),
+					data.get() + levels[level].offset
+				);
+			}
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size() - 1));
+			if (levels.size() > 1) {
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			}
+		});
+	}
+}
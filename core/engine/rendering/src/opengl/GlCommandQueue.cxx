@@ -8,11 +8,16 @@
 #include <sstream>
 
 namespace kyanite::engine::rendering::opengl {
-	GlCommandQueue::GlCommandQueue(CommandListType type) : CommandQueue(type) {
+	GlCommandQueue::GlCommandQueue(CommandListType type, std::shared_ptr<GlStateCache> state) :
+		CommandQueue(type),
+		_state(std::move(state)) {
 
 	}
 
 	auto GlCommandQueue::Execute(const std::vector<std::shared_ptr<CommandList>>& commandLists) -> void {
+		// Resources were created and ImGui drew since the last execution, none of that went through the shadow
+		_state->Reset();
+
 		for (auto& commandList : commandLists) {
 			for (auto& command : std::dynamic_pointer_cast<GlCommandList>(commandList)->_commands) {
 				if (command == nullptr) {
@@ -3,10 +3,12 @@
 #include "rendering/opengl/GlCommandQueue.hxx"
 #include "rendering/opengl/GlCommandAllocator.hxx"
 #include "rendering/opengl/GlFence.hxx"
+#include "rendering/opengl/GlGpuTimerPool.hxx"
 #include "rendering/Shader.hxx"
 #include "rendering/opengl/GlIndexBuffer.hxx"
 #include "rendering/opengl/GlVertexBuffer.hxx"
 #include "rendering/opengl/GlMaterial.hxx"
+#include "rendering/opengl/GlRenderTarget.hxx"
 #include "rendering/opengl/GlSwapchain.hxx"
 #include "rendering/opengl/GlShader.hxx"
 #include "rendering/opengl/GlTexture.hxx"
@@ -21,6 +23,7 @@
 #include <glad/glad.h>
 #include <GL/gl.h>
 
+#include <filesystem>
 #include <stdexcept>
 
 namespace kyanite::engine::rendering::opengl {
@@ -43,14 +46,35 @@ namespace kyanite::engine::rendering::opengl {
 
 		SDL_GL_MakeCurrent(window, context);
 
+		_window = window;
+		_glContext = context;
+
+		Initialize((GLADloadproc)SDL_GL_GetProcAddress);
+	}
+
+	GlDevice::~GlDevice() {
+		// Programs have to be deleted while their context is still alive
+		_programCache = nullptr;
+		if (_glContext != nullptr) {
+			SDL_GL_DeleteContext(_glContext);
+		}
+	}
+
+	auto GlDevice::Initialize(GLADloadproc loader) -> void {
 		// Initialize GLAD
-		if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress)) {
+		if (!gladLoadGLLoader(loader)) {
 			std::cout << "Failed to initialize GLAD" << std::endl;
 			throw std::runtime_error("Failed to initialize GLAD");
 		}
 
-		_window = window;
-		_glContext = context;
+		// Program binaries go to the per user data directory, next to nothing else the engine writes
+		std::filesystem::path cacheDirectory;
+		if (auto prefPath = SDL_GetPrefPath("Kyanite", "ShaderCache")) {
+			cacheDirectory = prefPath;
+			SDL_free(prefPath);
+		}
+		_programCache = std::make_unique<GlProgramCache>(cacheDirectory, loader);
+		_state = std::make_shared<GlStateCache>();
 
 		_graphicsQueue = CreateCommandQueue(CommandListType::Graphics);
 		_computeQueue = CreateCommandQueue(CommandListType::Compute);
@@ -58,12 +82,18 @@ namespace kyanite::engine::rendering::opengl {
 		_directQueue = CreateCommandQueue(CommandListType::Transfer);
 	}
 
-	GlDevice::~GlDevice() {
-		SDL_GL_DeleteContext(_glContext);
+	auto GlDevice::Shutdown() -> void {
+
 	}
 
-	auto GlDevice::Shutdown() -> void {
+	auto GlDevice::AttachToCurrentThread() -> void {
+		if (SDL_GL_MakeCurrent(_window, _glContext) != 0) {
+			std::cout << "Failed to make the OpenGL context current: " << SDL_GetError() << std::endl;
+		}
+	}
 
+	auto GlDevice::DetachFromCurrentThread() -> void {
+		SDL_GL_MakeCurrent(_window, nullptr);
 	}
 
 	auto GlDevice::CreateGraphicsContext() -> std::unique_ptr<GraphicsContext> {
@@ -86,11 +116,11 @@ namespace kyanite::engine::rendering::opengl {
 	}
 
 	auto GlDevice::CreateCommandList(CommandListType type) -> std::shared_ptr<CommandList> {
-		return std::make_shared<GlCommandList>(type);
+		return std::make_shared<GlCommandList>(type, _state);
 	}
 
 	auto GlDevice::CreateCommandQueue(CommandListType type) -> std::shared_ptr<CommandQueue> {
-		return std::make_shared<GlCommandQueue>(type);
+		return std::make_shared<GlCommandQueue>(type, _state);
 	}
 
 	auto GlDevice::CreateCommandAllocator() -> std::shared_ptr<CommandAllocator> {
@@ -105,77 +135,67 @@ namespace kyanite::engine::rendering::opengl {
 		return std::make_unique<GlSwapchain>(_window);
 	}
 
+	auto GlDevice::CreateTimerPool() -> std::shared_ptr<GpuTimerPool> {
+		return std::make_shared<GlGpuTimerPool>();
+	}
+
 	auto GlDevice::CreateBuffer(uint64_t size) -> std::shared_ptr<Buffer> {
 		return nullptr;
 	}
 
-	auto GlDevice::CreateRenderTarget() -> std::shared_ptr<RenderTarget> {
-		return nullptr;
+	auto GlDevice::CreateRenderTarget(const RenderTargetDesc& desc) -> std::shared_ptr<RenderTarget> {
+		return std::make_shared<GlRenderTarget>(desc);
 	}
 
 	auto GlDevice::CreateMaterial(
 		std::map<ShaderType, std::shared_ptr<Shader>> shaders,
 		bool isInstanced
 	) -> std::shared_ptr<Material> {
-		return std::make_shared<GlMaterial>(shaders, isInstanced);
+		auto vertex = std::static_pointer_cast<GlShader>(shaders[ShaderType::VERTEX]);
+		auto fragment = std::static_pointer_cast<GlShader>(shaders[ShaderType::FRAGMENT]);
+
+		// Neither program waits for the driver, the material draws with the fallback until its own is linked
+		return std::make_shared<GlMaterial>(
+			shaders,
+			isInstanced,
+			_programCache->Acquire(vertex, fragment),
+			_programCache->AcquireFallback(vertex),
+			_programCache.get(),
+			_state
+		);
 	}
 
 	auto GlDevice::CompileShader(
 		const std::string& shaderSource, 
 		ShaderType type
 	)->std::shared_ptr<Shader> {
-		uint64_t shaderTypeId = 0;
-		switch (type) {
-		case ShaderType::VERTEX:
-			shaderTypeId = GL_VERTEX_SHADER;
-			break;
-		case ShaderType::FRAGMENT:
-			shaderTypeId = GL_FRAGMENT_SHADER;
-			break;
-		default:
-			break;
-		}
-
-		const auto shaderCodeGl = reinterpret_cast<const GLchar*>(shaderSource.c_str());
-
-		auto shaderId = glCreateShader(shaderTypeId);
-		glShaderSource(shaderId, 1, &shaderCodeGl, nullptr);
-		glCompileShader(shaderId);
-
-		GLint iTestReturn;
-		glGetShaderiv(shaderId, GL_COMPILE_STATUS, &iTestReturn);
-		if (iTestReturn == GL_FALSE) {
-			GLchar p_cInfoLog[1024];
-			int32_t iErrorLength;
-			glGetShaderInfoLog(shaderId, 1024, &iErrorLength, p_cInfoLog);
-			glDeleteShader(shaderId);
-
-			throw std::runtime_error("Error compiling shader: " + std::string(p_cInfoLog));
-		}
-
-		return std::make_shared<GlShader>(shaderId, type);
+		// Compilation is deferred until a program of this shader misses the program cache, and then not waited for
+		return std::make_shared<GlShader>(shaderSource, type);
 	}
 
 	auto GlDevice::CreateVertexBuffer(
 		const void* data, 
 		uint64_t size,
-		size_t elemSize
+		size_t elemSize,
+		BufferUsage usage
 	) -> std::shared_ptr<VertexBuffer> {
-		return std::make_shared<GlVertexBuffer>(data, size, elemSize);
+		return std::make_shared<GlVertexBuffer>(data, size, elemSize, usage);
 	}
 
 	auto GlDevice::UpdateVertexBuffer(
 		std::shared_ptr<VertexBuffer> buffer, 
 		const void* data, uint64_t size
 	) -> void {
-
+		// Immediate, the frame's staged updates go through the upload context instead
+		buffer->SetData(data, size);
 	}
 
 	auto GlDevice::CreateIndexBuffer(
 		const uint32_t* indices, 
-		size_t len
+		size_t len,
+		BufferUsage usage
 	) -> std::shared_ptr<IndexBuffer> {
-		auto buffer = std::make_shared<GlIndexBuffer>(indices, len);
+		auto buffer = std::make_shared<GlIndexBuffer>(indices, len, usage);
 
 		return buffer;
 	}
@@ -184,7 +204,8 @@ namespace kyanite::engine::rendering::opengl {
 		std::shared_ptr<IndexBuffer> buffer, 
 		std::vector<uint32_t> indices
 	) -> void {
-
+		buffer->SetData(indices.data(), indices.size() * sizeof(uint32_t));
+		buffer->Resize(indices.size());
 	}
 
 	auto GlDevice::CreateVertexArray(
@@ -205,6 +226,18 @@ namespace kyanite::engine::rendering::opengl {
 		return std::make_shared<GlTexture>(width, height, channels, data);
 	}
 
+	auto GlDevice::CreatePlaceholderTexture() -> std::shared_ptr<Texture> {
+		return std::make_shared<GlTexture>();
+	}
+
 	auto GlDevice::DestroyShader(uint64_t shaderHandle) -> void {
 	}
+
+	auto GlDevice::Stats() const -> FrameStats {
+		return _state->Stats();
+	}
+
+	auto GlDevice::ResetStats() -> void {
+		_state->ResetStats();
+	}
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "rendering/opengl/GlHeadlessDevice.hxx"
+#include "rendering/opengl/GlHeadlessSwapchain.hxx"
+#include "rendering/ImGuiContext.hxx"
+#include "rendering/RenderBackendType.hxx"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <glad/glad.h>
+#include <imgui.h>
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace kyanite::engine::rendering::opengl {
+	namespace {
+		auto HasExtension(const char* extensions, const char* name) -> bool {
+			return extensions != nullptr && std::strstr(extensions, name) != nullptr;
+		}
+
+		auto OpenDisplay() -> EGLDisplay {
+			// Surfaceless needs neither a display server nor a GPU, the default display may need both
+			auto clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+			if (HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+				auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+					eglGetProcAddress("eglGetPlatformDisplayEXT")
+				);
+				if (getPlatformDisplay != nullptr) {
+					auto display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+					if (display != EGL_NO_DISPLAY) {
+						return display;
+					}
+				}
+			}
+
+			return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		}
+	}
+
+	GlHeadlessDevice::GlHeadlessDevice(uint32_t width, uint32_t height) {
+		_display = OpenDisplay();
+		if (_display == EGL_NO_DISPLAY || !eglInitialize(_display, nullptr, nullptr)) {
+			std::cerr << "Failed to initialize EGL: " << eglGetError() << std::endl;
+			throw std::runtime_error("Failed to initialize EGL");
+		}
+
+		if (!HasExtension(eglQueryString(_display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+			eglTerminate(_display);
+			throw std::runtime_error("EGL cannot make a context current without a surface");
+		}
+
+		eglBindAPI(EGL_OPENGL_API);
+
+		const EGLint configAttributes[] = {
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+		EGLConfig config = nullptr;
+		EGLint configCount = 0;
+		eglChooseConfig(_display, configAttributes, &config, 1, &configCount);
+
+		// 4.5 is what llvmpipe exposes, it covers everything the backend uses
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 5,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		_context = eglCreateContext(_display, configCount > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+		if (_context == EGL_NO_CONTEXT) {
+			std::cerr << "Failed to create OpenGL context: " << eglGetError() << std::endl;
+			eglTerminate(_display);
+			throw std::runtime_error("Failed to create OpenGL context");
+		}
+
+		AttachToCurrentThread();
+		Initialize(reinterpret_cast<GLADloadproc>(eglGetProcAddress));
+
+		// Stands in for the default framebuffer, which a surfaceless context does not have
+		_backbuffer = std::make_shared<GlRenderTarget>(RenderTargetDesc { width, height, RenderTargetFormat::RGBA8, true });
+		_state->SetDefaultFramebuffer(_backbuffer->Framebuffer());
+		glBindFramebuffer(GL_FRAMEBUFFER, _backbuffer->Framebuffer());
+		glViewport(0, 0, width, height);
+	}
+
+	GlHeadlessDevice::~GlHeadlessDevice() {
+		// Everything GL has to go while the context is still alive
+		_backbuffer = nullptr;
+		_programCache = nullptr;
+
+		eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(_display, _context);
+		eglTerminate(_display);
+	}
+
+	auto GlHeadlessDevice::AttachToCurrentThread() -> void {
+		if (!eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _context)) {
+			std::cerr << "Failed to make the OpenGL context current: " << eglGetError() << std::endl;
+		}
+	}
+
+	auto GlHeadlessDevice::DetachFromCurrentThread() -> void {
+		eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	}
+
+	auto GlHeadlessDevice::CreateImGuiContext(ImGuiContext* context) -> std::unique_ptr<ImmediateGuiContext> {
+		auto gui = std::make_unique<ImmediateGuiContext>(
+			this->shared_from_this(),
+			nullptr,
+			nullptr,
+			RenderBackendType::OpenGL,
+			_graphicsQueue,
+			context
+		);
+
+		// Without a platform backend nothing else tells ImGui how large the screen is
+		auto& desc = _backbuffer->Desc();
+		ImGui::GetIO().DisplaySize = ImVec2(static_cast<float>(desc.width), static_cast<float>(desc.height));
+
+		return gui;
+	}
+
+	auto GlHeadlessDevice::CreateSwapchain() -> std::unique_ptr<Swapchain> {
+		return std::make_unique<GlHeadlessSwapchain>(_backbuffer);
+	}
+}
@@ -0,0 +1,72 @@
+#include "rendering/opengl/GlHeadlessSwapchain.hxx"
+
+#include <FreeImage.h>
+#include <glad/glad.h>
+
+#include <iostream>
+#include <vector>
+
+namespace kyanite::engine::rendering::opengl {
+	GlHeadlessSwapchain::GlHeadlessSwapchain(std::shared_ptr<GlRenderTarget> backbuffer) :
+		Swapchain(nullptr),
+		_backbuffer(std::move(backbuffer)) {
+		glGenQueries(1, &_timeQuery);
+		glBeginQuery(GL_TIME_ELAPSED, _timeQuery);
+	}
+
+	GlHeadlessSwapchain::~GlHeadlessSwapchain() {
+		glEndQuery(GL_TIME_ELAPSED);
+		glDeleteQueries(1, &_timeQuery);
+	}
+
+	auto GlHeadlessSwapchain::Swap() -> void {
+		glEndQuery(GL_TIME_ELAPSED);
+
+		// Blocks until the frame ran, there is no display that would pace the frames otherwise
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(_timeQuery, GL_QUERY_RESULT, &elapsed);
+		_gpuFrameTime = static_cast<double>(elapsed) / 1'000'000.0;
+
+		if (!_capturePath.empty()) {
+			Capture();
+			_capturePath.clear();
+		}
+
+		glBeginQuery(GL_TIME_ELAPSED, _timeQuery);
+	}
+
+	auto GlHeadlessSwapchain::Capture() -> void {
+		auto& desc = _backbuffer->Desc();
+		std::vector<uint8_t> pixels(static_cast<size_t>(desc.width) * desc.height * 4);
+
+		// BGRA is the byte order FreeImage keeps its pixels in, and both start at the bottom row
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glGetTextureImage(
+			_backbuffer->ColorTexture()->ID(),
+			0,
+			GL_BGRA,
+			GL_UNSIGNED_BYTE,
+			static_cast<GLsizei>(pixels.size()),
+			pixels.data()
+		);
+
+		auto bitmap = FreeImage_ConvertFromRawBits(
+			pixels.data(),
+			desc.width,
+			desc.height,
+			desc.width * 4,
+			32,
+			FI_RGBA_RED_MASK,
+			FI_RGBA_GREEN_MASK,
+			FI_RGBA_BLUE_MASK,
+			FALSE
+		);
+		if (bitmap == nullptr || !FreeImage_Save(FIF_PNG, bitmap, _capturePath.string().c_str())) {
+			std::cerr << "Failed to write frame capture " << _capturePath << std::endl;
+		}
+
+		if (bitmap != nullptr) {
+			FreeImage_Unload(bitmap);
+		}
+	}
+}
@@ -2,11 +2,11 @@
 #include <iostream>
 
 namespace kyanite::engine::rendering::opengl {
-	GlIndexBuffer::GlIndexBuffer(const uint32_t* indices, size_t len) : IndexBuffer(len) {
+	GlIndexBuffer::GlIndexBuffer(const uint32_t* indices, size_t len, BufferUsage usage) : IndexBuffer(len, usage) {
 		_id = 0;
 		glGenBuffers(1, &_id);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _id);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, len * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, len * sizeof(uint32_t), indices, GlBufferUsage(usage));
 
 		// Check for errors
 		GLenum error = glGetError();
@@ -0,0 +1,317 @@
+#include "rendering/opengl/GlProgramCache.hxx"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr uint32_t ProgramMagic = 0x4752504B; // "KPRG"
+
+	// KHR_parallel_shader_compile, which the loader predates. The ARB version uses the same values.
+	constexpr GLenum CompletionStatus = 0x91B1;
+	using MaxShaderCompilerThreadsProc = void (*)(GLuint count);
+
+	// Drawn while the real program links, it declares no inputs so it links against any vertex shader
+	constexpr const char* FallbackFragmentSource = R"(#version 450 core
+out vec4 FragColor;
+
+void main() {
+	FragColor = vec4(0.5, 0.5, 0.5, 1.0);
+}
+)";
+
+	struct ProgramHeader {
+		uint32_t magic;
+		uint32_t binaryFormat;
+		uint32_t length;
+	};
+
+	auto GlString(GLenum name) -> std::string {
+		auto value = reinterpret_cast<const char*>(glGetString(name));
+		return value != nullptr ? value : "";
+	}
+
+	auto HasExtension(const char* name) -> bool {
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint index = 0; index < count; index++) {
+			auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(index)));
+			if (extension != nullptr && std::strcmp(extension, name) == 0) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+namespace kyanite::engine::rendering::opengl {
+	GlProgramCache::GlProgramCache(const std::filesystem::path& directory, GLADloadproc loader) {
+		_fallbackFragment = std::make_shared<GlShader>(FallbackFragmentSource, ShaderType::FRAGMENT);
+
+		MaxShaderCompilerThreadsProc maxThreads = nullptr;
+		if (HasExtension("GL_KHR_parallel_shader_compile")) {
+			maxThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loader("glMaxShaderCompilerThreadsKHR"));
+		}
+		else if (HasExtension("GL_ARB_parallel_shader_compile")) {
+			maxThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loader("glMaxShaderCompilerThreadsARB"));
+		}
+		if (maxThreads != nullptr) {
+			// Lets the driver pick the number of threads
+			maxThreads(0xFFFFFFFF);
+			_parallel = true;
+		}
+
+		GLint formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		if (directory.empty() || formats == 0) {
+			return;
+		}
+
+		// Binaries are only valid for the driver that produced them
+		auto driver = GlString(GL_VENDOR) + "|" + GlString(GL_RENDERER) + "|" + GlString(GL_VERSION);
+		char name[17];
+		std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(GlShader::HashSource(driver)));
+
+		std::error_code error;
+		std::filesystem::create_directories(directory / name, error);
+		if (!error) {
+			_directory = directory / name;
+		}
+	}
+
+	GlProgramCache::~GlProgramCache() {
+		for (auto& [key, program] : _programs) {
+			glDeleteProgram(program->id);
+		}
+	}
+
+	auto GlProgramCache::Acquire(const std::shared_ptr<GlShader>& vertex, const std::shared_ptr<GlShader>& fragment) -> std::shared_ptr<const GlProgram> {
+		// Order matters, so the fragment hash is mixed in rather than xored
+		auto key = (vertex->sourceHash * 0x100000001b3) ^ fragment->sourceHash;
+		if (auto program = _programs.find(key); program != _programs.end()) {
+			return program->second;
+		}
+
+		auto program = std::make_shared<GlProgram>();
+		program->key = key;
+		_programs[key] = program;
+
+		program->id = Load(key);
+		if (program->id != 0) {
+			program->layout = Reflect(program->id);
+			program->ready = true;
+			return program;
+		}
+
+		// Linked from source, the program is checked, reflected and stored once the driver is done with it
+		program->id = Link(vertex, fragment);
+		_pending[key] = PendingProgram { vertex, fragment };
+
+		return program;
+	}
+
+	auto GlProgramCache::AcquireFallback(const std::shared_ptr<GlShader>& vertex) -> std::shared_ptr<const GlProgram> {
+		return Acquire(vertex, _fallbackFragment);
+	}
+
+	auto GlProgramCache::Poll(const GlProgram& program) -> bool {
+		if (program.ready || program.failed) {
+			return program.ready;
+		}
+
+		if (_parallel) {
+			GLint completed = GL_FALSE;
+			glGetProgramiv(program.id, CompletionStatus, &completed);
+			if (completed == GL_FALSE) {
+				return false;
+			}
+		}
+
+		auto pending = _pending.find(program.key);
+		auto stored = _programs.find(program.key);
+		if (pending == _pending.end() || stored == _programs.end()) {
+			return false;
+		}
+
+		Finish(*stored->second, pending->second);
+		_pending.erase(pending);
+
+		return program.ready;
+	}
+
+	auto GlProgramCache::Load(uint64_t key) -> GLuint {
+		if (_directory.empty()) {
+			return 0;
+		}
+
+		std::ifstream file(PathOf(key), std::ios::binary);
+		ProgramHeader header = {};
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != ProgramMagic) {
+			return 0;
+		}
+
+		std::vector<char> binary(header.length);
+		if (!file.read(binary.data(), binary.size())) {
+			return 0;
+		}
+
+		auto program = glCreateProgram();
+		glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+		// The driver may still reject a binary it wrote itself, then the pair is linked from source again
+		GLint success = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (success == GL_FALSE) {
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		return program;
+	}
+
+	auto GlProgramCache::Link(const std::shared_ptr<GlShader>& vertex, const std::shared_ptr<GlShader>& fragment) -> GLuint {
+		GLuint shaderProgram = glCreateProgram();
+		glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glAttachShader(shaderProgram, static_cast<GLuint>(vertex->Compile()));
+		glAttachShader(shaderProgram, static_cast<GLuint>(fragment->Compile()));
+
+		// Only issued here, checking the status right away would wait for the driver to finish
+		glLinkProgram(shaderProgram);
+
+		return shaderProgram;
+	}
+
+	auto GlProgramCache::Finish(GlProgram& program, const PendingProgram& pending) -> void {
+		auto compiled = pending.vertex->CheckStatus();
+		compiled = pending.fragment->CheckStatus() && compiled;
+
+		// Check linking status
+		GLint success = GL_FALSE;
+		glGetProgramiv(program.id, GL_LINK_STATUS, &success);
+		if (compiled && !success) {
+			GLchar infoLog[512];
+			glGetProgramInfoLog(program.id, sizeof(infoLog), NULL, infoLog);
+			std::cerr << "Shader program linking failed:\n" << infoLog << std::endl;
+		}
+
+		// The program keeps its own copy of the compiled code
+		glDetachShader(program.id, static_cast<GLuint>(pending.vertex->shaderId));
+		glDetachShader(program.id, static_cast<GLuint>(pending.fragment->shaderId));
+
+		if (!compiled || !success) {
+			program.failed = true;
+			return;
+		}
+
+		program.layout = Reflect(program.id);
+		Store(program.key, program.id);
+		program.ready = true;
+	}
+
+	auto GlProgramCache::Store(uint64_t key, GLuint program) -> void {
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if (_directory.empty() || linked == GL_FALSE) {
+			return;
+		}
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0) {
+			return;
+		}
+
+		std::vector<char> binary(length);
+		GLenum binaryFormat = 0;
+		glGetProgramBinary(program, length, &length, &binaryFormat, binary.data());
+
+		// Write to a temporary file first, a crash mid write must not leave a truncated binary behind
+		auto path = PathOf(key);
+		auto temporary = path;
+		temporary += ".tmp";
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			ProgramHeader header = { ProgramMagic, binaryFormat, static_cast<uint32_t>(length) };
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(binary.data(), length);
+			if (!file) {
+				return;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary, path, error);
+	}
+
+	auto GlProgramCache::Reflect(GLuint program) -> GlProgramLayout {
+		GlProgramLayout layout;
+
+		auto blockIndex = glGetUniformBlockIndex(program, MaterialBlockName);
+		if (blockIndex != GL_INVALID_INDEX) {
+			glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &layout.blockSize);
+			glUniformBlockBinding(program, blockIndex, MaterialBlockBinding);
+		}
+
+		GLint uniformCount = 0;
+		GLint maxNameLength = 0;
+		glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+		std::vector<GLchar> buffer(std::max(maxNameLength, 1));
+		for (GLuint index = 0; index < static_cast<GLuint>(uniformCount); index++) {
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(program, index, static_cast<GLsizei>(buffer.size()), &length, &size, &type, buffer.data());
+			std::string name(buffer.data(), length);
+
+			// Arrays are reported by their first element
+			if (auto bracket = name.find('['); bracket != std::string::npos) {
+				name.resize(bracket);
+			}
+
+			GLint uniformBlock = -1;
+			glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &uniformBlock);
+			if (uniformBlock != -1) {
+				if (static_cast<GLuint>(uniformBlock) != blockIndex) {
+					continue;
+				}
+
+				// Members of a block with an instance name are reported as Instance.member
+				if (auto dot = name.rfind('.'); dot != std::string::npos) {
+					name = name.substr(dot + 1);
+				}
+
+				GLint offset = 0;
+				glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &offset);
+				layout.fields[name] = GlProgramLayout::Field { offset, type };
+				continue;
+			}
+
+			if (type == GL_SAMPLER_2D) {
+				// Units are fixed per program, so they are assigned once here and never touched while drawing
+				auto unit = static_cast<GLint>(layout.samplers.size());
+				glProgramUniform1i(program, glGetUniformLocation(program, name.c_str()), unit);
+				layout.samplers.push_back({ name, unit });
+			}
+		}
+
+		layout.model = glGetUniformLocation(program, "model");
+		layout.view = glGetUniformLocation(program, "view");
+		layout.projection = glGetUniformLocation(program, "projection");
+		layout.uvRect = glGetUniformLocation(program, "uvRect");
+
+		return layout;
+	}
+
+	auto GlProgramCache::PathOf(uint64_t key) const -> std::filesystem::path {
+		char name[21];
+		std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+		return _directory / name;
+	}
+}
@@ -0,0 +1,45 @@
+#include "rendering/opengl/GlRenderTarget.hxx"
+
+#include <glad/glad.h>
+
+#include <iostream>
+
+namespace kyanite::engine::rendering::opengl {
+	namespace {
+		auto GlInternalFormat(RenderTargetFormat format) -> GLenum {
+			switch (format) {
+			case RenderTargetFormat::RGBA16F:
+				return GL_RGBA16F;
+			case RenderTargetFormat::RGBA8:
+			default:
+				return GL_RGBA8;
+			}
+		}
+	}
+
+	GlRenderTarget::GlRenderTarget(const RenderTargetDesc& desc) : RenderTarget(0, desc) {
+		_color = std::make_shared<GlTexture>(desc.width, desc.height, GlInternalFormat(desc.format));
+
+		// Named, so the framebuffer binding the state cache shadows stays untouched
+		glCreateFramebuffers(1, &_framebuffer);
+		glNamedFramebufferTexture(_framebuffer, GL_COLOR_ATTACHMENT0, _color->ID(), 0);
+
+		if (desc.depth) {
+			glCreateRenderbuffers(1, &_depth);
+			glNamedRenderbufferStorage(_depth, GL_DEPTH24_STENCIL8, desc.width, desc.height);
+			glNamedFramebufferRenderbuffer(_framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, _depth);
+		}
+
+		auto status = glCheckNamedFramebufferStatus(_framebuffer, GL_FRAMEBUFFER);
+		if (status != GL_FRAMEBUFFER_COMPLETE) {
+			std::cerr << "Render target " << desc.width << "x" << desc.height << " is incomplete: " << status << std::endl;
+		}
+	}
+
+	GlRenderTarget::~GlRenderTarget() {
+		glDeleteFramebuffers(1, &_framebuffer);
+		if (_depth != 0) {
+			glDeleteRenderbuffers(1, &_depth);
+		}
+	}
+}
@@ -0,0 +1,285 @@
+#include "rendering/opengl/GlStateCache.hxx"
+
+namespace kyanite::engine::rendering::opengl {
+	auto GlStateCache::Reset() -> void {
+		_program = Unknown;
+		_vertexArray = Unknown;
+		_arrayBuffer = Unknown;
+		_uniformBuffer = Unknown;
+		_framebuffer = Unknown;
+		_uniformBindings.fill(Unknown);
+		_activeTextureUnit = Unknown;
+		_textures.fill(Unknown);
+		_blend = -1;
+		_blendSource = UnknownEnum;
+		_blendDestination = UnknownEnum;
+		_depthTest = -1;
+		_depthFunction = UnknownEnum;
+		_depthWrite = -1;
+		_depthBias = std::numeric_limits<float>::quiet_NaN();
+		_vertexArrays.clear();
+	}
+
+	auto GlStateCache::UseProgram(GLuint program) -> void {
+		if (_program == program) {
+			Skip();
+			return;
+		}
+
+		glUseProgram(program);
+		_program = program;
+		Issue();
+	}
+
+	auto GlStateCache::BindVertexArray(GLuint vertexArray) -> void {
+		if (_vertexArray == vertexArray) {
+			Skip();
+			return;
+		}
+
+		glBindVertexArray(vertexArray);
+		_vertexArray = vertexArray;
+		Issue();
+	}
+
+	auto GlStateCache::BindBuffer(GLenum target, GLuint buffer) -> void {
+		GLuint* bound = nullptr;
+		switch (target) {
+		case GL_ARRAY_BUFFER:
+			bound = &_arrayBuffer;
+			break;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			bound = &CurrentVertexArray().elementBuffer;
+			break;
+		case GL_UNIFORM_BUFFER:
+			bound = &_uniformBuffer;
+			break;
+		default:
+			// Targets nobody shadows always go through
+			glBindBuffer(target, buffer);
+			Issue();
+			return;
+		}
+
+		if (*bound == buffer) {
+			Skip();
+			return;
+		}
+
+		glBindBuffer(target, buffer);
+		*bound = buffer;
+		Issue();
+	}
+
+	auto GlStateCache::BindUniformBuffer(GLuint binding, GLuint buffer) -> void {
+		if (binding < _uniformBindings.size() && _uniformBindings[binding] == buffer) {
+			Skip();
+			return;
+		}
+
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+		if (binding < _uniformBindings.size()) {
+			_uniformBindings[binding] = buffer;
+		}
+		// Binding a range also replaces the generic binding point
+		_uniformBuffer = buffer;
+		Issue();
+	}
+
+	auto GlStateCache::BindTexture(GLuint unit, GLuint texture) -> void {
+		if (unit < _textures.size() && _textures[unit] == texture) {
+			Skip();
+			return;
+		}
+
+		if (_activeTextureUnit != unit) {
+			glActiveTexture(GL_TEXTURE0 + unit);
+			_activeTextureUnit = unit;
+			Issue();
+		}
+
+		glBindTexture(GL_TEXTURE_2D, texture);
+		if (unit < _textures.size()) {
+			_textures[unit] = texture;
+		}
+		Issue();
+	}
+
+	auto GlStateCache::EditTexture(GLuint texture) -> void {
+		// Texture calls act on the active unit, which a skipped bind leaves wherever the last real bind put it
+		if (_activeTextureUnit != 0) {
+			glActiveTexture(GL_TEXTURE0);
+			_activeTextureUnit = 0;
+			Issue();
+		}
+
+		BindTexture(0, texture);
+	}
+
+	auto GlStateCache::BindFramebuffer(GLuint framebuffer) -> void {
+		if (_framebuffer == framebuffer) {
+			Skip();
+			return;
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		_framebuffer = framebuffer;
+		Issue();
+	}
+
+	auto GlStateCache::SetBlend(bool enabled, GLenum source, GLenum destination) -> void {
+		if (_blend != static_cast<int8_t>(enabled)) {
+			if (enabled) {
+				glEnable(GL_BLEND);
+			}
+			else {
+				glDisable(GL_BLEND);
+			}
+			_blend = enabled;
+			Issue();
+		}
+		else {
+			Skip();
+		}
+
+		if (!enabled) {
+			return;
+		}
+
+		if (_blendSource == source && _blendDestination == destination) {
+			Skip();
+			return;
+		}
+
+		glBlendFunc(source, destination);
+		_blendSource = source;
+		_blendDestination = destination;
+		Issue();
+	}
+
+	auto GlStateCache::SetDepthTest(bool enabled, GLenum function) -> void {
+		if (_depthTest != static_cast<int8_t>(enabled)) {
+			if (enabled) {
+				glEnable(GL_DEPTH_TEST);
+			}
+			else {
+				glDisable(GL_DEPTH_TEST);
+			}
+			_depthTest = enabled;
+			Issue();
+		}
+		else {
+			Skip();
+		}
+
+		if (!enabled) {
+			return;
+		}
+
+		if (_depthFunction == function) {
+			Skip();
+			return;
+		}
+
+		glDepthFunc(function);
+		_depthFunction = function;
+		Issue();
+	}
+
+	auto GlStateCache::SetDepthWrite(bool enabled) -> void {
+		if (_depthWrite == static_cast<int8_t>(enabled)) {
+			Skip();
+			return;
+		}
+
+		glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+		_depthWrite = enabled;
+		Issue();
+	}
+
+	auto GlStateCache::SetDepthBias(float bias) -> void {
+		if (_depthBias == bias) {
+			Skip();
+			return;
+		}
+
+		// Sprites face the camera, so only the constant part of the offset is used
+		if (bias == 0.0f) {
+			glDisable(GL_POLYGON_OFFSET_FILL);
+		}
+		else {
+			glEnable(GL_POLYGON_OFFSET_FILL);
+			glPolygonOffset(0.0f, bias);
+		}
+		_depthBias = bias;
+		Issue();
+	}
+
+	auto GlStateCache::EnableVertexAttribute(GLuint index, bool enabled) -> void {
+		auto& attribute = CurrentVertexArray().attributes[index];
+		if (attribute.enabled == static_cast<int8_t>(enabled)) {
+			Skip();
+			return;
+		}
+
+		if (enabled) {
+			glEnableVertexAttribArray(index);
+		}
+		else {
+			glDisableVertexAttribArray(index);
+		}
+		attribute.enabled = enabled;
+		Issue();
+	}
+
+	auto GlStateCache::SetVertexAttributeDivisor(GLuint index, GLuint divisor) -> void {
+		auto& attribute = CurrentVertexArray().attributes[index];
+		if (attribute.divisor == divisor) {
+			Skip();
+			return;
+		}
+
+		glVertexAttribDivisor(index, divisor);
+		attribute.divisor = divisor;
+		Issue();
+	}
+
+	auto GlStateCache::SetVertexAttributePointer(
+		GLuint index,
+		GLuint buffer,
+		GLint size,
+		GLsizei stride,
+		size_t offset,
+		GLenum type,
+		bool normalized
+	) -> void {
+		auto& attribute = CurrentVertexArray().attributes[index];
+		if (
+			attribute.buffer == buffer &&
+			attribute.size == size &&
+			attribute.type == type &&
+			attribute.stride == stride &&
+			attribute.offset == offset &&
+			attribute.normalized == normalized
+		) {
+			Skip();
+			return;
+		}
+
+		// The pointer captures whatever is bound to the array buffer target right now
+		BindBuffer(GL_ARRAY_BUFFER, buffer);
+		glVertexAttribPointer(index, size, type, normalized ? GL_TRUE : GL_FALSE, stride, reinterpret_cast<void*>(offset));
+		attribute.buffer = buffer;
+		attribute.size = size;
+		attribute.type = type;
+		attribute.stride = stride;
+		attribute.offset = offset;
+		attribute.normalized = normalized;
+		Issue();
+	}
+
+	auto GlStateCache::CurrentVertexArray() -> VertexArrayState& {
+		// Until the first bind this shadows whatever vertex array was bound when the queue started
+		return _vertexArrays[_vertexArray];
+	}
+}
@@ -6,12 +6,13 @@ namespace kyanite::engine::rendering::opengl {
 	GlVertexBuffer::GlVertexBuffer(
 		const void* data, 
 		size_t size, 
-		size_t elemSize
-	) : VertexBuffer(size) {
+		size_t elemSize,
+		BufferUsage usage
+	) : VertexBuffer(size, usage) {
 		_id = 0;
 		glGenBuffers(1, &_id);
 		glBindBuffer(GL_ARRAY_BUFFER, _id);
-		glBufferData(GL_ARRAY_BUFFER, size * elemSize, data, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, size * elemSize, data, GlBufferUsage(usage));
 
 		// Check for errors
 		GLenum error = glGetError();
@@ -0,0 +1,108 @@
+#include "rendering/Culling.hxx"
+#include <gtest/gtest.h>
+#include <vector>
+
+using kyanite::engine::rendering::Bounds;
+using kyanite::engine::rendering::CullBounds;
+using kyanite::engine::rendering::Frustum;
+
+namespace {
+    // An identity view-projection leaves the clip cube, -1 to 1 on every axis
+    auto ClipCube() -> Frustum {
+        return Frustum::FromViewProjection(glm::mat4(1.0f));
+    }
+
+    auto MakeBounds(glm::vec3 min, glm::vec3 max) -> Bounds {
+        Bounds bounds;
+        bounds.Encapsulate(min);
+        bounds.Encapsulate(max);
+        return bounds;
+    }
+
+    auto Translation(glm::vec3 offset) -> glm::mat4 {
+        auto model = glm::mat4(1.0f);
+        model[3] = glm::vec4(offset, 1.0f);
+        return model;
+    }
+
+    auto IsVisible(const Frustum& frustum, const glm::mat4& model, const Bounds& bounds) -> bool {
+        uint8_t visible = 0xFF;
+        CullBounds(frustum, &model, &bounds, 1, &visible);
+        return visible == 1;
+    }
+}
+
+TEST(Culling, TestBoxInsideIsVisible) {
+    auto frustum = ClipCube();
+    auto bounds = MakeBounds(glm::vec3(-0.5f), glm::vec3(0.5f));
+
+    EXPECT_TRUE(IsVisible(frustum, glm::mat4(1.0f), bounds));
+}
+
+TEST(Culling, TestBoxOutsideEveryPlaneIsCulled) {
+    auto frustum = ClipCube();
+    auto bounds = MakeBounds(glm::vec3(-0.25f), glm::vec3(0.25f));
+
+    // One box past each of the six planes, the last two are only tested by the upper four lanes
+    const glm::vec3 offsets[] = {
+        { -2.0f, 0.0f, 0.0f }, { 2.0f, 0.0f, 0.0f },
+        { 0.0f, -2.0f, 0.0f }, { 0.0f, 2.0f, 0.0f },
+        { 0.0f, 0.0f, -2.0f }, { 0.0f, 0.0f, 2.0f }
+    };
+    for (auto& offset : offsets) {
+        EXPECT_FALSE(IsVisible(frustum, Translation(offset), bounds));
+    }
+}
+
+TEST(Culling, TestBoxStraddlingAPlaneIsVisible) {
+    auto frustum = ClipCube();
+    auto bounds = MakeBounds(glm::vec3(-0.5f), glm::vec3(0.5f));
+
+    EXPECT_TRUE(IsVisible(frustum, Translation({ 1.25f, 0.0f, 0.0f }), bounds));
+    EXPECT_TRUE(IsVisible(frustum, Translation({ 0.0f, -1.25f, 0.0f }), bounds));
+    EXPECT_TRUE(IsVisible(frustum, Translation({ 0.0f, 0.0f, 1.25f }), bounds));
+    // Just past the plane is outside again
+    EXPECT_FALSE(IsVisible(frustum, Translation({ 1.75f, 0.0f, 0.0f }), bounds));
+}
+
+TEST(Culling, TestModelScaleAppliesToTheBox) {
+    auto frustum = ClipCube();
+    auto bounds = MakeBounds(glm::vec3(-0.5f), glm::vec3(0.5f));
+
+    // Centred at 3, the box only reaches back into the cube once it is scaled up
+    auto model = Translation({ 3.0f, 0.0f, 0.0f });
+    EXPECT_FALSE(IsVisible(frustum, model, bounds));
+
+    model[0] = glm::vec4(5.0f, 0.0f, 0.0f, 0.0f);
+    EXPECT_TRUE(IsVisible(frustum, model, bounds));
+}
+
+TEST(Culling, TestEmptyBoundsAreAlwaysVisible) {
+    auto frustum = ClipCube();
+
+    EXPECT_FALSE(Bounds().IsValid());
+    EXPECT_TRUE(IsVisible(frustum, Translation({ 100.0f, 100.0f, 100.0f }), Bounds()));
+}
+
+TEST(Culling, TestEveryItemOfAnUnevenCountIsWritten) {
+    auto frustum = ClipCube();
+    auto bounds = MakeBounds(glm::vec3(-0.25f), glm::vec3(0.25f));
+
+    // Counts around the four planes a register holds, with items alternating between inside and outside
+    for (size_t count : { 1u, 3u, 5u, 7u, 9u, 13u }) {
+        std::vector<glm::mat4> models;
+        std::vector<Bounds> boxes(count, bounds);
+        for (size_t x = 0; x < count; x++) {
+            models.push_back(Translation({ x % 2 == 0 ? 0.0f : 4.0f, 0.0f, 0.0f }));
+        }
+
+        // One extra byte to catch writes past the end
+        std::vector<uint8_t> visible(count + 1, 0xAB);
+        CullBounds(frustum, models.data(), boxes.data(), count, visible.data());
+
+        for (size_t x = 0; x < count; x++) {
+            EXPECT_EQ(visible[x], x % 2 == 0 ? 1 : 0) << "item " << x << " of " << count;
+        }
+        EXPECT_EQ(visible[count], 0xAB);
+    }
+}
@@ -0,0 +1,71 @@
+#include "rendering/DepthMode.hxx"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+
+using namespace kyanite::engine::rendering;
+
+namespace {
+    // The smallest difference a 24 bit depth buffer resolves, what one unit of bias moves a fragment by
+    constexpr double DepthUnit = 1.0 / (1 << 24);
+    // Where sprites at z 0 land in the depth range of the default camera
+    constexpr double SpriteDepth = 0.9 / 99.9;
+
+    // One texel of the depth buffer, tested and written the way SetDepthMode configures GL
+    struct DepthTexel {
+        uint32_t stored = (1u << 24) - 1;
+
+        // Biased and quantised like the rasteriser does it
+        static auto Quantise(double depth, uint16_t layer) -> uint32_t {
+            return static_cast<uint32_t>(std::lround((depth + LayerDepthBias(layer) * DepthUnit) / DepthUnit));
+        }
+
+        // Returns whether the fragment is drawn
+        auto Draw(DepthMode mode, double depth, uint16_t layer) -> bool {
+            auto fragment = Quantise(depth, layer);
+            switch (mode) {
+            case DepthMode::Disabled:
+                return true;
+            case DepthMode::TestAndWrite:
+                if (fragment < stored) {
+                    stored = fragment;
+                    return true;
+                }
+                return false;
+            case DepthMode::TestOnly:
+                return fragment <= stored;
+            }
+            return false;
+        }
+    };
+}
+
+TEST(DepthMode, TestOpaqueSpriteOnAHigherLayerCoversBlendedOnesBelow) {
+    // The opaque pass runs first, then the blended one from the lowest layer up
+    for (uint16_t opaqueLayer : { 1, 5, 1000, 65535 }) {
+        DepthTexel texel;
+        ASSERT_TRUE(texel.Draw(DepthMode::TestAndWrite, SpriteDepth, opaqueLayer));
+
+        EXPECT_FALSE(texel.Draw(DepthMode::TestOnly, SpriteDepth, 0)) << "opaque on layer " << opaqueLayer;
+        EXPECT_FALSE(texel.Draw(DepthMode::TestOnly, SpriteDepth, opaqueLayer - 1)) << "opaque on layer " << opaqueLayer;
+        // The same layer and the ones above are still drawn on top
+        EXPECT_TRUE(texel.Draw(DepthMode::TestOnly, SpriteDepth, opaqueLayer)) << "opaque on layer " << opaqueLayer;
+        if (opaqueLayer < 65535) {
+            EXPECT_TRUE(texel.Draw(DepthMode::TestOnly, SpriteDepth, opaqueLayer + 1)) << "opaque on layer " << opaqueLayer;
+        }
+    }
+}
+
+TEST(DepthMode, TestOpaqueLayersHideLowerOnesInAnyOrder) {
+    // Opaque draws are sorted highest layer first, but the bias alone decides, whichever is drawn first
+    DepthTexel front;
+    ASSERT_TRUE(front.Draw(DepthMode::TestAndWrite, SpriteDepth, 3));
+    EXPECT_FALSE(front.Draw(DepthMode::TestAndWrite, SpriteDepth, 2));
+
+    DepthTexel back;
+    ASSERT_TRUE(back.Draw(DepthMode::TestAndWrite, SpriteDepth, 2));
+    EXPECT_TRUE(back.Draw(DepthMode::TestAndWrite, SpriteDepth, 3));
+
+    // Within a layer the first one drawn wins
+    EXPECT_FALSE(back.Draw(DepthMode::TestAndWrite, SpriteDepth, 3));
+}
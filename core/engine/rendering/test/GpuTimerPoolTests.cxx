@@ -0,0 +1,109 @@
+#include "rendering/GpuTimerPool.hxx"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+using kyanite::engine::rendering::GpuTimerPool;
+
+namespace {
+    // Queries complete in the order they were written, like timestamps on one GPU queue
+    class FakeTimerPool : public GpuTimerPool {
+    public:
+        auto Write(uint32_t query, uint64_t nanoseconds) -> void {
+            ASSERT_NE(query, InvalidQuery);
+            _written.push_back(query);
+            _timestamps[query] = nanoseconds;
+        }
+
+        // Lets the first count written queries complete
+        auto Complete(size_t count) -> void {
+            _completed = std::min(count, _written.size());
+        }
+
+        auto CompleteAll() -> void {
+            _completed = _written.size();
+        }
+
+        // Reads of a timestamp that is not there yet, which would wait for the GPU
+        size_t blockingReads = 0;
+
+    protected:
+        auto IsAvailable(uint32_t query) -> bool override {
+            auto written = std::find(_written.begin(), _written.end(), query);
+            return written != _written.end() && static_cast<size_t>(written - _written.begin()) < _completed;
+        }
+
+        auto Timestamp(uint32_t query) -> uint64_t override {
+            if (!IsAvailable(query)) {
+                blockingReads++;
+            }
+            return _timestamps[query];
+        }
+
+    private:
+        std::vector<uint32_t> _written;
+        std::map<uint32_t, uint64_t> _timestamps;
+        size_t _completed = 0;
+    };
+
+    // A frame scope around a pass scope, the frame scope ends last but has the lower query
+    auto RecordNestedFrame(FakeTimerPool& pool) -> void {
+        pool.BeginFrame();
+        pool.Write(pool.BeginScope("Frame"), 1'000'000);
+        pool.Write(pool.BeginScope("Scene"), 2'000'000);
+        pool.Write(pool.EndScope(), 5'000'000);
+        pool.Write(pool.EndScope(), 7'000'000);
+    }
+
+    // Moves on until the recorded frame is read back
+    auto ReadBack(FakeTimerPool& pool) -> void {
+        for (uint32_t x = 0; x < GpuTimerPool::FrameLatency; x++) {
+            pool.BeginFrame();
+        }
+    }
+}
+
+TEST(GpuTimerPool, TestNestedScopesAreReadInOpeningOrder) {
+    FakeTimerPool pool;
+    RecordNestedFrame(pool);
+    pool.CompleteAll();
+    ReadBack(pool);
+
+    auto& results = pool.Results();
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].name, "Frame");
+    EXPECT_DOUBLE_EQ(results[0].milliseconds, 6.0);
+    EXPECT_EQ(results[1].name, "Scene");
+    EXPECT_DOUBLE_EQ(results[1].milliseconds, 3.0);
+    EXPECT_EQ(pool.blockingReads, 0u);
+}
+
+TEST(GpuTimerPool, TestFrameIsDroppedUntilTheOuterScopeCompletes) {
+    FakeTimerPool pool;
+    RecordNestedFrame(pool);
+
+    // Everything but the end of the frame scope, which was written last
+    pool.Complete(3);
+    ReadBack(pool);
+
+    EXPECT_TRUE(pool.Results().empty());
+    EXPECT_EQ(pool.blockingReads, 0u);
+}
+
+TEST(GpuTimerPool, TestScopesPastTheLimitAreNotTimed) {
+    FakeTimerPool pool;
+    pool.BeginFrame();
+    for (uint32_t x = 0; x < GpuTimerPool::MaxScopes; x++) {
+        pool.Write(pool.BeginScope("Scope" + std::to_string(x)), x);
+        pool.Write(pool.EndScope(), x + 1);
+    }
+
+    EXPECT_EQ(pool.BeginScope("Untimed"), GpuTimerPool::InvalidQuery);
+    EXPECT_EQ(pool.EndScope(), GpuTimerPool::InvalidQuery);
+
+    pool.CompleteAll();
+    ReadBack(pool);
+    EXPECT_EQ(pool.Results().size(), GpuTimerPool::MaxScopes);
+}
@@ -0,0 +1,80 @@
+#include "rendering/RangeAllocator.hxx"
+#include <gtest/gtest.h>
+
+using kyanite::engine::rendering::RangeAllocator;
+
+TEST(RangeAllocator, TestAllocationsArePlacedFirstFit) {
+    RangeAllocator allocator(100);
+
+    EXPECT_EQ(allocator.Allocate(10), 0u);
+    EXPECT_EQ(allocator.Allocate(20), 10u);
+    EXPECT_EQ(allocator.Allocate(30), 30u);
+    EXPECT_EQ(allocator.Available(), 40u);
+
+    // The hole at 10 is the first one large enough, even though the tail is larger
+    allocator.Free(10, 20);
+    EXPECT_EQ(allocator.Allocate(15), 10u);
+    // The rest of the hole is too small, so the next one goes to the tail
+    EXPECT_EQ(allocator.Allocate(8), 60u);
+    EXPECT_EQ(allocator.Allocate(5), 25u);
+}
+
+TEST(RangeAllocator, TestAllocationFailsWithoutALargeEnoughRange) {
+    RangeAllocator allocator(64);
+
+    EXPECT_FALSE(allocator.Allocate(0).has_value());
+    EXPECT_FALSE(allocator.Allocate(65).has_value());
+
+    // Half of the capacity is free, but split into two ranges of 16
+    EXPECT_EQ(allocator.Allocate(16), 0u);
+    EXPECT_EQ(allocator.Allocate(16), 16u);
+    EXPECT_EQ(allocator.Allocate(16), 32u);
+    allocator.Free(16, 16);
+    EXPECT_EQ(allocator.Available(), 32u);
+    EXPECT_FALSE(allocator.Allocate(32).has_value());
+}
+
+TEST(RangeAllocator, TestFreeMergesWithBothNeighbours) {
+    RangeAllocator allocator(30);
+    auto first = allocator.Allocate(10);
+    auto second = allocator.Allocate(10);
+    auto third = allocator.Allocate(10);
+    ASSERT_TRUE(first && second && third);
+
+    // Freeing the outer ranges leaves two holes, the middle one joins them into one
+    allocator.Free(*first, 10);
+    allocator.Free(*third, 10);
+    EXPECT_FALSE(allocator.Allocate(20).has_value());
+
+    allocator.Free(*second, 10);
+    EXPECT_EQ(allocator.Available(), 30u);
+    EXPECT_EQ(allocator.Allocate(30), 0u);
+}
+
+TEST(RangeAllocator, TestFragmentedRangesMergeBackIntoOneBlock) {
+    constexpr uint32_t Count = 64;
+    RangeAllocator allocator(Count * 4);
+
+    uint32_t offsets[Count];
+    for (uint32_t x = 0; x < Count; x++) {
+        auto offset = allocator.Allocate(4);
+        ASSERT_TRUE(offset.has_value());
+        offsets[x] = *offset;
+    }
+    EXPECT_EQ(allocator.Available(), 0u);
+
+    // Every other range first, so no free range has a free neighbour
+    for (uint32_t x = 0; x < Count; x += 2) {
+        allocator.Free(offsets[x], 4);
+    }
+    EXPECT_EQ(allocator.Available(), Count * 2);
+    EXPECT_FALSE(allocator.Allocate(5).has_value());
+
+    // Then the rest from the back, every free bridges two holes
+    for (uint32_t x = Count; x > 0; x -= 2) {
+        allocator.Free(offsets[x - 1], 4);
+    }
+
+    EXPECT_EQ(allocator.Available(), Count * 4);
+    EXPECT_EQ(allocator.Allocate(Count * 4), 0u);
+}
@@ -0,0 +1,241 @@
+#include "rendering/RenderGraph.hxx"
+#include "rendering/GraphicsContext.hxx"
+#include "rendering/null/NullDevice.hxx"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace kyanite::engine::rendering;
+
+namespace {
+    constexpr RenderTargetDesc BackbufferDesc = { 64, 64, RenderTargetFormat::RGBA8, false };
+    constexpr RenderTargetDesc TransientDesc = { 32, 32, RenderTargetFormat::RGBA16F, false };
+
+    // Writes the transitions and the passes into one log, so their order can be compared
+    class RecordingContext : public GraphicsContext {
+    public:
+        RecordingContext(const std::shared_ptr<Device>& device, std::vector<std::string>& log) :
+            GraphicsContext(device, device->CreateCommandQueue(CommandListType::Graphics)),
+            _log(log) {}
+
+        auto TransitionRenderTarget(std::shared_ptr<RenderTarget> target, ResourceState before, ResourceState after) -> void override {
+            _log.push_back(std::to_string(target != nullptr ? target->Address() : 0) + " " + Name(before) + " to " + Name(after));
+            GraphicsContext::TransitionRenderTarget(std::move(target), before, after);
+        }
+
+    private:
+        static auto Name(ResourceState state) -> std::string {
+            switch (state) {
+            case ResourceState::Undefined:
+                return "Undefined";
+            case ResourceState::RenderTarget:
+                return "RenderTarget";
+            case ResourceState::ShaderResource:
+                return "ShaderResource";
+            }
+            return "";
+        }
+
+        std::vector<std::string>& _log;
+    };
+
+    class RenderGraphTest : public testing::Test {
+    protected:
+        RenderGraphTest() :
+            device(std::make_shared<null::NullDevice>(BackbufferDesc.width, BackbufferDesc.height)),
+            context(device, log),
+            pool(device) {}
+
+        // Runs the graph once, the way the renderer does every frame
+        auto Run(RenderGraph& graph) -> void {
+            graph.Compile();
+            context.Begin();
+            graph.Execute(context, pool);
+            context.Finish();
+            pool.EndFrame();
+        }
+
+        // Adds a pass that only logs that it ran
+        auto LoggedPass(const std::string& name) -> std::function<void(RenderPassContext&)> {
+            return [this, name](RenderPassContext&) { log.push_back(name); };
+        }
+
+        std::shared_ptr<Device> device;
+        std::vector<std::string> log;
+        RecordingContext context;
+        RenderTargetPool pool;
+    };
+}
+
+TEST_F(RenderGraphTest, TestPassNothingReadsIsCulled) {
+    RenderGraph graph;
+    auto backbuffer = graph.Import("Backbuffer", nullptr, BackbufferDesc);
+
+    // Two passes feed each other, but nothing reads what the second one writes
+    RenderResourceHandle first = 0;
+    graph.AddPass("First", [&](RenderGraphBuilder& builder) { first = builder.Create("First", TransientDesc); }, LoggedPass("First"));
+    graph.AddPass("Second", [&](RenderGraphBuilder& builder) {
+        builder.Read(first);
+        builder.Create("Second", TransientDesc);
+    }, LoggedPass("Second"));
+    graph.AddPass("Scene", [&](RenderGraphBuilder& builder) { builder.Write(backbuffer); }, LoggedPass("Scene"));
+
+    Run(graph);
+
+    EXPECT_EQ(graph.CulledPasses(), 2u);
+    EXPECT_TRUE(graph.Passes()[0].IsCulled());
+    EXPECT_TRUE(graph.Passes()[1].IsCulled());
+    EXPECT_FALSE(graph.Passes()[2].IsCulled());
+    EXPECT_EQ(log, std::vector<std::string>({ "Scene" }));
+    // Targets of culled passes are never created
+    EXPECT_EQ(pool.Size(), 0u);
+}
+
+TEST_F(RenderGraphTest, TestPassWithSideEffectsIsKept) {
+    RenderGraph graph;
+    graph.AddPass("Readback", [&](RenderGraphBuilder& builder) {
+        builder.Create("Readback", TransientDesc);
+        builder.SideEffects();
+    }, LoggedPass("Readback"));
+
+    Run(graph);
+
+    EXPECT_EQ(graph.CulledPasses(), 0u);
+    EXPECT_EQ(log.back(), "Readback");
+}
+
+TEST_F(RenderGraphTest, TestPassWithoutWritesIsCulledUnlessItHasSideEffects) {
+    RenderGraph graph;
+    auto backbuffer = graph.Import("Backbuffer", nullptr, BackbufferDesc);
+
+    // Only the pass that writes nothing reads the first target, so its creator goes with it
+    RenderResourceHandle first = 0;
+    RenderResourceHandle second = 0;
+    graph.AddPass("CreateFirst", [&](RenderGraphBuilder& builder) { first = builder.Create("First", TransientDesc); }, LoggedPass("CreateFirst"));
+    graph.AddPass("ReadFirst", [&](RenderGraphBuilder& builder) { builder.Read(first); }, LoggedPass("ReadFirst"));
+    graph.AddPass("CreateSecond", [&](RenderGraphBuilder& builder) { second = builder.Create("Second", TransientDesc); }, LoggedPass("CreateSecond"));
+    graph.AddPass("Query", [&](RenderGraphBuilder& builder) {
+        builder.Read(second);
+        builder.SideEffects();
+    }, LoggedPass("Query"));
+    graph.AddPass("Empty", [](RenderGraphBuilder&) {}, LoggedPass("Empty"));
+    graph.AddPass("Scene", [&](RenderGraphBuilder& builder) { builder.Write(backbuffer); }, LoggedPass("Scene"));
+
+    Run(graph);
+
+    EXPECT_EQ(graph.CulledPasses(), 3u);
+    EXPECT_TRUE(graph.Passes()[0].IsCulled());
+    EXPECT_TRUE(graph.Passes()[1].IsCulled());
+    EXPECT_FALSE(graph.Passes()[2].IsCulled());
+    EXPECT_FALSE(graph.Passes()[3].IsCulled());
+    EXPECT_TRUE(graph.Passes()[4].IsCulled());
+    EXPECT_EQ(log.back(), "Scene");
+    EXPECT_EQ(std::count(log.begin(), log.end(), "Query"), 1);
+    EXPECT_EQ(std::count(log.begin(), log.end(), "ReadFirst"), 0);
+    // Only the target the kept pass reads is created
+    EXPECT_EQ(pool.Size(), 1u);
+}
+
+TEST_F(RenderGraphTest, TestDisjointLifetimesShareOnePooledTarget) {
+    RenderGraph graph;
+    auto backbuffer = graph.Import("Backbuffer", nullptr, BackbufferDesc);
+
+    // The first target is read for the last time before the second one is created
+    RenderResourceHandle first = 0;
+    RenderResourceHandle second = 0;
+    std::shared_ptr<RenderTarget> firstTarget;
+    std::shared_ptr<RenderTarget> secondTarget;
+    graph.AddPass("CreateFirst", [&](RenderGraphBuilder& builder) { first = builder.Create("First", TransientDesc); }, [](RenderPassContext&) {});
+    graph.AddPass("ReadFirst", [&](RenderGraphBuilder& builder) {
+        builder.Read(first);
+        builder.Write(backbuffer);
+    }, [&](RenderPassContext& pass) { firstTarget = pass.Target(first); });
+    graph.AddPass("CreateSecond", [&](RenderGraphBuilder& builder) { second = builder.Create("Second", TransientDesc); }, [](RenderPassContext&) {});
+    graph.AddPass("ReadSecond", [&](RenderGraphBuilder& builder) {
+        builder.Read(second);
+        builder.Write(backbuffer);
+    }, [&](RenderPassContext& pass) { secondTarget = pass.Target(second); });
+
+    Run(graph);
+
+    EXPECT_EQ(graph.CulledPasses(), 0u);
+    ASSERT_NE(firstTarget, nullptr);
+    EXPECT_EQ(firstTarget, secondTarget);
+    EXPECT_EQ(pool.Size(), 1u);
+}
+
+TEST_F(RenderGraphTest, TestOverlappingLifetimesGetTheirOwnTargets) {
+    RenderGraph graph;
+    auto backbuffer = graph.Import("Backbuffer", nullptr, BackbufferDesc);
+
+    RenderResourceHandle first = 0;
+    RenderResourceHandle second = 0;
+    std::shared_ptr<RenderTarget> firstTarget;
+    std::shared_ptr<RenderTarget> secondTarget;
+    graph.AddPass("CreateFirst", [&](RenderGraphBuilder& builder) { first = builder.Create("First", TransientDesc); }, [](RenderPassContext&) {});
+    graph.AddPass("CreateSecond", [&](RenderGraphBuilder& builder) { second = builder.Create("Second", TransientDesc); }, [](RenderPassContext&) {});
+    graph.AddPass("Compose", [&](RenderGraphBuilder& builder) {
+        builder.Read(first);
+        builder.Read(second);
+        builder.Write(backbuffer);
+    }, [&](RenderPassContext& pass) {
+        firstTarget = pass.Target(first);
+        secondTarget = pass.Target(second);
+    });
+
+    Run(graph);
+
+    ASSERT_NE(firstTarget, nullptr);
+    ASSERT_NE(secondTarget, nullptr);
+    EXPECT_NE(firstTarget, secondTarget);
+    EXPECT_EQ(pool.Size(), 2u);
+
+    // The next frame takes both back out of the pool instead of creating new ones
+    Run(graph);
+    EXPECT_EQ(pool.Size(), 2u);
+}
+
+TEST_F(RenderGraphTest, TestTransitionsAreEmittedBeforeThePassThatNeedsThem) {
+    RenderGraph graph;
+    auto backbuffer = graph.Import("Backbuffer", nullptr, BackbufferDesc);
+
+    RenderResourceHandle shadow = 0;
+    RenderResourceHandle bloom = 0;
+    std::shared_ptr<RenderTarget> shadowTarget;
+    std::shared_ptr<RenderTarget> bloomTarget;
+    graph.AddPass("Shadow", [&](RenderGraphBuilder& builder) { shadow = builder.Create("Shadow", TransientDesc); }, [&](RenderPassContext& pass) {
+        shadowTarget = pass.Target(shadow);
+        log.push_back("Shadow");
+    });
+    graph.AddPass("Bloom", [&](RenderGraphBuilder& builder) {
+        builder.Read(shadow);
+        bloom = builder.Create("Bloom", BackbufferDesc);
+    }, [&](RenderPassContext& pass) {
+        bloomTarget = pass.Target(bloom);
+        log.push_back("Bloom");
+    });
+    // The backbuffer starts as a render target, so only the transient targets need transitions
+    graph.AddPass("Scene", [&](RenderGraphBuilder& builder) {
+        builder.Read(shadow);
+        builder.Read(bloom);
+        builder.Write(backbuffer);
+    }, LoggedPass("Scene"));
+
+    Run(graph);
+
+    ASSERT_NE(shadowTarget, nullptr);
+    ASSERT_NE(bloomTarget, nullptr);
+    auto shadowId = std::to_string(shadowTarget->Address());
+    auto bloomId = std::to_string(bloomTarget->Address());
+    EXPECT_EQ(log, std::vector<std::string>({
+        shadowId + " Undefined to RenderTarget",
+        "Shadow",
+        shadowId + " RenderTarget to ShaderResource",
+        bloomId + " Undefined to RenderTarget",
+        "Bloom",
+        bloomId + " RenderTarget to ShaderResource",
+        "Scene"
+    }));
+}
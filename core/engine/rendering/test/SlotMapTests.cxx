@@ -0,0 +1,112 @@
+#include "rendering/SlotMap.hxx"
+#include <gtest/gtest.h>
+#include <vector>
+
+using kyanite::engine::rendering::SlotMap;
+
+namespace {
+    auto GenerationOf(SlotMap<int>::Handle handle) -> uint32_t {
+        return handle >> SlotMap<int>::IndexBits;
+    }
+}
+
+TEST(SlotMap, TestInsertedValuesResolve) {
+    SlotMap<int> map;
+    auto first = map.Insert(10);
+    auto second = map.Insert(20);
+
+    EXPECT_NE(first, SlotMap<int>::InvalidHandle);
+    EXPECT_NE(first, second);
+    ASSERT_NE(map.Get(first), nullptr);
+    ASSERT_NE(map.Get(second), nullptr);
+    EXPECT_EQ(*map.Get(first), 10);
+    EXPECT_EQ(*map.Get(second), 20);
+    EXPECT_EQ(map.Get(SlotMap<int>::InvalidHandle), nullptr);
+}
+
+TEST(SlotMap, TestHandleIsStaleAfterRemove) {
+    SlotMap<int> map;
+    auto handle = map.Insert(1);
+
+    EXPECT_TRUE(map.Remove(handle));
+    EXPECT_FALSE(map.Contains(handle));
+    EXPECT_EQ(map.Get(handle), nullptr);
+    EXPECT_FALSE(map.Remove(handle));
+
+    // The slot is reused, the stale handle must not resolve to the new value
+    auto reused = map.Insert(2);
+    EXPECT_EQ(reused & SlotMap<int>::IndexMask, handle & SlotMap<int>::IndexMask);
+    EXPECT_NE(reused, handle);
+    EXPECT_EQ(map.Get(handle), nullptr);
+    EXPECT_EQ(*map.Get(reused), 2);
+}
+
+TEST(SlotMap, TestGenerationSkipsZeroOnWrapAround) {
+    SlotMap<int> map;
+    auto handle = map.Insert(0);
+    ASSERT_EQ(GenerationOf(handle), 1u);
+
+    // Runs the generation of the one slot through all its values and past the wrap
+    for (uint32_t x = 1; x <= SlotMap<int>::GenerationMask; x++) {
+        ASSERT_TRUE(map.Remove(handle));
+        handle = map.Insert(static_cast<int>(x));
+        ASSERT_NE(handle, SlotMap<int>::InvalidHandle);
+        ASSERT_NE(GenerationOf(handle), 0u);
+    }
+
+    EXPECT_EQ(GenerationOf(handle), 1u);
+    EXPECT_EQ(*map.Get(handle), static_cast<int>(SlotMap<int>::GenerationMask));
+}
+
+TEST(SlotMap, TestRemoveKeepsOtherHandlesValid) {
+    SlotMap<int> map;
+    std::vector<SlotMap<int>::Handle> handles;
+    for (int x = 0; x < 8; x++) {
+        handles.push_back(map.Insert(x));
+    }
+
+    // Removing from the front and the middle moves the last values into the holes
+    EXPECT_TRUE(map.Remove(handles[0]));
+    EXPECT_TRUE(map.Remove(handles[4]));
+    EXPECT_EQ(map.Size(), 6u);
+
+    for (int x = 0; x < 8; x++) {
+        if (x == 0 || x == 4) {
+            EXPECT_EQ(map.Get(handles[x]), nullptr);
+            continue;
+        }
+        ASSERT_NE(map.Get(handles[x]), nullptr);
+        EXPECT_EQ(*map.Get(handles[x]), x);
+    }
+
+    // The dense values hold exactly the ones still alive
+    int sum = 0;
+    for (auto value : map) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 1 + 2 + 3 + 5 + 6 + 7);
+}
+
+TEST(SlotMap, TestClearInvalidatesEveryHandle) {
+    SlotMap<int> map;
+    std::vector<SlotMap<int>::Handle> handles;
+    for (int x = 0; x < 16; x++) {
+        handles.push_back(map.Insert(x));
+    }
+
+    map.Clear();
+
+    EXPECT_TRUE(map.Empty());
+    for (auto handle : handles) {
+        EXPECT_FALSE(map.Contains(handle));
+        EXPECT_EQ(map.Get(handle), nullptr);
+    }
+
+    // Slots are reused after a clear, still without reviving the old handles
+    for (int x = 0; x < 16; x++) {
+        map.Insert(x);
+    }
+    for (auto handle : handles) {
+        EXPECT_FALSE(map.Contains(handle));
+    }
+}
@@ -0,0 +1,119 @@
+#include "rendering/SpriteBatch.hxx"
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <vector>
+
+using kyanite::engine::rendering::BatchSprites;
+using kyanite::engine::rendering::Frustum;
+using kyanite::engine::rendering::SpriteBatch;
+using kyanite::engine::rendering::SpriteInstance;
+
+namespace {
+    // The view the renderer sets up, 640 by 360 world units
+    auto ScreenFrustum() -> Frustum {
+        return Frustum::FromViewProjection(glm::orthoLH(0.0f, 640.0f, 0.0f, 360.0f, 0.1f, 100.0f));
+    }
+
+    auto MakeSprite(glm::vec2 position, float size = 10.0f, uint16_t layer = 0) -> SpriteInstance {
+        return SpriteInstance::Pack(position, 0.0f, glm::vec2(size), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), 0xFFFFFFFF, layer);
+    }
+
+    auto IsVisible(const SpriteInstance& sprite) -> bool {
+        std::vector<SpriteInstance> instances;
+        std::vector<SpriteBatch> batches;
+        BatchSprites(ScreenFrustum(), { sprite }, { 1 }, instances, batches);
+        return instances.size() == 1;
+    }
+}
+
+TEST(SpriteBatch, TestUvRectIsPackedAsUnorm16) {
+    auto sprite = SpriteInstance::Pack({ 1.0f, 2.0f }, 0.5f, { 3.0f, 4.0f }, { 0.0f, 0.5f, 0.25f, 1.0f }, 0x11223344, 7);
+
+    EXPECT_EQ(sprite.uvRect[0], 0);
+    EXPECT_EQ(sprite.uvRect[1], 32768);
+    EXPECT_EQ(sprite.uvRect[2], 16384);
+    EXPECT_EQ(sprite.uvRect[3], 65535);
+
+    // What the shader reads back as a normalised short is within half a step of the input
+    for (int x = 0; x < 4; x++) {
+        auto expected = glm::vec4(0.0f, 0.5f, 0.25f, 1.0f)[x];
+        EXPECT_NEAR(sprite.uvRect[x] / 65535.0f, expected, 0.5f / 65535.0f);
+    }
+
+    EXPECT_EQ(sprite.color, 0x11223344u);
+    EXPECT_EQ(sprite.layer, 7);
+    EXPECT_EQ(sprite.padding, 0);
+}
+
+TEST(SpriteBatch, TestUvRectOutsideTheTextureIsClamped) {
+    auto sprite = SpriteInstance::Pack({ 0.0f, 0.0f }, 0.0f, { 1.0f, 1.0f }, { -0.5f, 1.5f, -0.0f, 2.0f }, 0, 0);
+
+    EXPECT_EQ(sprite.uvRect[0], 0);
+    EXPECT_EQ(sprite.uvRect[1], 65535);
+    EXPECT_EQ(sprite.uvRect[2], 0);
+    EXPECT_EQ(sprite.uvRect[3], 65535);
+}
+
+TEST(SpriteBatch, TestScaleIsPackedAsHalfFloats) {
+    auto sprite = SpriteInstance::Pack({ 0.0f, 0.0f }, 0.0f, { 32.0f, 0.5f }, { 0.0f, 0.0f, 1.0f, 1.0f }, 0, 0);
+    auto scale = glm::unpackHalf2x16(sprite.scale);
+
+    EXPECT_FLOAT_EQ(scale.x, 32.0f);
+    EXPECT_FLOAT_EQ(scale.y, 0.5f);
+}
+
+TEST(SpriteBatch, TestSpritesAreCulledBySidePlanes) {
+    EXPECT_TRUE(IsVisible(MakeSprite({ 320.0f, 180.0f })));
+
+    // Fully past one side
+    EXPECT_FALSE(IsVisible(MakeSprite({ -20.0f, 180.0f })));
+    EXPECT_FALSE(IsVisible(MakeSprite({ 660.0f, 180.0f })));
+    EXPECT_FALSE(IsVisible(MakeSprite({ 320.0f, -20.0f })));
+    EXPECT_FALSE(IsVisible(MakeSprite({ 320.0f, 380.0f })));
+
+    // The centre is outside, but the circle around the sprite still reaches in
+    EXPECT_TRUE(IsVisible(MakeSprite({ -5.0f, 180.0f })));
+    EXPECT_TRUE(IsVisible(MakeSprite({ 645.0f, 365.0f })));
+    // A larger sprite reaches further
+    EXPECT_FALSE(IsVisible(MakeSprite({ -30.0f, 180.0f })));
+    EXPECT_TRUE(IsVisible(MakeSprite({ -30.0f, 180.0f }, 80.0f)));
+}
+
+TEST(SpriteBatch, TestBatchesGroupByLayerThenMaterialInSubmissionOrder) {
+    // The x position tells the sprites apart
+    struct Submitted {
+        uint16_t layer;
+        uint32_t material;
+    };
+    const Submitted submitted[] = { { 1, 2 }, { 0, 5 }, { 1, 2 }, { 0, 3 }, { 1, 1 }, { 0, 5 }, { 1, 2 } };
+
+    std::vector<SpriteInstance> sprites;
+    std::vector<uint32_t> materials;
+    for (size_t x = 0; x < std::size(submitted); x++) {
+        sprites.push_back(MakeSprite({ 100.0f + x, 100.0f }, 10.0f, submitted[x].layer));
+        materials.push_back(submitted[x].material);
+    }
+    // Out of view, it must not split a batch
+    sprites.insert(sprites.begin() + 3, MakeSprite({ -100.0f, 100.0f }, 10.0f, 1));
+    materials.insert(materials.begin() + 3, 2);
+
+    std::vector<SpriteInstance> instances;
+    std::vector<SpriteBatch> batches;
+    BatchSprites(ScreenFrustum(), sprites, materials, instances, batches);
+
+    std::vector<float> order;
+    for (auto& instance : instances) {
+        order.push_back(instance.position.x - 100.0f);
+    }
+    EXPECT_EQ(order, std::vector<float>({ 3, 1, 5, 4, 0, 2, 6 }));
+
+    ASSERT_EQ(batches.size(), 4u);
+    const SpriteBatch expected[] = { { 3, 0, 0, 1 }, { 5, 0, 1, 2 }, { 1, 1, 3, 1 }, { 2, 1, 4, 3 } };
+    for (size_t x = 0; x < batches.size(); x++) {
+        EXPECT_EQ(batches[x].material, expected[x].material) << "batch " << x;
+        EXPECT_EQ(batches[x].layer, expected[x].layer) << "batch " << x;
+        EXPECT_EQ(batches[x].firstInstance, expected[x].firstInstance) << "batch " << x;
+        EXPECT_EQ(batches[x].instanceCount, expected[x].instanceCount) << "batch " << x;
+    }
+}
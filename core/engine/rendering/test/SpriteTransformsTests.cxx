@@ -0,0 +1,103 @@
+#include "rendering/SpriteTransforms.hxx"
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+using kyanite::engine::rendering::BuildSpriteTransforms;
+using kyanite::engine::rendering::BuildSpriteTransformsScalar;
+
+namespace {
+    // Sprites as the scripts pass them, three floats of position and scale each
+    struct Sprites {
+        std::vector<float> positions;
+        std::vector<float> rotations;
+        std::vector<float> scales;
+    };
+
+    // Spreads the angles over small, negative and very large values, a few thousand turns at most
+    auto MakeSprites(size_t count) -> Sprites {
+        const float angles[] = { 0.0f, 0.5f, -0.5f, 1.5707964f, -3.1415927f, 10.0f, -100.25f, 1000.0f, -4321.5f, 12345.678f, -20000.0f };
+
+        Sprites sprites;
+        for (size_t x = 0; x < count; x++) {
+            auto step = static_cast<float>(x);
+            sprites.positions.insert(sprites.positions.end(), { step * 3.0f, -step, 0.25f * step });
+            sprites.rotations.push_back(angles[x % std::size(angles)] + step * 0.37f);
+            sprites.scales.insert(sprites.scales.end(), { 1.0f + step, 0.5f + (x % 5) * 7.0f, 2.0f });
+        }
+        return sprites;
+    }
+
+    // The columns DrawSprite gets from scripts, which scale after rotating by the negated angle
+    auto GlmModel(const Sprites& sprites, size_t sprite) -> glm::mat4 {
+        auto position = glm::vec3(sprites.positions[sprite * 3], sprites.positions[sprite * 3 + 1], sprites.positions[sprite * 3 + 2]);
+        auto scale = glm::vec3(sprites.scales[sprite * 3], sprites.scales[sprite * 3 + 1], sprites.scales[sprite * 3 + 2]);
+
+        auto model = glm::translate(glm::mat4(1.0f), position);
+        model = glm::scale(model, scale);
+        return glm::rotate(model, -sprites.rotations[sprite], glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+
+    // A few ulp of the largest scale, sine and cosine only differ in their last bits
+    auto ExpectNearModel(const glm::mat4& actual, const glm::mat4& expected, float scale, size_t sprite, size_t count) -> void {
+        auto tolerance = 4.0f * FLT_EPSILON * scale;
+        for (int column = 0; column < 4; column++) {
+            for (int row = 0; row < 4; row++) {
+                EXPECT_NEAR(actual[column][row], expected[column][row], tolerance)
+                    << "sprite " << sprite << " of " << count << ", column " << column << ", row " << row;
+            }
+        }
+    }
+
+    auto LargestScale(const Sprites& sprites, size_t sprite) -> float {
+        return std::max(std::abs(sprites.scales[sprite * 3]), std::abs(sprites.scales[sprite * 3 + 1]));
+    }
+
+    // Counts below, at and past whole registers of four and eight lanes
+    const size_t Counts[] = { 1, 3, 4, 7, 8, 9, 17, 100 };
+}
+
+TEST(SpriteTransforms, TestVectorPathMatchesScalarPath) {
+    for (auto count : Counts) {
+        auto sprites = MakeSprites(count);
+
+        // One extra matrix to catch writes past the end
+        std::vector<glm::mat4> vector(count + 1, glm::mat4(7.0f));
+        std::vector<glm::mat4> scalar(count);
+        BuildSpriteTransforms(count, sprites.positions.data(), sprites.rotations.data(), sprites.scales.data(), vector.data());
+        BuildSpriteTransformsScalar(count, sprites.positions.data(), sprites.rotations.data(), sprites.scales.data(), scalar.data());
+
+        for (size_t x = 0; x < count; x++) {
+            ExpectNearModel(vector[x], scalar[x], LargestScale(sprites, x), x, count);
+        }
+        EXPECT_EQ(vector[count], glm::mat4(7.0f));
+    }
+}
+
+TEST(SpriteTransforms, TestModelsMatchGlm) {
+    for (auto count : Counts) {
+        auto sprites = MakeSprites(count);
+
+        std::vector<glm::mat4> models(count);
+        BuildSpriteTransforms(count, sprites.positions.data(), sprites.rotations.data(), sprites.scales.data(), models.data());
+
+        for (size_t x = 0; x < count; x++) {
+            ExpectNearModel(models[x], GlmModel(sprites, x), LargestScale(sprites, x), x, count);
+        }
+    }
+}
+
+TEST(SpriteTransforms, TestPositionAndDepthScaleAreCopiedExactly) {
+    auto sprites = MakeSprites(17);
+
+    std::vector<glm::mat4> models(17);
+    BuildSpriteTransforms(17, sprites.positions.data(), sprites.rotations.data(), sprites.scales.data(), models.data());
+
+    for (size_t x = 0; x < 17; x++) {
+        EXPECT_EQ(models[x][2], glm::vec4(0.0f, 0.0f, sprites.scales[x * 3 + 2], 0.0f)) << "sprite " << x;
+        EXPECT_EQ(models[x][3], glm::vec4(sprites.positions[x * 3], sprites.positions[x * 3 + 1], sprites.positions[x * 3 + 2], 1.0f)) << "sprite " << x;
+    }
+}
@@ -0,0 +1,151 @@
+#include "rendering/Tilemap.hxx"
+#include <gtest/gtest.h>
+#include <vector>
+
+using kyanite::engine::rendering::Tilemap;
+using kyanite::engine::rendering::Vertex;
+
+namespace {
+    constexpr uint32_t InvalidMesh = 0xFFFFFFFF;
+
+    // 40 by 40 tiles of 2 by 3 units, so the chunks on the right and the top are cut to 8 tiles
+    auto MakeTilemap(uint32_t atlasColumns = 4, uint32_t atlasRows = 2) -> Tilemap {
+        return Tilemap(40, 40, { 2.0f, 3.0f }, atlasColumns, atlasRows, 1, InvalidMesh);
+    }
+
+    auto ClearDirty(Tilemap& tilemap) -> void {
+        for (auto& chunk : tilemap.Chunks()) {
+            chunk.dirty = false;
+        }
+    }
+
+    auto DirtyChunks(Tilemap& tilemap) -> std::vector<size_t> {
+        std::vector<size_t> dirty;
+        for (size_t x = 0; x < tilemap.Chunks().size(); x++) {
+            if (tilemap.Chunks()[x].dirty) {
+                dirty.push_back(x);
+            }
+        }
+        return dirty;
+    }
+
+    struct Mesh {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    auto Build(const Tilemap& tilemap, size_t chunk) -> Mesh {
+        Mesh mesh;
+        tilemap.BuildChunk(chunk, mesh.vertices, mesh.indices);
+        return mesh;
+    }
+}
+
+TEST(Tilemap, TestChunksCoverTheMapAndAreCutAtItsEdges) {
+    auto tilemap = MakeTilemap();
+    auto& chunks = tilemap.Chunks();
+
+    ASSERT_EQ(chunks.size(), 4u);
+    for (auto& chunk : chunks) {
+        EXPECT_EQ(chunk.mesh, InvalidMesh);
+        EXPECT_TRUE(chunk.dirty);
+    }
+
+    EXPECT_EQ(chunks[0].bounds.min, glm::vec3(0.0f));
+    EXPECT_EQ(chunks[0].bounds.max, glm::vec3(64.0f, 96.0f, 0.0f));
+    EXPECT_EQ(chunks[3].bounds.min, glm::vec3(64.0f, 96.0f, 0.0f));
+    EXPECT_EQ(chunks[3].bounds.max, glm::vec3(80.0f, 120.0f, 0.0f));
+}
+
+TEST(Tilemap, TestOnlyChunksWithChangedTilesAreDirty) {
+    auto tilemap = MakeTilemap();
+    ClearDirty(tilemap);
+    EXPECT_FALSE(tilemap.HasDirtyChunks());
+
+    // Writing the tiles a chunk already has leaves it clean
+    const uint16_t empty[] = { 0, 0, 0, 0 };
+    tilemap.SetTiles(30, 30, 2, 2, empty);
+    EXPECT_FALSE(tilemap.HasDirtyChunks());
+
+    // One tile in the chunk to the right of the first
+    const uint16_t tile[] = { 5 };
+    tilemap.SetTiles(33, 1, 1, 1, tile);
+    EXPECT_TRUE(tilemap.HasDirtyChunks());
+    EXPECT_EQ(DirtyChunks(tilemap), std::vector<size_t>({ 1 }));
+
+    // A rectangle across the corner touches all four chunks
+    ClearDirty(tilemap);
+    const uint16_t corner[] = { 1, 2, 3, 4 };
+    tilemap.SetTiles(31, 31, 2, 2, corner);
+    EXPECT_EQ(DirtyChunks(tilemap), std::vector<size_t>({ 0, 1, 2, 3 }));
+}
+
+TEST(Tilemap, TestTilesOutsideTheMapAreIgnored) {
+    auto tilemap = MakeTilemap();
+    ClearDirty(tilemap);
+
+    // Four by four at 38, 38, only the lower left two by two fall inside the map
+    const uint16_t tiles[] = {
+        1, 2, 7, 7,
+        3, 4, 7, 7,
+        7, 7, 7, 7,
+        7, 7, 7, 7
+    };
+    tilemap.SetTiles(38, 38, 4, 4, tiles);
+    EXPECT_EQ(DirtyChunks(tilemap), std::vector<size_t>({ 3 }));
+
+    auto mesh = Build(tilemap, 3);
+    ASSERT_EQ(mesh.vertices.size(), 16u);
+    ASSERT_EQ(mesh.indices.size(), 24u);
+
+    // Rows of the source keep their stride, so the second row starts with tile 3 and not 7
+    const glm::vec2 uvMins[] = { { 0.0f, 0.0f }, { 0.25f, 0.0f }, { 0.5f, 0.0f }, { 0.75f, 0.0f } };
+    const glm::vec2 positions[] = { { 76.0f, 114.0f }, { 78.0f, 114.0f }, { 76.0f, 117.0f }, { 78.0f, 117.0f } };
+    for (size_t x = 0; x < 4; x++) {
+        EXPECT_EQ(mesh.vertices[x * 4].uvs, uvMins[x]) << "tile " << x;
+        EXPECT_EQ(mesh.vertices[x * 4].position, glm::vec3(positions[x], 0.0f)) << "tile " << x;
+    }
+
+    // Entirely outside changes nothing
+    ClearDirty(tilemap);
+    tilemap.SetTiles(40, 0, 4, 4, tiles);
+    tilemap.SetTiles(0, 100, 4, 4, tiles);
+    EXPECT_FALSE(tilemap.HasDirtyChunks());
+}
+
+TEST(Tilemap, TestTilesPastTheAtlasWrapAround) {
+    // Eight cells, four per row
+    auto tilemap = MakeTilemap(4, 2);
+    const uint16_t tiles[] = { 1, 8, 9, 14 };
+    tilemap.SetTiles(0, 0, 4, 1, tiles);
+
+    auto mesh = Build(tilemap, 0);
+    ASSERT_EQ(mesh.vertices.size(), 16u);
+
+    // Tile 1 is the first cell and 8 the last, 9 starts over and 14 is the sixth cell again
+    const glm::vec2 uvMins[] = { { 0.0f, 0.0f }, { 0.75f, 0.5f }, { 0.0f, 0.0f }, { 0.25f, 0.5f } };
+    for (size_t x = 0; x < 4; x++) {
+        EXPECT_EQ(mesh.vertices[x * 4].uvs, uvMins[x]) << "tile " << x;
+        EXPECT_EQ(mesh.vertices[x * 4 + 2].uvs, uvMins[x] + glm::vec2(0.25f, 0.5f)) << "tile " << x;
+    }
+}
+
+TEST(Tilemap, TestEmptyTilesHaveNoQuads) {
+    auto tilemap = MakeTilemap();
+    const uint16_t tiles[] = { 0, 3, 0, 0, 5, 0 };
+    tilemap.SetTiles(0, 0, 3, 2, tiles);
+
+    auto mesh = Build(tilemap, 0);
+    ASSERT_EQ(mesh.vertices.size(), 8u);
+    EXPECT_EQ(mesh.vertices[0].position, glm::vec3(2.0f, 0.0f, 0.0f));
+    EXPECT_EQ(mesh.vertices[4].position, glm::vec3(2.0f, 3.0f, 0.0f));
+
+    // Indices are relative to the first vertex, with the winding of the sprite quad
+    EXPECT_EQ(mesh.indices, std::vector<uint32_t>({ 0, 1, 2, 2, 3, 0, 4, 5, 6, 6, 7, 4 }));
+
+    // A chunk without tiles builds nothing, and the output of an earlier build is cleared
+    mesh = Build(tilemap, 0);
+    tilemap.BuildChunk(1, mesh.vertices, mesh.indices);
+    EXPECT_TRUE(mesh.vertices.empty());
+    EXPECT_TRUE(mesh.indices.empty());
+}
@@ -0,0 +1,80 @@
+#include "rendering/UploadContext.hxx"
+#include "rendering/null/NullDevice.hxx"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+
+using namespace kyanite::engine::rendering;
+
+namespace {
+    class UploadContextTest : public testing::Test {
+    protected:
+        UploadContextTest() :
+            device(std::make_shared<null::NullDevice>(64, 64)),
+            upload(device->CreateUploadContext()) {}
+
+        auto MakeBounds(float min, float max) -> Bounds {
+            Bounds bounds;
+            bounds.Encapsulate(glm::vec3(min));
+            bounds.Encapsulate(glm::vec3(max));
+            return bounds;
+        }
+
+        std::shared_ptr<Device> device;
+        std::unique_ptr<UploadContext> upload;
+    };
+}
+
+TEST_F(UploadContextTest, TestUpdatesAfterTakingBelongToTheNextFrame) {
+    auto buffer = device->CreateVertexBuffer(nullptr, 4, sizeof(uint32_t), BufferUsage::Dynamic);
+    const uint32_t first[] = { 1, 2, 3, 4 };
+    const uint32_t second[] = { 5, 6 };
+
+    upload->UpdateVertexBuffer(buffer, first, sizeof(first));
+    auto frame = upload->TakeStagedBuffers();
+    // Staged while the first frame is still in flight
+    upload->UpdateBufferRange(buffer, 8, second, sizeof(second));
+
+    ASSERT_EQ(frame.copies.size(), 1u);
+    EXPECT_TRUE(frame.copies[0].replace);
+    EXPECT_EQ(frame.copies[0].size, sizeof(first));
+    EXPECT_EQ(std::memcmp(frame.data->data() + frame.copies[0].sourceOffset, first, sizeof(first)), 0);
+
+    auto next = upload->TakeStagedBuffers();
+    ASSERT_EQ(next.copies.size(), 1u);
+    EXPECT_FALSE(next.copies[0].replace);
+    EXPECT_EQ(next.copies[0].offset, 8u);
+    EXPECT_EQ(std::memcmp(next.data->data() + next.copies[0].sourceOffset, second, sizeof(second)), 0);
+
+    // The first frame still owns its bytes
+    EXPECT_NE(frame.data, next.data);
+    EXPECT_EQ(std::memcmp(frame.data->data() + frame.copies[0].sourceOffset, first, sizeof(first)), 0);
+
+    EXPECT_TRUE(upload->TakeStagedBuffers().copies.empty());
+}
+
+TEST_F(UploadContextTest, TestBoundsAreStagedWithTheirVertices) {
+    auto vertexBuffer = device->CreateVertexBuffer(nullptr, 4, sizeof(uint32_t), BufferUsage::Dynamic);
+    auto indexBuffer = device->CreateIndexBuffer(nullptr, 0, BufferUsage::Dynamic);
+    auto replaced = MakeBounds(-1.0f, 1.0f);
+    auto grown = MakeBounds(2.0f, 3.0f);
+    const uint32_t data[] = { 0, 1, 2, 3 };
+
+    upload->UpdateVertexBuffer(vertexBuffer, data, sizeof(data), &replaced);
+    upload->UpdateBufferRange(vertexBuffer, 0, data, sizeof(data), &grown);
+    // Without bounds the bounds of the buffer stay as they are
+    upload->UpdateVertexBuffer(vertexBuffer, data, sizeof(data));
+    upload->UpdateIndexBuffer(indexBuffer, data, sizeof(data));
+
+    // Nothing changes before the frame is taken
+    EXPECT_FALSE(vertexBuffer->LocalBounds().IsValid());
+
+    auto frame = upload->TakeStagedBuffers();
+    EXPECT_EQ(frame.copies.size(), 4u);
+    ASSERT_EQ(frame.bounds.size(), 2u);
+    EXPECT_EQ(frame.bounds[0].buffer, vertexBuffer);
+    EXPECT_TRUE(frame.bounds[0].replace);
+    EXPECT_EQ(frame.bounds[0].bounds.max, glm::vec3(1.0f));
+    EXPECT_FALSE(frame.bounds[1].replace);
+    EXPECT_EQ(frame.bounds[1].bounds.min, glm::vec3(2.0f));
+}
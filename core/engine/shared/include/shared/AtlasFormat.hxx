@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+// Binary layout of the .atlas files written by the bundler and read by the renderer.
+// A file is an AtlasHeader followed by regionCount AtlasRegions. Page i is stored next to it as <name>_<i>.png.
+namespace kyanite::engine::shared {
+	constexpr uint32_t AtlasMagic = 0x4C54414B; // "KATL"
+	constexpr uint32_t AtlasVersion = 1;
+	constexpr uint32_t AtlasNameLength = 64;
+
+	struct AtlasHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t pageSize;
+		uint32_t pageCount;
+		uint32_t regionCount;
+	};
+
+	struct AtlasRegion {
+		// The path of the source image as listed in the manifest, null terminated
+		char name[AtlasNameLength];
+		uint32_t page;
+		uint32_t width;
+		uint32_t height;
+		// Normalised texture coordinates, v grows from the bottom row of the page
+		float u0;
+		float v0;
+		float u1;
+		float v1;
+	};
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <cstring>
+#include <vector>
+
+// Binary layout of the .kmesh files written by the bundler and read by the renderer.
+// A file is a MeshHeader followed by meshCount MeshEntries. Every entry points at a vertex and an index range
+// that start on a MeshDataAlignment boundary, so both can be handed to the buffer constructors straight from a mapping.
+namespace kyanite::engine::shared {
+	constexpr uint32_t MeshMagic = 0x48534D4B; // "KMSH"
+	constexpr uint32_t MeshVersion = 1;
+	constexpr uint32_t MeshDataAlignment = 16;
+	constexpr uint32_t MeshNameLength = 64;
+
+	enum class VertexFormat : uint32_t {
+		// float3 position, float2 uv, the runtime Vertex layout
+		Float32 = 1,
+		// half3 position padded to four halves, half2 uv
+		Half16 = 2
+	};
+
+	struct MeshHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t meshCount;
+		uint32_t reserved;
+	};
+
+	struct MeshEntry {
+		char name[MeshNameLength];
+		VertexFormat format;
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint32_t reserved;
+		// Offsets of the vertex and the 32 bit index data from the start of the file
+		uint64_t vertexOffset;
+		uint64_t indexOffset;
+		// Local bounds of the positions before quantization
+		float boundsMin[3];
+		float boundsMax[3];
+	};
+
+	constexpr auto VertexStride(VertexFormat format) -> uint32_t {
+		return format == VertexFormat::Float32 ? 20 : 12;
+	}
+
+	/**
+	* @brief Reads and validates the header and mesh table of a .kmesh file
+	* @param data The file contents
+	* @param len The length of the contents
+	* @param header Receives the header
+	* @param meshes Receives the mesh table
+	* @return True if the header is valid and every range lies inside the data, false otherwise
+	*/
+	inline auto ReadMeshHeader(const uint8_t* data, size_t len, MeshHeader& header, std::vector<MeshEntry>& meshes) -> bool {
+		if (len < sizeof(MeshHeader)) {
+			return false;
+		}
+		std::memcpy(&header, data, sizeof(MeshHeader));
+
+		if (header.magic != MeshMagic || header.version != MeshVersion) {
+			return false;
+		}
+		if (header.meshCount > (len - sizeof(MeshHeader)) / sizeof(MeshEntry)) {
+			return false;
+		}
+
+		meshes.resize(header.meshCount);
+		std::memcpy(meshes.data(), data + sizeof(MeshHeader), header.meshCount * sizeof(MeshEntry));
+
+		for (auto& mesh : meshes) {
+			if (mesh.format != VertexFormat::Float32 && mesh.format != VertexFormat::Half16) {
+				return false;
+			}
+			auto vertexBytes = static_cast<uint64_t>(mesh.vertexCount) * VertexStride(mesh.format);
+			auto indexBytes = static_cast<uint64_t>(mesh.indexCount) * sizeof(uint32_t);
+			if (mesh.vertexOffset > len || vertexBytes > len - mesh.vertexOffset) {
+				return false;
+			}
+			if (mesh.indexOffset > len || indexBytes > len - mesh.indexOffset) {
+				return false;
+			}
+			if (mesh.vertexOffset % MeshDataAlignment != 0 || mesh.indexOffset % MeshDataAlignment != 0) {
+				return false;
+			}
+			// Names are written padded with zeros, a full buffer must still end in one
+			mesh.name[MeshNameLength - 1] = '\0';
+		}
+
+		return true;
+	}
+}
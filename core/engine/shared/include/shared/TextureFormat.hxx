@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <cstring>
+#include <vector>
+
+// Binary layout of the .ktex files written by the bundler and read by the renderer.
+// A file is a TextureHeader followed by levelCount TextureLevels, largest level first.
+// The block data of every level starts on a TextureDataAlignment boundary so it can be uploaded straight from a mapping.
+namespace kyanite::engine::shared {
+	constexpr uint32_t TextureMagic = 0x5845544B; // "KTEX"
+	constexpr uint32_t TextureVersion = 1;
+	constexpr uint32_t TextureDataAlignment = 16;
+	constexpr uint32_t TextureMaxLevels = 16;
+
+	enum class TextureFormat : uint32_t {
+		// Opaque RGB, 8 bytes per 4x4 block
+		BC1 = 1,
+		// RGB with interpolated alpha, 16 bytes per 4x4 block
+		BC3 = 2
+	};
+
+	struct TextureHeader {
+		uint32_t magic;
+		uint32_t version;
+		TextureFormat format;
+		uint32_t width;
+		uint32_t height;
+		uint32_t levelCount;
+	};
+
+	struct TextureLevel {
+		// Offset of the block data from the start of the file
+		uint64_t offset;
+		uint64_t size;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	constexpr auto TextureBlockBytes(TextureFormat format) -> uint32_t {
+		return format == TextureFormat::BC1 ? 8 : 16;
+	}
+
+	constexpr auto TextureLevelBytes(TextureFormat format, uint32_t width, uint32_t height) -> uint64_t {
+		return static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4) * TextureBlockBytes(format);
+	}
+
+	/**
+	* @brief Reads and validates the header and level table of a .ktex file
+	* @param data The file contents
+	* @param len The length of the contents
+	* @param header Receives the header
+	* @param levels Receives the level table
+	* @return True if the header is valid and every level lies inside the data, false otherwise
+	*/
+	inline auto ReadTextureHeader(const uint8_t* data, size_t len, TextureHeader& header, std::vector<TextureLevel>& levels) -> bool {
+		if (len < sizeof(TextureHeader)) {
+			return false;
+		}
+		std::memcpy(&header, data, sizeof(TextureHeader));
+
+		if (header.magic != TextureMagic || header.version != TextureVersion) {
+			return false;
+		}
+		if (header.format != TextureFormat::BC1 && header.format != TextureFormat::BC3) {
+			return false;
+		}
+		if (header.levelCount == 0 || header.levelCount > TextureMaxLevels) {
+			return false;
+		}
+		if (len < sizeof(TextureHeader) + header.levelCount * sizeof(TextureLevel)) {
+			return false;
+		}
+
+		levels.resize(header.levelCount);
+		std::memcpy(levels.data(), data + sizeof(TextureHeader), header.levelCount * sizeof(TextureLevel));
+
+		for (const auto& level : levels) {
+			if (level.size != TextureLevelBytes(header.format, level.width, level.height)) {
+				return false;
+			}
+			if (level.offset > len || level.size > len - level.offset) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
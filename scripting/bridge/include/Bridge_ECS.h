@@ -119,6 +119,22 @@ extern "C" {
 		void (*func)(NativePointer)
 	);
 
+	/**
+	* @brief Registers a system that also reads components not every matched entity has
+	* @param optional The component uuids read where present, they follow the filter in the iterator
+	* @param optionalLen The number of optional components
+	* @note The buffer of an optional component is null for entities without it
+	*/
+	EXPORTED extern uint64_t ECS_RegisterSystemWithOptional(
+		const char* name, 
+		const uint64_t* filter, 
+		size_t filterLen, 
+		const uint64_t* optional,
+		size_t optionalLen,
+		bool isParallel,
+		void (*func)(NativePointer)
+	);
+
 	/**
 	* @brief Gets components for an iterator
 	* @param iterator The iterator to get the components from
@@ -183,6 +199,16 @@ extern "C" {
 	* @return The uuid of the component
 	*/
 	EXPORTED extern uint64_t ECS_GetComponentUuid(uint64_t component);
+
+	/**
+	* @brief Creates a flipbook clip that FlipbookComponents play
+	* @param rects The texture region of every frame (u0, v0, u1, v1), 4 * frameCount floats
+	* @param durations How long every frame is shown in seconds, frameCount floats
+	* @param frameCount The number of frames
+	* @param mode 0 stops on the last frame, 1 loops and 2 plays back and forth
+	* @return The clip, 0 if the frames are invalid
+	*/
+	EXPORTED extern uint32_t ECS_CreateFlipbook(const float* rects, const float* durations, size_t frameCount, uint32_t mode);
 #ifdef __cplusplus 
 }
 #endif
\ No newline at end of file
@@ -22,6 +22,19 @@ EXPORTED void Rendering_Init(NativePointer window, NativePointer imGuiContext);
  */
 EXPORTED void Rendering_Shutdown();
 
+/**
+ * @brief Draws every frame on a render thread, one frame behind the simulation
+ * @param maxFramesInFlight How many frames the simulation may run ahead before Rendering_PostFrame blocks
+ *
+ */
+EXPORTED void Rendering_StartRenderThread(uint32_t maxFramesInFlight);
+
+/**
+ * @brief Stops the render thread and draws on the calling thread again
+ *
+ */
+EXPORTED void Rendering_StopRenderThread();
+
 /**
  * @brief Sets the clear color of the rendering system
  * @param r The red component of the color
@@ -60,6 +73,74 @@ EXPORTED extern void Rendering_DrawSprite(
 	uint32_t materialId
 );
 
+/**
+* @brief Draws a sprite that samples a region of its texture
+* @param transform The transform of the sprite
+* @param materialId The material to use
+* @param uvRect The region to sample as u0, v0, u1, v1
+*/
+EXPORTED extern void Rendering_DrawSpriteRegion(
+	const float* transform,
+	uint32_t materialId,
+	const float* uvRect
+);
+
+/**
+* @brief Draws a sprite that samples a region of its texture in a layer
+* @param transform The transform of the sprite
+* @param materialId The material to use
+* @param uvRect The region to sample as u0, v0, u1, v1
+* @param layer Blended sprites are drawn by layer before depth, lowest first. Opaque sprites at equal depth show the highest.
+*/
+EXPORTED extern void Rendering_DrawSpriteLayer(
+	const float* transform,
+	uint32_t materialId,
+	const float* uvRect,
+	uint16_t layer
+);
+
+/**
+* @brief Draws many sprites with one call, the matrices are built natively
+* @param count The number of sprites
+* @param positions The x, y and z of every sprite, 3 * count floats
+* @param rotations The rotation of every sprite around z in radians, count floats
+* @param scales The x, y and z scale of every sprite, 3 * count floats
+* @param materialIds The material of every sprite, count ids
+* @param uvRects The region every sprite samples as u0, v0, u1, v1, 4 * count floats. Null samples whole textures
+*/
+EXPORTED extern void Rendering_DrawSprites(
+	size_t count,
+	const float* positions,
+	const float* rotations,
+	const float* scales,
+	const uint32_t* materialIds,
+	const float* uvRects
+);
+
+/**
+* @brief Draws a sprite through the sprite batcher, sprites of one layer and material are drawn with one call
+* @param x The x position of the centre of the sprite
+* @param y The y position of the centre of the sprite
+* @param rotation The counter clockwise rotation in radians
+* @param scaleX The width of the sprite
+* @param scaleY The height of the sprite
+* @param uvRect The region to sample as u0, v0, u1, v1
+* @param color The RGBA8 tint, red in the lowest byte
+* @param layer The layer, lower layers are drawn first
+* @param materialId A material whose vertex shader reads the batched sprite attributes
+*/
+EXPORTED extern void Rendering_DrawBatchedSprite(
+	float x,
+	float y,
+	float rotation,
+	float scaleX,
+	float scaleY,
+	const float* uvRect,
+	uint32_t color,
+	uint16_t layer,
+	uint32_t materialId
+);
+
 /**
     @brief Starts the rendering frame
 */
@@ -88,12 +169,30 @@ EXPORTED extern void Rendering_PostFrame();
 EXPORTED uint32_t Rendering_CreateVertexBuffer(const float* vertices, size_t length, size_t elemSize);
 
 /**
-* @brief Updates a vertex buffer
+* @brief Creates a vertex buffer whose contents are replaced often, e.g. every frame
+* @param vertices The initial vertices, may be null
+* @param length The length of the buffer in count of vertices
+* @return The id of the vertex buffer
+*/
+EXPORTED uint32_t Rendering_CreateDynamicVertexBuffer(const float* vertices, size_t length, size_t elemSize);
+
+/**
+* @brief Updates a vertex buffer, the buffer takes the size of the new vertices
 * @param vertexBufferId The id of the vertex buffer to update
 * @param vertices The new vertices to use
+* @param length The size of the new vertices in bytes
 */
 EXPORTED void Rendering_UpdateVertexBuffer(uint32_t vertexBufferId, NativePointer vertices, size_t length);
 
+/**
+* @brief Overwrites part of a vertex buffer
+* @param vertexBufferId The id of the vertex buffer to update
+* @param offset The offset in bytes
+* @param vertices The vertices to write
+* @param length The size of the vertices in bytes
+*/
+EXPORTED void Rendering_UpdateVertexBufferRange(uint32_t vertexBufferId, size_t offset, NativePointer vertices, size_t length);
+
 /**
 * @brief Frees a vertex buffer
 * @param vertexBufferId The id of the vertex buffer to free
@@ -117,11 +216,20 @@ EXPORTED void Rendering_LoadVertexBuffer(uint32_t vertexBufferId, NativePointer*
 EXPORTED uint32_t Rendering_CreateIndexBuffer(const uint32_t* indices, size_t length);
 
 /**
-* @brief Updates an index buffer
+* @brief Creates an index buffer whose contents are replaced often
+* @param indices The initial indices, may be null
+* @param length The length of the buffer in count of indices
+* @return The id of the index buffer
+*/
+EXPORTED uint32_t Rendering_CreateDynamicIndexBuffer(const uint32_t* indices, size_t length);
+
+/**
+* @brief Updates an index buffer, draws use the new number of indices
 * @param indexBufferId The id of the index buffer to update
 * @param indices The new indices to use
+* @param length The number of new indices
 */
-EXPORTED void Rendering_UpdateIndexBuffer(uint32_t indexBufferId, NativePointer indices);
+EXPORTED void Rendering_UpdateIndexBuffer(uint32_t indexBufferId, NativePointer indices, size_t length);
 
 /**
 * @brief Frees an index buffer
@@ -137,6 +245,77 @@ EXPORTED void Rendering_FreeIndexBuffer(uint32_t indexBufferId);
 */
 EXPORTED uint32_t Rendering_CreateVertexArray(uint32_t vertexBufferId, uint32_t indexBufferId);
 
+/**
+* @brief Creates a mesh in the shared mesh buffer
+* @param vertices Interleaved x, y, z, u, v floats
+* @param vertexCount The number of vertices
+* @param indices The indices, relative to the first vertex of the mesh
+* @param indexCount The number of indices
+* @return A vertex array id that can be drawn like the ones from Rendering_CreateVertexArray
+*/
+EXPORTED uint32_t Rendering_CreateMesh(const float* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount);
+
+/**
+* @brief Returns the storage of a mesh created with Rendering_CreateMesh
+* @param meshId The vertex array id of the mesh
+*/
+EXPORTED void Rendering_DestroyMesh(uint32_t meshId);
+
+/**
+* @brief Creates an empty tilemap, drawn as one mesh per chunk of 32 by 32 tiles
+* @param width The number of tiles in a row
+* @param height The number of rows
+* @param tileWidth The width of a tile in world units
+* @param tileHeight The height of a tile in world units
+* @param atlasColumns The number of tile columns in the texture of the material
+* @param atlasRows The number of tile rows in the texture of the material
+* @param materialId The material the tiles are drawn with
+* @return The id of the tilemap
+*/
+EXPORTED uint32_t Rendering_CreateTilemap(
+	uint32_t width,
+	uint32_t height,
+	float tileWidth,
+	float tileHeight,
+	uint32_t atlasColumns,
+	uint32_t atlasRows,
+	uint32_t materialId
+);
+
+/**
+* @brief Replaces a rectangle of tiles. Only the chunks whose tiles changed are rebuilt
+* @param tilemapId The id of the tilemap
+* @param x The column of the first tile
+* @param y The row of the first tile
+* @param width The width of the rectangle
+* @param height The height of the rectangle
+* @param tiles The tiles row by row, atlas cells counted from 1 and 0 for empty tiles
+*/
+EXPORTED void Rendering_SetTilemapTiles(
+	uint32_t tilemapId,
+	uint32_t x,
+	uint32_t y,
+	uint32_t width,
+	uint32_t height,
+	const uint16_t* tiles
+);
+
+/**
+* @brief Draws the chunks of a tilemap that intersect the view
+* @param tilemapId The id of the tilemap
+* @param x The x position of the lower left corner of the map
+* @param y The y position of the lower left corner of the map
+* @param z The z position of the map
+* @param layer The layer the map is drawn in
+*/
+EXPORTED void Rendering_DrawTilemap(uint32_t tilemapId, float x, float y, float z, uint16_t layer);
+
+/**
+* @brief Destroys a tilemap and returns the storage of its chunks
+* @param tilemapId The id of the tilemap
+*/
+EXPORTED void Rendering_DestroyTilemap(uint32_t tilemapId);
+
 /**
 * @brief Creates a shader
 * @param shader The shader code to use
@@ -159,6 +338,30 @@ EXPORTED void Rendering_DestroyShader(uint32_t shaderId);
  */
 EXPORTED uint32_t Rendering_LoadTexture(const uint8_t* data, size_t len);
 
+/**
+ * @brief Creates a texture from a file on disk
+ * @param path The path of the file. Cooked .ktex files are memory mapped and uploaded without decoding
+ * @return The id of the texture, or 0 if the file could not be opened
+ */
+EXPORTED uint32_t Rendering_LoadTextureFile(const char* path);
+
+/**
+* @brief Loads a sprite atlas produced by the bundler
+* @param data The contents of the .atlas file
+* @param len The length of the contents
+* @return The id of the atlas, or 0 if the data is not a valid atlas
+*/
+EXPORTED uint32_t Rendering_LoadAtlas(const uint8_t* data, size_t len);
+
+/**
+* @brief Looks up a named region of a sprite atlas
+* @param atlasId The id of the atlas
+* @param name The name of the region
+* @param uvRect Receives the region as u0, v0, u1, v1
+* @return The atlas page of the region, or UINT32_MAX if the region does not exist
+*/
+EXPORTED uint32_t Rendering_GetAtlasRegion(uint32_t atlasId, const char* name, float* uvRect);
+
 /**
 * @brief Creates a material
 * @param shaderId The id of the shader to use
@@ -181,6 +384,84 @@ EXPORTED uint32_t Rendering_CopyMaterial(uint32_t materialId);
 */
 EXPORTED void Rendering_SetMaterialTexture(uint32_t materialId, uint32_t textureId, const char* name);
 
+/**
+* @brief Moves a material between the blended pass, the default, and the opaque pass
+* @param materialId The id of the material
+* @param opaque Whether draws of the material are depth tested and written and not blended
+*/
+EXPORTED void Rendering_SetMaterialOpaque(uint32_t materialId, bool opaque);
+
+/**
+* @brief Whether the shaders of a material finished compiling. Until then it is drawn flat grey
+* @param materialId The id of the material
+* @return False while the shaders compile, or if they failed to
+*/
+EXPORTED bool Rendering_IsMaterialReady(uint32_t materialId);
+
+/**
+* @brief Sets a float parameter of the material block
+* @param materialId The id of the material
+* @param name The name of the member in the shader
+* @param value The value
+*/
+EXPORTED void Rendering_SetMaterialFloat(uint32_t materialId, const char* name, float value);
+
+/**
+* @brief Sets an int parameter of the material block
+* @param materialId The id of the material
+* @param name The name of the member in the shader
+* @param value The value
+*/
+EXPORTED void Rendering_SetMaterialInt(uint32_t materialId, const char* name, uint32_t value);
+
+/**
+* @brief Sets a vector parameter of the material block
+* @param materialId The id of the material
+* @param name The name of the member in the shader
+* @param values The components
+* @param count The number of components, 2 to 4
+*/
+EXPORTED void Rendering_SetMaterialVector(uint32_t materialId, const char* name, const float* values, size_t count);
+
+/**
+* @brief Reads the GL state counters of the last presented frame
+* @param stateChanges Receives the number of state changes that reached the driver
+* @param redundantStateChanges Receives the number of state changes that were skipped
+*/
+EXPORTED void Rendering_GetStateStats(uint64_t* stateChanges, uint64_t* redundantStateChanges);
+
+/**
+* @brief Reads the CPU times of the last frame and the GPU time of a frame a few frames back, in milliseconds
+* @param cpuFrame Receives the time from the start of one frame to the start of the next
+* @param preFrame Receives the time spent in PreFrame
+* @param postFrame Receives the time spent in PostFrame, without drawing the frame
+* @param render Receives the time spent recording and submitting the frame
+* @param swap Receives the time spent presenting the frame
+* @param gpuFrame Receives the GPU time of the frame, 0 where the device does not measure it
+*/
+EXPORTED void Rendering_GetFrameTimings(double* cpuFrame, double* preFrame, double* postFrame, double* render, double* swap, double* gpuFrame);
+
+/**
+* @brief The number of GPU timed scopes of the last frame that was read back, passes included
+*/
+EXPORTED size_t Rendering_GetPassTimingCount(void);
+
+/**
+* @brief Reads one GPU timed scope
+* @param index The index of the scope, scopes are in the order they were opened
+* @param name Receives the name of the scope, truncated to fit and always terminated
+* @param nameLength The size of name in bytes
+* @param gpuTime Receives the GPU time of the scope in milliseconds
+* @return False if there is no scope at the index
+*/
+EXPORTED bool Rendering_GetPassTiming(size_t index, char* name, size_t nameLength, double* gpuTime);
+
+/**
+* @brief Shows or hides an ImGui window with the frame timings
+* @param visible Whether to show the window
+*/
+EXPORTED void Rendering_SetTimingOverlay(bool visible);
+
 #ifdef __cplusplus 
 }
 #endif
@@ -10,6 +10,9 @@ public func main(isDebug: Bool = false) {
     // Register the component types
     let spriteComponent = ECS.registerComponent(type: SpriteComponent.self, name: "SpriteComponent")
     let transformComponentId = ECS.registerComponent(type: TransformComponent.self, name: "TransformComponent")
+    // Registered natively as well, the name maps this mirror onto the same component
+    let flipbookComponentId = ECS.registerComponent(type: FlipbookComponent.self, name: "FlipbookComponent")
+    let tilemapComponentId = ECS.registerComponent(type: TilemapComponent.self, name: "TilemapComponent")
     let playerComponentId = ECS.registerComponent(type: PlayerComponent.self, name: "PlayerComponent")
     let moveComponentId = ECS.registerComponent(type: MoveComponent.self, name: "MoveComponent")
     // Create the entities
@@ -27,15 +30,18 @@ public func main(isDebug: Bool = false) {
     // Ground material
     var groundMaterial = Material(path: "content/materials/ground_stones_mossy.mat")
 
-    for x in 0..<(640 / 32) + 1 {
-        for y in 0..<(360 / 32) + 1 {
-            let entity = Entity("Ground\(x)_\(y)")
-            entity.addComponent(SpriteComponent.self)
-            entity.addComponent(TransformComponent.self)
-            entity.setComponent(SpriteComponent(material: groundMaterial))
-            entity.setComponent(TransformComponent(position: Vector3(x: Float(x) * 32, y: Float(y) * 32, z: 0), rotation: 0, scale: Vector3(x: 32, y: 32, z: 1)))
-        }
-    }
+    // The ground is one tilemap of whole texture tiles, drawn a chunk at a time instead of a sprite per tile
+    let groundColumns: UInt32 = 640 / 32 + 1
+    let groundRows: UInt32 = 360 / 32 + 1
+    let ground = Tilemap(width: groundColumns, height: groundRows, tileSize: Vector2(x: 32, y: 32), atlasColumns: 1, atlasRows: 1, material: groundMaterial)
+    ground.setTiles(x: 0, y: 0, width: groundColumns, height: groundRows, tiles: Array(repeating: 1, count: Int(groundColumns * groundRows)))
+
+    let groundEntity = Entity("Ground")
+    groundEntity.addComponent(TilemapComponent.self)
+    groundEntity.addComponent(TransformComponent.self)
+    groundEntity.setComponent(TilemapComponent(tilemap: ground))
+    // Tiles are placed from the corner of the map, sprites from their centre
+    groundEntity.setComponent(TransformComponent(position: Vector3(x: -16, y: -16, z: 0), rotation: 0, scale: Vector3(x: 1, y: 1, z: 1)))
 
     for x: UInt64 in 0..<2500 {
         randomX = Float.random(in: 200..<1200)
@@ -63,6 +69,7 @@ public func main(isDebug: Bool = false) {
 
     let hierarchySystem = HierarchySystem()
     let renderSystem: RenderSystem = RenderSystem()
+    let tilemapSystem: TilemapSystem = TilemapSystem()
     let movementSystem: MovementSystem = MovementSystem()
     let inputSystem: InputSystem = InputSystem()
 }
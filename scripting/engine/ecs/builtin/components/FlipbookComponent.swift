@@ -0,0 +1,19 @@
+/// Plays a flipbook clip on a sprite. The engine advances it natively before script systems run
+/// and the render system draws the region it writes, so scripts only set it up.
+/// Mirrors the native FlipbookComponent field by field.
+@Component
+public struct FlipbookComponent {
+    public var clip: UInt32
+    public var speed: Float
+    public var time: Float
+    public var frame: UInt32
+    public var uvRect: Vector4
+
+    public init(clip: Flipbook, speed: Float = 1, time: Float = 0) {
+        self.clip = clip.id
+        self.speed = speed
+        self.time = time
+        self.frame = 0
+        self.uvRect = Vector4(x: 0, y: 0, z: 1, w: 1)
+    }
+}
@@ -0,0 +1,11 @@
+/// Draws a tilemap with its lower left corner at the position of the transform
+@Component
+public struct TilemapComponent {
+    public var tilemap: UInt32
+    public var layer: UInt16
+
+    public init(tilemap: Tilemap, layer: UInt16 = 0) {
+        self.tilemap = tilemap.id
+        self.layer = layer
+    }
+}
@@ -19,6 +19,9 @@ class RenderSystem {
                 ECS.getComponentId(type: SpriteComponent.self), 
                 ECS.getComponentId(type: TransformComponent.self)
             ],
+            optional: [
+                ECS.getComponentId(type: FlipbookComponent.self)
+            ],
             isParallel: true
         ) { iterator in
             guard let iterator = iterator else {
@@ -27,19 +30,50 @@ class RenderSystem {
             // Get the size of the buffer
             let sprites = ECS.getIteratorData(it: iterator, index: 0, type: SpriteComponent.self)
             let transforms = ECS.getIteratorData(it: iterator, index: 1, type: TransformComponent.self)
+            // Nil for sprites without an animation
+            let flipbooks = ECS.getIteratorData(it: iterator, index: 2, type: FlipbookComponent.self)
 
-            RenderSystem.run(sprites: sprites!, transforms: transforms!)
+            RenderSystem.run(sprites: sprites!, transforms: transforms!, flipbooks: flipbooks)
         }
     }
 
     @inline(__always)
-    static func run(sprites: UnsafeMutableBufferPointer<SpriteComponent>, transforms: UnsafeMutableBufferPointer<TransformComponent>) {
-        // Draw each sprite
-        for x in 0..<sprites.count {
-            let sprite = sprites[x]
+    static func run(
+        sprites: UnsafeMutableBufferPointer<SpriteComponent>,
+        transforms: UnsafeMutableBufferPointer<TransformComponent>,
+        flipbooks: UnsafeMutableBufferPointer<FlipbookComponent>?
+    ) {
+        // The table goes to the engine in one call, the matrices are built natively
+        let count = sprites.count
+        var positions = [Float]()
+        var rotations = [Float]()
+        var scales = [Float]()
+        var materials = [UInt32]()
+        positions.reserveCapacity(count * 3)
+        rotations.reserveCapacity(count)
+        scales.reserveCapacity(count * 3)
+        materials.reserveCapacity(count)
+
+        for x in 0..<count {
             let transform = transforms[x]
+            positions.append(contentsOf: [transform.position.x, transform.position.y, transform.position.z])
+            rotations.append(transform.rotation)
+            scales.append(contentsOf: [transform.scale.x, transform.scale.y, transform.scale.z])
+            materials.append(sprites[x].material.resource.id)
+        }
 
-            Renderer.drawSprite(position: transform.position, rotation: transform.rotation, scale: transform.scale, material: sprite.material)
+        // The engine already advanced the flipbooks, their regions are passed on as they are
+        var uvRects: [Float]? = nil
+        if let flipbooks {
+            var rects = [Float]()
+            rects.reserveCapacity(count * 4)
+            for x in 0..<count {
+                let rect = flipbooks[x].uvRect
+                rects.append(contentsOf: [rect.x, rect.y, rect.z, rect.w])
+            }
+            uvRects = rects
         }
+
+        Renderer.drawSprites(positions: positions, rotations: rotations, scales: scales, materials: materials, uvRects: uvRects)
     }
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+@_implementationOnly import Native
+
+class TilemapSystem {
+
+    init() {
+        ECS.registerSystem(
+            name: "TilemapSystem",
+            components: [
+                ECS.getComponentId(type: TilemapComponent.self),
+                ECS.getComponentId(type: TransformComponent.self)
+            ],
+            isParallel: true
+        ) { iterator in
+            guard let iterator = iterator else {
+                return
+            }
+            let tilemaps = ECS.getIteratorData(it: iterator, index: 0, type: TilemapComponent.self)
+            let transforms = ECS.getIteratorData(it: iterator, index: 1, type: TransformComponent.self)
+
+            TilemapSystem.run(tilemaps: tilemaps!, transforms: transforms!)
+        }
+    }
+
+    @inline(__always)
+    static func run(tilemaps: UnsafeMutableBufferPointer<TilemapComponent>, transforms: UnsafeMutableBufferPointer<TransformComponent>) {
+        // One call per map, the engine culls and draws its chunks
+        for x in 0..<tilemaps.count {
+            let position = transforms[x].position
+            NativeRendering.drawTilemap(tilemap: tilemaps[x].tilemap, x: position.x, y: position.y, z: position.z, layer: tilemaps[x].layer)
+        }
+    }
+}
@@ -0,0 +1,37 @@
+@_implementationOnly import Native
+
+/// A flipbook clip, the frames of a sprite animation in one texture
+public struct Flipbook {
+    public enum PlaybackMode: UInt32 {
+        /// Stops on the last frame
+        case once = 0
+        /// Starts over from the first frame
+        case loop = 1
+        /// Plays backwards to the first frame, then forwards again
+        case pingPong = 2
+    }
+
+    internal let id: UInt32
+
+    /// Creates a clip from the region (u0, v0, u1, v1) and duration in seconds of every frame
+    public init(frames: [Vector4], durations: [Float], mode: PlaybackMode = .loop) {
+        precondition(frames.count == durations.count, "Every flipbook frame needs a duration")
+        let rects = frames.flatMap { [$0.x, $0.y, $0.z, $0.w] }
+        self.id = ECS.createFlipbook(rects: rects, durations: durations, mode: mode.rawValue)
+    }
+
+    /// Creates a clip from a row of equally sized cells, each shown for the same time
+    public init(row: Int, columns: Int, rows: Int, frameCount: Int, frameDuration: Float, mode: PlaybackMode = .loop) {
+        let width = 1 / Float(columns)
+        let height = 1 / Float(rows)
+        let frames = (0..<frameCount).map { frame in
+            Vector4(
+                x: Float(frame) * width,
+                y: Float(row) * height,
+                z: Float(frame + 1) * width,
+                w: Float(row + 1) * height
+            )
+        }
+        self.init(frames: frames, durations: Array(repeating: frameDuration, count: frameCount), mode: mode)
+    }
+}
@@ -29,6 +29,21 @@ public struct Material: Equatable, Hashable {
         NativeRendering.setMaterialTexture(material: resource.id, texture: texture.resource.id, name: name)
     }
 
+    @MainActor
+    public func setFloat(for name: String, value: Float) {
+        NativeRendering.setMaterialFloat(material: resource.id, name: name, value: value)
+    }
+
+    @MainActor
+    public func setInt(for name: String, value: UInt32) {
+        NativeRendering.setMaterialInt(material: resource.id, name: name, value: value)
+    }
+
+    @MainActor
+    public func setVector(for name: String, value: Vector4) {
+        NativeRendering.setMaterialVector(material: resource.id, name: name, values: [value.x, value.y, value.z, value.w])
+    }
+
     public static func == (lhs: Material, rhs: Material) -> Bool {
         return lhs.resource == rhs.resource
     }
@@ -12,4 +12,28 @@ public enum Renderer {
         ]
         NativeRendering.drawSprite(transform: transform, material: material.resource.id)
     }
+
+    /// Draws many sprites with one call into the engine, which builds the same matrices as drawSprite
+    /// uvRects holds the region (u0, v0, u1, v1) of every sprite, without it whole textures are drawn
+    public static func drawSprites(positions: [Float], rotations: [Float], scales: [Float], materials: [UInt32], uvRects: [Float]? = nil) {
+        guard let uvRects else {
+            NativeRendering.drawSprites(
+                count: materials.count,
+                positions: positions,
+                rotations: rotations,
+                scales: scales,
+                materials: materials
+            )
+            return
+        }
+
+        NativeRendering.drawSprites(
+            count: materials.count,
+            positions: positions,
+            rotations: rotations,
+            scales: scales,
+            materials: materials,
+            uvRects: uvRects
+        )
+    }
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+@_implementationOnly import Native
+
+/// A static grid of tiles. The engine draws it as one mesh per chunk of 32 by 32 tiles
+/// and only rebuilds the chunks whose tiles changed.
+public struct Tilemap {
+    /// Leaves a tile empty, other tiles count the cells of the atlas row by row from 1
+    public static let emptyTile: UInt16 = 0
+
+    internal let id: UInt32
+    public let width: UInt32
+    public let height: UInt32
+
+    public init(width: UInt32, height: UInt32, tileSize: Vector2, atlasColumns: UInt32, atlasRows: UInt32, material: Material) {
+        self.width = width
+        self.height = height
+        self.id = NativeRendering.createTilemap(
+            width: width,
+            height: height,
+            tileWidth: tileSize.x,
+            tileHeight: tileSize.y,
+            atlasColumns: atlasColumns,
+            atlasRows: atlasRows,
+            material: material.resource.id
+        )
+    }
+
+    /// Replaces a rectangle of tiles, given row by row
+    public func setTiles(x: UInt32, y: UInt32, width: UInt32, height: UInt32, tiles: [UInt16]) {
+        precondition(tiles.count == Int(width * height), "Expected one tile for every cell of the rectangle")
+        NativeRendering.setTilemapTiles(tilemap: id, x: x, y: y, width: width, height: height, tiles: tiles)
+    }
+
+    public func setTile(x: UInt32, y: UInt32, tile: UInt16) {
+        NativeRendering.setTilemapTiles(tilemap: id, x: x, y: y, width: 1, height: 1, tiles: [tile])
+    }
+
+    public func destroy() {
+        NativeRendering.destroyTilemap(tilemap: id)
+    }
+}
@@ -71,6 +71,22 @@ public class ResourceManager {
             NativeRendering.setMaterialTexture(material: resource.id, texture: textureResource.id, name: texture.key)
         }
 
+        for (name, value) in material.ints {
+            NativeRendering.setMaterialInt(material: resource.id, name: name, value: UInt32(truncatingIfNeeded: value))
+        }
+        for (name, value) in material.floats {
+            NativeRendering.setMaterialFloat(material: resource.id, name: name, value: value)
+        }
+        for (name, value) in material.vectors2 {
+            NativeRendering.setMaterialVector(material: resource.id, name: name, values: [value.x, value.y])
+        }
+        for (name, value) in material.vectors3 {
+            NativeRendering.setMaterialVector(material: resource.id, name: name, values: [value.x, value.y, value.z])
+        }
+        for (name, value) in material.vectors4 {
+            NativeRendering.setMaterialVector(material: resource.id, name: name, values: [value.x, value.y, value.z, value.w])
+        }
+
         return resource
     }
 
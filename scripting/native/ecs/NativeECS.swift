@@ -64,6 +64,23 @@ public enum ECS {
         )
     }
 
+    /// Like registerSystem, but the optional components come after the required ones and are nil where a table lacks them
+    public static func registerSystem(name: String, components: [UInt64], optional: [UInt64], isParallel: Bool, block: (@convention(c) (UnsafeMutableRawPointer?) -> Void)?) -> UInt64 {
+        ECS_RegisterSystemWithOptional(
+            name.cString(using: .utf8),
+            components,
+            Int(components.count),
+            optional,
+            Int(optional.count),
+            isParallel,
+            block
+        )
+    }
+
+    public static func createFlipbook(rects: [Float], durations: [Float], mode: UInt32) -> UInt32 {
+        ECS_CreateFlipbook(rects, durations, durations.count, mode)
+    }
+
     public static func getComponentId<T>(type: T.Type) -> UInt64 {
         id(for: T.self)
     }
@@ -14,6 +14,35 @@ public enum NativeRendering {
         return Rendering_LoadTexture(buffer, size)
     }
 
+    /// Loads a texture straight from disk. Cooked .ktex textures are memory mapped instead of read into a buffer
+    public static func loadTextureFile(path: String) -> UInt32 {
+        return Rendering_LoadTextureFile(path.cString(using: .utf8))
+    }
+
+    public static func loadAtlas(path: String) -> UInt32 {
+        var buffer: UnsafeMutablePointer<UInt8>? = nil
+        var size: Int = 0
+        let result = IO_LoadFile(path.cString(using: .utf8), &buffer, &size)
+
+        guard result == 0 else {
+            return 0
+        }
+
+        return Rendering_LoadAtlas(buffer, size)
+    }
+
+    /// Returns the atlas page and the u0, v0, u1, v1 rect of a named region, or nil if it does not exist
+    public static func atlasRegion(atlas: UInt32, name: String) -> (page: UInt32, uvRect: [Float])? {
+        var uvRect: [Float] = [0, 0, 1, 1]
+        let page = Rendering_GetAtlasRegion(atlas, name.cString(using: .utf8), &uvRect)
+
+        guard page != UInt32.max else {
+            return nil
+        }
+
+        return (page, uvRect)
+    }
+
     public static func createShader(path: String, type: UInt8) -> UInt32 {
         var buffer: UnsafeMutablePointer<UInt8>? = nil
         var size: Int = 0
@@ -38,8 +67,127 @@ public enum NativeRendering {
         Rendering_SetMaterialTexture(material, texture, name.cString(using: .utf8))
     }
 
+    public static func setMaterialOpaque(material: UInt32, opaque: Bool) {
+        Rendering_SetMaterialOpaque(material, opaque)
+    }
+
+    public static func isMaterialReady(material: UInt32) -> Bool {
+        return Rendering_IsMaterialReady(material)
+    }
+
+    public static func setMaterialFloat(material: UInt32, name: String, value: Float) {
+        Rendering_SetMaterialFloat(material, name.cString(using: .utf8), value)
+    }
+
+    public static func setMaterialInt(material: UInt32, name: String, value: UInt32) {
+        Rendering_SetMaterialInt(material, name.cString(using: .utf8), value)
+    }
+
+    public static func setMaterialVector(material: UInt32, name: String, values: [Float]) {
+        Rendering_SetMaterialVector(material, name.cString(using: .utf8), values, values.count)
+    }
+
     @inline(__always)
     public static func drawSprite(transform: [Float], material: UInt32) {
         Rendering_DrawSprite(transform, material)
     }
+
+    @inline(__always)
+    public static func drawSprite(transform: [Float], material: UInt32, uvRect: [Float]) {
+        Rendering_DrawSpriteRegion(transform, material, uvRect)
+    }
+
+    @inline(__always)
+    public static func drawSprite(transform: [Float], material: UInt32, uvRect: [Float], layer: UInt16) {
+        Rendering_DrawSpriteLayer(transform, material, uvRect, layer)
+    }
+
+    @inline(__always)
+    public static func drawSprites(
+        count: Int,
+        positions: UnsafePointer<Float>,
+        rotations: UnsafePointer<Float>,
+        scales: UnsafePointer<Float>,
+        materials: UnsafePointer<UInt32>,
+        uvRects: UnsafePointer<Float>? = nil
+    ) {
+        Rendering_DrawSprites(count, positions, rotations, scales, materials, uvRects)
+    }
+
+    @inline(__always)
+    public static func drawBatchedSprite(
+        x: Float,
+        y: Float,
+        rotation: Float,
+        scaleX: Float,
+        scaleY: Float,
+        uvRect: [Float] = [0, 0, 1, 1],
+        color: UInt32 = 0xFFFFFFFF,
+        layer: UInt16,
+        material: UInt32
+    ) {
+        Rendering_DrawBatchedSprite(x, y, rotation, scaleX, scaleY, uvRect, color, layer, material)
+    }
+
+    public static func createTilemap(
+        width: UInt32,
+        height: UInt32,
+        tileWidth: Float,
+        tileHeight: Float,
+        atlasColumns: UInt32,
+        atlasRows: UInt32,
+        material: UInt32
+    ) -> UInt32 {
+        Rendering_CreateTilemap(width, height, tileWidth, tileHeight, atlasColumns, atlasRows, material)
+    }
+
+    public static func setTilemapTiles(tilemap: UInt32, x: UInt32, y: UInt32, width: UInt32, height: UInt32, tiles: [UInt16]) {
+        Rendering_SetTilemapTiles(tilemap, x, y, width, height, tiles)
+    }
+
+    @inline(__always)
+    public static func drawTilemap(tilemap: UInt32, x: Float, y: Float, z: Float, layer: UInt16) {
+        Rendering_DrawTilemap(tilemap, x, y, z, layer)
+    }
+
+    public static func destroyTilemap(tilemap: UInt32) {
+        Rendering_DestroyTilemap(tilemap)
+    }
+
+    public static func stateStats() -> (stateChanges: UInt64, redundantStateChanges: UInt64) {
+        var stateChanges: UInt64 = 0
+        var redundantStateChanges: UInt64 = 0
+        Rendering_GetStateStats(&stateChanges, &redundantStateChanges)
+
+        return (stateChanges, redundantStateChanges)
+    }
+
+    public static func frameTimings() -> (cpuFrame: Double, preFrame: Double, postFrame: Double, render: Double, swap: Double, gpuFrame: Double) {
+        var cpuFrame = 0.0
+        var preFrame = 0.0
+        var postFrame = 0.0
+        var render = 0.0
+        var swap = 0.0
+        var gpuFrame = 0.0
+        Rendering_GetFrameTimings(&cpuFrame, &preFrame, &postFrame, &render, &swap, &gpuFrame)
+
+        return (cpuFrame, preFrame, postFrame, render, swap, gpuFrame)
+    }
+
+    public static func passTimings() -> [(name: String, gpuTime: Double)] {
+        var timings: [(name: String, gpuTime: Double)] = []
+        var name = [CChar](repeating: 0, count: 64)
+        for index in 0..<Rendering_GetPassTimingCount() {
+            var gpuTime = 0.0
+            if Rendering_GetPassTiming(index, &name, name.count, &gpuTime) {
+                timings.append((String(cString: name), gpuTime))
+            }
+        }
+
+        return timings
+    }
+
+    public static func setTimingOverlay(_ visible: Bool) {
+        Rendering_SetTimingOverlay(visible)
+    }
 }
\ No newline at end of file
@@ -60,9 +60,16 @@ void setup() {
 	});
 }
 
-int main() {
+int main(int argc, char** argv) {
 	setup();
 
+	// Simulation and GL submission overlap, the frame on screen is one behind the simulated one
+	for (int x = 1; x < argc; x++) {
+		if (std::string(argv[x]) == "--render-thread") {
+			Rendering_StartRenderThread(1);
+		}
+	}
+
 	float deltaTime = 0.0f;
 	while (true) {
 		// Calculate delta time
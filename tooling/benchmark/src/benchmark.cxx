@@ -0,0 +1,369 @@
+#include <rendering/Rendering.hxx>
+#include <imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace rendering = kyanite::engine::rendering;
+
+constexpr const char* VertexShader = R"(#version 450 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 uv;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec4 uvRect;
+
+out vec2 fragmentUv;
+
+void main() {
+    fragmentUv = mix(uvRect.xy, uvRect.zw, uv);
+    gl_Position = projection * view * model * vec4(position, 1.0);
+}
+)";
+
+constexpr const char* InstancedVertexShader = R"(#version 450 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 uv;
+layout(location = 2) in mat4 instanceModel;
+layout(location = 6) in vec4 instanceUvRect;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 fragmentUv;
+
+void main() {
+    fragmentUv = mix(instanceUvRect.xy, instanceUvRect.zw, uv);
+    gl_Position = projection * view * instanceModel * vec4(position, 1.0);
+}
+)";
+
+// Expands the shared quad from the 32 byte sprite instances of the sprite batcher
+constexpr const char* BatchedVertexShader = R"(#version 450 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 uv;
+layout(location = 2) in vec3 instancePositionRotation;
+layout(location = 3) in vec2 instanceScale;
+layout(location = 4) in vec4 instanceUvRect;
+layout(location = 5) in vec4 instanceColor;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 fragmentUv;
+
+void main() {
+    float s = sin(instancePositionRotation.z);
+    float c = cos(instancePositionRotation.z);
+    vec2 local = position.xy * instanceScale;
+    vec2 world = instancePositionRotation.xy + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+
+    fragmentUv = mix(instanceUvRect.xy, instanceUvRect.zw, uv);
+    gl_Position = projection * view * vec4(world, 1.0, 1.0);
+}
+)";
+
+// Tinted by the uv, so captures show broken attribute setups right away
+constexpr const char* FragmentShader = R"(#version 450 core
+in vec2 fragmentUv;
+out vec4 color;
+
+void main() {
+    color = vec4(fragmentUv, 0.5, 1.0);
+}
+)";
+
+struct Options {
+    uint32_t frames = 1000;
+    uint32_t warmupFrames = 30;
+    uint32_t sprites = 10000;
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    bool instanced = false;
+    bool batched = false;
+    // The same draws as the default mode, submitted as one table
+    bool bulk = false;
+    // Depth tested front to back instead of blended back to front
+    bool opaque = false;
+    bool renderThread = false;
+    // Submission, culling, sorting and batching without a GPU, through the null device
+    bool null = false;
+    std::string capturePath;
+};
+
+struct Sprite {
+    glm::vec2 center;
+    float radius;
+    float speed;
+    float phase;
+    float size;
+};
+
+auto ParseOptions(int argc, char** argv, Options& options) -> bool {
+    for (int x = 1; x < argc; x++) {
+        std::string argument = argv[x];
+        auto value = [&]() -> std::string {
+            return x + 1 < argc ? argv[++x] : "";
+        };
+        // A missing, negative or malformed count fails the parse instead of throwing
+        auto count = [&](uint32_t& out) -> bool {
+            auto text = value();
+            auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+            if (text.empty() || result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+                std::cerr << "Expected a number after " << argument << std::endl;
+                return false;
+            }
+            return true;
+        };
+
+        auto valid = true;
+        if (argument == "--frames") {
+            valid = count(options.frames);
+        }
+        else if (argument == "--warmup") {
+            valid = count(options.warmupFrames);
+        }
+        else if (argument == "--sprites") {
+            valid = count(options.sprites);
+        }
+        else if (argument == "--width") {
+            valid = count(options.width);
+        }
+        else if (argument == "--height") {
+            valid = count(options.height);
+        }
+        else if (argument == "--capture") {
+            options.capturePath = value();
+            valid = !options.capturePath.empty();
+        }
+        else if (argument == "--instanced") {
+            options.instanced = true;
+        }
+        else if (argument == "--batched") {
+            options.batched = true;
+        }
+        else if (argument == "--bulk") {
+            options.bulk = true;
+        }
+        else if (argument == "--opaque") {
+            options.opaque = true;
+        }
+        else if (argument == "--render-thread") {
+            options.renderThread = true;
+        }
+        else if (argument == "--null") {
+            options.null = true;
+        }
+        else {
+            std::cerr << "Unknown argument " << argument << std::endl;
+            return false;
+        }
+
+        if (!valid) {
+            return false;
+        }
+    }
+
+    return options.frames > 0 && options.width > 0 && options.height > 0;
+}
+
+// The same scene on every run, sprites orbit points scattered over the 640x360 world
+auto ScriptScene(uint32_t count) -> std::vector<Sprite> {
+    std::vector<Sprite> sprites(count);
+    uint32_t state = 0x9E3779B9u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+    };
+
+    for (auto& sprite : sprites) {
+        sprite.center = { next() * 640.0f, next() * 360.0f };
+        sprite.radius = 4.0f + next() * 32.0f;
+        sprite.speed = 0.5f + next() * 2.0f;
+        sprite.phase = next() * 6.2831853f;
+        sprite.size = 2.0f + next() * 6.0f;
+    }
+
+    return sprites;
+}
+
+auto DrawScene(const std::vector<Sprite>& sprites, uint32_t material, uint32_t frame) -> void {
+    auto time = static_cast<float>(frame) / 60.0f;
+    for (auto& sprite : sprites) {
+        auto angle = sprite.phase + time * sprite.speed;
+        auto position = sprite.center + glm::vec2(std::cos(angle), std::sin(angle)) * sprite.radius;
+
+        auto model = glm::translate(glm::mat4(1.0f), glm::vec3(position, 1.0f));
+        model = glm::rotate(model, angle, glm::vec3(0.0f, 0.0f, 1.0f));
+        model = glm::scale(model, glm::vec3(sprite.size, sprite.size, 1.0f));
+
+        rendering::DrawSprite(model, material);
+    }
+}
+
+auto DrawBulkScene(const std::vector<Sprite>& sprites, uint32_t material, uint32_t frame) -> void {
+    static std::vector<float> positions;
+    static std::vector<float> rotations;
+    static std::vector<float> scales;
+    static std::vector<uint32_t> materials;
+    positions.clear();
+    rotations.clear();
+    scales.clear();
+    materials.clear();
+
+    auto time = static_cast<float>(frame) / 60.0f;
+    for (auto& sprite : sprites) {
+        auto angle = sprite.phase + time * sprite.speed;
+        auto position = sprite.center + glm::vec2(std::cos(angle), std::sin(angle)) * sprite.radius;
+
+        positions.insert(positions.end(), { position.x, position.y, 1.0f });
+        rotations.push_back(angle);
+        scales.insert(scales.end(), { sprite.size, sprite.size, 1.0f });
+        materials.push_back(material);
+    }
+
+    rendering::DrawSprites(sprites.size(), positions.data(), rotations.data(), scales.data(), materials.data());
+}
+
+auto DrawBatchedScene(const std::vector<Sprite>& sprites, uint32_t material, uint32_t frame) -> void {
+    auto time = static_cast<float>(frame) / 60.0f;
+    for (auto& sprite : sprites) {
+        auto angle = sprite.phase + time * sprite.speed;
+        auto position = sprite.center + glm::vec2(std::cos(angle), std::sin(angle)) * sprite.radius;
+
+        rendering::DrawBatchedSprite(position, angle, { sprite.size, sprite.size }, { 0.0f, 0.0f, 1.0f, 1.0f }, 0xFFFFFFFFu, 0, material);
+    }
+}
+
+auto Report(const char* name, std::vector<double> times) -> void {
+    if (times.empty()) {
+        return;
+    }
+
+    std::sort(times.begin(), times.end());
+    auto percentile = [&times](double fraction) {
+        return times[std::min(times.size() - 1, static_cast<size_t>(fraction * times.size()))];
+    };
+    auto average = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+
+    std::cout << std::fixed << std::setprecision(3)
+        << name << " frame time (ms): "
+        << "min " << times.front()
+        << ", avg " << average
+        << ", p50 " << percentile(0.50)
+        << ", p95 " << percentile(0.95)
+        << ", p99 " << percentile(0.99)
+        << ", max " << times.back()
+        << std::endl;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: benchmark [--frames N] [--warmup N] [--sprites N] [--width N] [--height N] "
+            << "[--instanced] [--batched] [--bulk] [--opaque] [--render-thread] [--null] [--capture frame.png]" << std::endl;
+        return 1;
+    }
+
+    auto context = ImGui::CreateContext();
+    rendering::InitHeadless(
+        options.width,
+        options.height,
+        context,
+        options.null ? rendering::RenderBackendType::Null : rendering::RenderBackendType::OpenGL
+    );
+
+    auto vertexSource = options.batched ? BatchedVertexShader : options.instanced ? InstancedVertexShader : VertexShader;
+    auto vertexShader = rendering::LoadShader(vertexSource, rendering::ShaderType::VERTEX);
+    auto fragmentShader = rendering::LoadShader(FragmentShader, rendering::ShaderType::FRAGMENT);
+    auto material = rendering::CreateMaterial(fragmentShader, vertexShader, options.instanced || options.batched);
+    rendering::SetMaterialOpaque(material, options.opaque);
+
+    if (options.renderThread) {
+        rendering::StartRenderThread(1);
+    }
+
+    auto sprites = ScriptScene(options.sprites);
+
+    std::vector<double> cpuTimes;
+    std::vector<double> gpuTimes;
+    rendering::FrameStats totals;
+    cpuTimes.reserve(options.frames);
+    gpuTimes.reserve(options.frames);
+
+    auto totalFrames = options.warmupFrames + options.frames;
+    for (uint32_t frame = 0; frame < totalFrames; frame++) {
+        // The last frame is the one written out
+        if (frame + 1 == totalFrames && !options.capturePath.empty()) {
+            rendering::CaptureFrame(options.capturePath);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        rendering::PreFrame();
+        if (options.batched) {
+            DrawBatchedScene(sprites, material, frame);
+        }
+        else if (options.bulk) {
+            DrawBulkScene(sprites, material, frame);
+        }
+        else {
+            DrawScene(sprites, material, frame);
+        }
+        rendering::Update(1.0f / 60.0f);
+        rendering::PostFrame();
+        auto end = std::chrono::steady_clock::now();
+
+        if (frame < options.warmupFrames) {
+            continue;
+        }
+
+        // The stats belong to the last presented frame, which trails by one with a render thread
+        auto stats = rendering::GetFrameStats();
+        cpuTimes.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        gpuTimes.push_back(stats.gpuFrameTime);
+        totals.stateChanges += stats.stateChanges;
+        totals.redundantStateChanges += stats.redundantStateChanges;
+        totals.commands += stats.commands;
+        totals.drawCalls += stats.drawCalls;
+        totals.uploadedBytes += stats.uploadedBytes;
+    }
+
+    rendering::Shutdown();
+
+    std::cout << "Frames: " << options.frames << ", sprites: " << options.sprites
+        << (options.instanced ? ", instanced" : "")
+        << (options.batched ? ", batched" : "")
+        << (options.bulk ? ", bulk" : "")
+        << (options.opaque ? ", opaque" : "")
+        << (options.renderThread ? ", render thread" : "")
+        << (options.null ? ", null device" : "") << std::endl;
+    Report("CPU", cpuTimes);
+    if (!options.null) {
+        Report("GPU", gpuTimes);
+    }
+
+    std::cout << "Per frame: "
+        << totals.stateChanges / options.frames << " state changes, "
+        << totals.redundantStateChanges / options.frames << " redundant";
+    // Only the null device counts these
+    if (options.null) {
+        std::cout << ", "
+            << totals.commands / options.frames << " commands, "
+            << totals.drawCalls / options.frames << " draw calls, "
+            << totals.uploadedBytes / options.frames << " bytes uploaded";
+    }
+    std::cout << std::endl;
+
+    return 0;
+}
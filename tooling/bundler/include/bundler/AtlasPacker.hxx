@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct PackedRect {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+};
+
+// MaxRects bin packer using the best short side fit heuristic
+class AtlasPacker {
+public:
+    AtlasPacker(uint32_t width, uint32_t height);
+
+    // Places a rect of the given size. Returns false if it does not fit into the remaining space.
+    auto Insert(uint32_t width, uint32_t height, PackedRect& result) -> bool;
+
+    // The share of the bin that is covered by placed rects
+    auto Occupancy() const -> float;
+
+private:
+    auto SplitFreeRect(const PackedRect& freeRect, const PackedRect& usedRect) -> bool;
+    auto PruneFreeRects() -> void;
+
+    uint32_t _width;
+    uint32_t _height;
+    uint64_t _usedArea = 0;
+    std::vector<PackedRect> _freeRects;
+    std::vector<PackedRect> _newFreeRects;
+};
@@ -1,9 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+struct Atlas {
+    std::string name;
+    uint32_t size = 2048;
+    uint32_t padding = 2;
+    std::vector<std::string> images;
+};
+
 struct Bundle {
     std::string name;
     std::vector<std::string> files;
-};
\ No newline at end of file
+    std::vector<Atlas> atlases;
+    // Images that are block compressed with their mip chain and stored as .ktex instead of their source format
+    std::vector<std::string> textures;
+    // Models that are imported, optimized and stored as .kmesh instead of their source format
+    std::vector<std::string> models;
+};
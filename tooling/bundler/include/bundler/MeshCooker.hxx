@@ -0,0 +1,42 @@
+#pragma once
+
+#include <shared/MeshFormat.hxx>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Imported vertex in the runtime Vertex layout
+struct MeshVertex {
+    float position[3];
+    float uv[2];
+};
+
+// Triangle list as it comes out of the importer
+struct SourceMesh {
+    std::string name;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+// Reorders triangles so consecutive ones reuse the vertices still in the post transform cache (Forsyth's linear speed algorithm)
+auto OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) -> void;
+
+// Reorders vertices into the order the indices first reference them and drops unreferenced ones
+auto OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices) -> void;
+
+// Average number of vertices transformed per triangle with a FIFO cache of the given size, between 0.5 and 3
+auto AverageCacheMissRatio(const std::vector<uint32_t>& indices, size_t cacheSize) -> float;
+
+// IEEE half precision conversion, round to nearest
+auto FloatToHalf(float value) -> uint16_t;
+auto HalfToFloat(uint16_t value) -> float;
+
+// Half16 when every position stays within a thousandth of the mesh extent and every uv within 1/1024, Float32 otherwise
+auto ChooseVertexFormat(const SourceMesh& mesh) -> kyanite::engine::shared::VertexFormat;
+
+// Packs vertices in the given format, VertexStride bytes each
+auto QuantizeVertices(const std::vector<MeshVertex>& vertices, kyanite::engine::shared::VertexFormat format) -> std::vector<uint8_t>;
+
+// Optimizes and quantizes every mesh and writes them as a .kmesh file
+auto CookMeshes(std::vector<SourceMesh> meshes) -> std::vector<uint8_t>;
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <shared/TextureFormat.hxx>
+
+#include <cstdint>
+#include <vector>
+
+// RGBA8 image, tightly packed, rows top to bottom in the order they are uploaded
+struct Image {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+// Block compression of single 4x4 blocks. Pixels are 16 RGBA8 values in row order.
+auto EncodeBC1Block(const uint8_t* pixels, uint8_t* block) -> void;
+auto EncodeBC3Block(const uint8_t* pixels, uint8_t* block) -> void;
+auto DecodeBC1Block(const uint8_t* block, uint8_t* pixels) -> void;
+auto DecodeBC3Block(const uint8_t* block, uint8_t* pixels) -> void;
+
+// Compresses a whole image. Edges that do not fill a block repeat their last row and column.
+auto CompressImage(const Image& image, kyanite::engine::shared::TextureFormat format) -> std::vector<uint8_t>;
+auto DecompressImage(const uint8_t* blocks, uint32_t width, uint32_t height, kyanite::engine::shared::TextureFormat format) -> Image;
+
+// Halves an image with a box filter, odd edges fold into the last texel
+auto Downsample(const Image& image) -> Image;
+
+// BC3 if any texel is not fully opaque, BC1 otherwise
+auto ChooseFormat(const Image& image) -> kyanite::engine::shared::TextureFormat;
+
+// Builds the full mip chain of an image and writes it as a .ktex file
+auto CookTexture(const Image& image, kyanite::engine::shared::TextureFormat format) -> std::vector<uint8_t>;
@@ -0,0 +1,110 @@
+#include "bundler/AtlasPacker.hxx"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    auto Contains(const PackedRect& outer, const PackedRect& inner) -> bool {
+        return inner.x >= outer.x && inner.y >= outer.y &&
+            inner.x + inner.width <= outer.x + outer.width &&
+            inner.y + inner.height <= outer.y + outer.height;
+    }
+}
+
+AtlasPacker::AtlasPacker(uint32_t width, uint32_t height) : _width(width), _height(height) {
+    _freeRects.push_back({ 0, 0, width, height });
+}
+
+auto AtlasPacker::Insert(uint32_t width, uint32_t height, PackedRect& result) -> bool {
+    // Pick the free rect that leaves the smallest leftover on its shorter side
+    auto bestShortSide = std::numeric_limits<uint32_t>::max();
+    auto bestLongSide = std::numeric_limits<uint32_t>::max();
+    bool found = false;
+
+    for (const auto& freeRect : _freeRects) {
+        if (freeRect.width < width || freeRect.height < height) {
+            continue;
+        }
+
+        auto leftoverX = freeRect.width - width;
+        auto leftoverY = freeRect.height - height;
+        auto shortSide = std::min(leftoverX, leftoverY);
+        auto longSide = std::max(leftoverX, leftoverY);
+
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            result = { freeRect.x, freeRect.y, width, height };
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    // Every free rect that overlaps the placed one is replaced by up to four smaller ones
+    _newFreeRects.clear();
+    for (size_t x = 0; x < _freeRects.size();) {
+        if (SplitFreeRect(_freeRects[x], result)) {
+            _freeRects[x] = _freeRects.back();
+            _freeRects.pop_back();
+        }
+        else {
+            x++;
+        }
+    }
+    _freeRects.insert(_freeRects.end(), _newFreeRects.begin(), _newFreeRects.end());
+    PruneFreeRects();
+
+    _usedArea += static_cast<uint64_t>(width) * height;
+
+    return true;
+}
+
+auto AtlasPacker::Occupancy() const -> float {
+    return static_cast<float>(_usedArea) / (static_cast<float>(_width) * _height);
+}
+
+auto AtlasPacker::SplitFreeRect(const PackedRect& freeRect, const PackedRect& usedRect) -> bool {
+    if (usedRect.x >= freeRect.x + freeRect.width || usedRect.x + usedRect.width <= freeRect.x ||
+        usedRect.y >= freeRect.y + freeRect.height || usedRect.y + usedRect.height <= freeRect.y) {
+        return false;
+    }
+
+    if (usedRect.x > freeRect.x) {
+        _newFreeRects.push_back({ freeRect.x, freeRect.y, usedRect.x - freeRect.x, freeRect.height });
+    }
+    if (usedRect.x + usedRect.width < freeRect.x + freeRect.width) {
+        auto x = usedRect.x + usedRect.width;
+        _newFreeRects.push_back({ x, freeRect.y, freeRect.x + freeRect.width - x, freeRect.height });
+    }
+    if (usedRect.y > freeRect.y) {
+        _newFreeRects.push_back({ freeRect.x, freeRect.y, freeRect.width, usedRect.y - freeRect.y });
+    }
+    if (usedRect.y + usedRect.height < freeRect.y + freeRect.height) {
+        auto y = usedRect.y + usedRect.height;
+        _newFreeRects.push_back({ freeRect.x, y, freeRect.width, freeRect.y + freeRect.height - y });
+    }
+
+    return true;
+}
+
+auto AtlasPacker::PruneFreeRects() -> void {
+    // Drop free rects that are fully covered by another one
+    for (size_t x = 0; x < _freeRects.size(); x++) {
+        for (size_t y = x + 1; y < _freeRects.size();) {
+            if (Contains(_freeRects[y], _freeRects[x])) {
+                _freeRects.erase(_freeRects.begin() + x);
+                x--;
+                break;
+            }
+            if (Contains(_freeRects[x], _freeRects[y])) {
+                _freeRects.erase(_freeRects.begin() + y);
+            }
+            else {
+                y++;
+            }
+        }
+    }
+}
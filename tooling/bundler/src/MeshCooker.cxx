@@ -0,0 +1,353 @@
+#include "bundler/MeshCooker.hxx"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <deque>
+
+using kyanite::engine::shared::VertexFormat;
+
+namespace {
+    // Simulated cache, larger than any real one so the scores still prefer recently used vertices on big caches
+    constexpr size_t CacheSize = 32;
+    constexpr float CacheDecayPower = 1.5f;
+    constexpr float LastTriangleScore = 0.75f;
+    constexpr float ValenceBoostScale = 2.0f;
+    constexpr float ValenceBoostPower = 0.5f;
+
+    auto AlignUp(size_t value, size_t alignment) -> size_t {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    auto VertexScore(int32_t cachePosition, uint32_t remainingTriangles) -> float {
+        if (remainingTriangles == 0) {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            // The vertices of the last triangle get a fixed score so the next triangle does not simply reuse its edge
+            if (cachePosition < 3) {
+                score = LastTriangleScore;
+            }
+            else {
+                auto scale = 1.0f / (CacheSize - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scale, CacheDecayPower);
+            }
+        }
+
+        // Vertices with few triangles left are finished off first, so they do not linger as lone triangles later
+        return score + ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower);
+    }
+}
+
+auto OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) -> void {
+    auto triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return;
+    }
+
+    // Triangles of every vertex, packed into one array
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (auto index : indices) {
+        remaining[index]++;
+    }
+    std::vector<uint32_t> firstTriangle(vertexCount + 1, 0);
+    for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+        firstTriangle[vertex + 1] = firstTriangle[vertex] + remaining[vertex];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        auto fill = firstTriangle;
+        for (size_t x = 0; x < indices.size(); x++) {
+            adjacency[fill[indices[x]]++] = static_cast<uint32_t>(x / 3);
+        }
+    }
+
+    std::vector<int32_t> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+        vertexScore[vertex] = VertexScore(-1, remaining[vertex]);
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(CacheSize + 3);
+    nextCache.reserve(CacheSize + 3);
+
+    size_t scanCursor = 0;
+    int64_t best = -1;
+    for (size_t step = 0; step < triangleCount; step++) {
+        // Nothing in the cache touches an open triangle, start over at the next one in the input
+        if (best < 0) {
+            while (emitted[scanCursor]) {
+                scanCursor++;
+            }
+            best = static_cast<int64_t>(scanCursor);
+        }
+
+        auto triangle = static_cast<size_t>(best);
+        emitted[triangle] = true;
+        auto corners = &indices[triangle * 3];
+        output.insert(output.end(), corners, corners + 3);
+
+        // The triangle is no longer open for its vertices
+        for (int corner = 0; corner < 3; corner++) {
+            auto vertex = corners[corner];
+            auto begin = adjacency.begin() + firstTriangle[vertex];
+            auto end = begin + remaining[vertex];
+            auto found = std::find(begin, end, static_cast<uint32_t>(triangle));
+            if (found != end) {
+                std::iter_swap(found, end - 1);
+                remaining[vertex]--;
+            }
+        }
+
+        // The new triangle moves to the front, everything else shifts back and the tail falls out
+        nextCache.clear();
+        for (int corner = 0; corner < 3; corner++) {
+            if (std::find(nextCache.begin(), nextCache.end(), corners[corner]) == nextCache.end()) {
+                nextCache.push_back(corners[corner]);
+            }
+        }
+        for (auto vertex : cache) {
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end()) {
+                nextCache.push_back(vertex);
+            }
+        }
+        for (size_t x = CacheSize; x < nextCache.size(); x++) {
+            cachePosition[nextCache[x]] = -1;
+            vertexScore[nextCache[x]] = VertexScore(-1, remaining[nextCache[x]]);
+        }
+        nextCache.resize(std::min(nextCache.size(), CacheSize));
+        std::swap(cache, nextCache);
+
+        for (size_t x = 0; x < cache.size(); x++) {
+            cachePosition[cache[x]] = static_cast<int32_t>(x);
+            vertexScore[cache[x]] = VertexScore(static_cast<int32_t>(x), remaining[cache[x]]);
+        }
+
+        // Only triangles around cached vertices changed their score, the best next one is among them
+        best = -1;
+        float bestScore = -FLT_MAX;
+        for (auto vertex : cache) {
+            auto begin = firstTriangle[vertex];
+            for (auto x = begin; x < begin + remaining[vertex]; x++) {
+                auto open = adjacency[x];
+                auto score = vertexScore[indices[open * 3]] + vertexScore[indices[open * 3 + 1]] + vertexScore[indices[open * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = open;
+                }
+            }
+        }
+    }
+
+    indices = std::move(output);
+}
+
+auto OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices) -> void {
+    constexpr auto Unassigned = UINT32_MAX;
+
+    std::vector<uint32_t> remap(vertices.size(), Unassigned);
+    std::vector<MeshVertex> ordered;
+    ordered.reserve(vertices.size());
+
+    for (auto& index : indices) {
+        if (remap[index] == Unassigned) {
+            remap[index] = static_cast<uint32_t>(ordered.size());
+            ordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices = std::move(ordered);
+}
+
+auto AverageCacheMissRatio(const std::vector<uint32_t>& indices, size_t cacheSize) -> float {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+
+    std::deque<uint32_t> cache;
+    size_t misses = 0;
+    for (auto index : indices) {
+        if (std::find(cache.begin(), cache.end(), index) != cache.end()) {
+            continue;
+        }
+
+        misses++;
+        cache.push_back(index);
+        if (cache.size() > cacheSize) {
+            cache.pop_front();
+        }
+    }
+
+    return static_cast<float>(misses) / (indices.size() / 3);
+}
+
+auto FloatToHalf(float value) -> uint16_t {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    auto exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+    auto mantissa = bits & 0x7FFFFF;
+
+    // Infinity and NaN keep their class
+    if (((bits >> 23) & 0xFF) == 0xFF) {
+        return sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0);
+    }
+    if (exponent >= 31) {
+        return sign | 0x7C00;
+    }
+    if (exponent <= 0) {
+        // Too small even for a subnormal
+        if (exponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        auto shift = static_cast<uint32_t>(14 - exponent);
+        auto half = mantissa >> shift;
+        half += (mantissa >> (shift - 1)) & 1;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // A carry out of the mantissa correctly bumps the exponent, up to infinity
+    auto half = static_cast<uint32_t>(exponent << 10) | (mantissa >> 13);
+    half += (mantissa >> 12) & 1;
+    return static_cast<uint16_t>(sign | half);
+}
+
+auto HalfToFloat(uint16_t value) -> float {
+    auto sign = (value & 0x8000) != 0 ? -1.0f : 1.0f;
+    auto exponent = (value >> 10) & 0x1F;
+    auto mantissa = value & 0x3FF;
+
+    if (exponent == 0) {
+        return sign * std::ldexp(static_cast<float>(mantissa), -24);
+    }
+    if (exponent == 31) {
+        return mantissa == 0 ? sign * INFINITY : NAN;
+    }
+    return sign * std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+}
+
+auto ChooseVertexFormat(const SourceMesh& mesh) -> VertexFormat {
+    if (mesh.vertices.empty()) {
+        return VertexFormat::Float32;
+    }
+
+    float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const auto& vertex : mesh.vertices) {
+        for (int axis = 0; axis < 3; axis++) {
+            min[axis] = std::min(min[axis], vertex.position[axis]);
+            max[axis] = std::max(max[axis], vertex.position[axis]);
+        }
+    }
+    auto extent = std::max({ max[0] - min[0], max[1] - min[1], max[2] - min[2] });
+
+    // Meshes far from their origin lose most of their precision in half floats, those stay full size
+    auto positionTolerance = extent * 0.001f;
+    constexpr auto UvTolerance = 1.0f / 1024.0f;
+    auto fits = [](float value, float tolerance) {
+        auto restored = HalfToFloat(FloatToHalf(value));
+        return std::isfinite(restored) && std::abs(restored - value) <= tolerance;
+    };
+
+    for (const auto& vertex : mesh.vertices) {
+        for (int axis = 0; axis < 3; axis++) {
+            if (!fits(vertex.position[axis], positionTolerance)) {
+                return VertexFormat::Float32;
+            }
+        }
+        if (!fits(vertex.uv[0], UvTolerance) || !fits(vertex.uv[1], UvTolerance)) {
+            return VertexFormat::Float32;
+        }
+    }
+
+    return VertexFormat::Half16;
+}
+
+auto QuantizeVertices(const std::vector<MeshVertex>& vertices, VertexFormat format) -> std::vector<uint8_t> {
+    using namespace kyanite::engine::shared;
+
+    std::vector<uint8_t> data(vertices.size() * VertexStride(format));
+    if (format == VertexFormat::Float32) {
+        static_assert(sizeof(MeshVertex) == 20, "MeshVertex must match the Float32 layout");
+        std::memcpy(data.data(), vertices.data(), data.size());
+        return data;
+    }
+
+    // x, y, z, padding, u, v
+    for (size_t x = 0; x < vertices.size(); x++) {
+        const auto& vertex = vertices[x];
+        uint16_t packed[6] = {
+            FloatToHalf(vertex.position[0]),
+            FloatToHalf(vertex.position[1]),
+            FloatToHalf(vertex.position[2]),
+            0,
+            FloatToHalf(vertex.uv[0]),
+            FloatToHalf(vertex.uv[1])
+        };
+        std::memcpy(data.data() + x * sizeof(packed), packed, sizeof(packed));
+    }
+
+    return data;
+}
+
+auto CookMeshes(std::vector<SourceMesh> meshes) -> std::vector<uint8_t> {
+    using namespace kyanite::engine::shared;
+
+    std::vector<MeshEntry> entries(meshes.size());
+    std::vector<std::vector<uint8_t>> vertexData(meshes.size());
+
+    auto offset = AlignUp(sizeof(MeshHeader) + meshes.size() * sizeof(MeshEntry), MeshDataAlignment);
+    for (size_t x = 0; x < meshes.size(); x++) {
+        auto& mesh = meshes[x];
+        auto& entry = entries[x];
+
+        OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+        OptimizeVertexFetch(mesh.vertices, mesh.indices);
+
+        entry = {};
+        std::strncpy(entry.name, mesh.name.c_str(), MeshNameLength - 1);
+        entry.format = ChooseVertexFormat(mesh);
+        entry.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        entry.indexCount = static_cast<uint32_t>(mesh.indices.size());
+
+        std::fill(std::begin(entry.boundsMin), std::end(entry.boundsMin), mesh.vertices.empty() ? 0.0f : FLT_MAX);
+        std::fill(std::begin(entry.boundsMax), std::end(entry.boundsMax), mesh.vertices.empty() ? 0.0f : -FLT_MAX);
+        for (const auto& vertex : mesh.vertices) {
+            for (int axis = 0; axis < 3; axis++) {
+                entry.boundsMin[axis] = std::min(entry.boundsMin[axis], vertex.position[axis]);
+                entry.boundsMax[axis] = std::max(entry.boundsMax[axis], vertex.position[axis]);
+            }
+        }
+
+        vertexData[x] = QuantizeVertices(mesh.vertices, entry.format);
+
+        entry.vertexOffset = offset;
+        offset = AlignUp(offset + vertexData[x].size(), MeshDataAlignment);
+        entry.indexOffset = offset;
+        offset = AlignUp(offset + mesh.indices.size() * sizeof(uint32_t), MeshDataAlignment);
+    }
+
+    MeshHeader header = { MeshMagic, MeshVersion, static_cast<uint32_t>(meshes.size()), 0 };
+
+    std::vector<uint8_t> file(offset);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), entries.data(), entries.size() * sizeof(MeshEntry));
+    for (size_t x = 0; x < meshes.size(); x++) {
+        std::memcpy(file.data() + entries[x].vertexOffset, vertexData[x].data(), vertexData[x].size());
+        std::memcpy(file.data() + entries[x].indexOffset, meshes[x].indices.data(), meshes[x].indices.size() * sizeof(uint32_t));
+    }
+
+    return file;
+}
@@ -0,0 +1,449 @@
+#include "bundler/TextureCooker.hxx"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+using kyanite::engine::shared::TextureFormat;
+
+namespace {
+    struct Color {
+        float r;
+        float g;
+        float b;
+    };
+
+    auto To565(const Color& color) -> uint16_t {
+        auto r = static_cast<uint16_t>(std::clamp(std::lround(color.r * 31.0f / 255.0f), 0l, 31l));
+        auto g = static_cast<uint16_t>(std::clamp(std::lround(color.g * 63.0f / 255.0f), 0l, 63l));
+        auto b = static_cast<uint16_t>(std::clamp(std::lround(color.b * 31.0f / 255.0f), 0l, 31l));
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    auto From565(uint16_t value) -> std::array<uint8_t, 3> {
+        auto r = (value >> 11) & 31;
+        auto g = (value >> 5) & 63;
+        auto b = value & 31;
+        return {
+            static_cast<uint8_t>((r << 3) | (r >> 2)),
+            static_cast<uint8_t>((g << 2) | (g >> 4)),
+            static_cast<uint8_t>((b << 3) | (b >> 2))
+        };
+    }
+
+    // The four colors of a block in four color mode, in index order
+    auto Palette(uint16_t c0, uint16_t c1) -> std::array<std::array<uint8_t, 3>, 4> {
+        auto a = From565(c0);
+        auto b = From565(c1);
+        std::array<std::array<uint8_t, 3>, 4> palette = { a, b };
+        for (int x = 0; x < 3; x++) {
+            palette[2][x] = static_cast<uint8_t>((2 * a[x] + b[x]) / 3);
+            palette[3][x] = static_cast<uint8_t>((a[x] + 2 * b[x]) / 3);
+        }
+        return palette;
+    }
+
+    // Picks the nearest palette entry for every pixel and returns the summed squared error
+    auto SelectIndices(const uint8_t* pixels, uint16_t c0, uint16_t c1, uint32_t& indices) -> uint32_t {
+        auto palette = Palette(c0, c1);
+        uint32_t error = 0;
+        indices = 0;
+
+        for (uint32_t x = 0; x < 16; x++) {
+            const auto* pixel = pixels + x * 4;
+            uint32_t best = 0;
+            uint32_t bestError = UINT32_MAX;
+            for (uint32_t entry = 0; entry < 4; entry++) {
+                uint32_t entryError = 0;
+                for (int channel = 0; channel < 3; channel++) {
+                    auto delta = static_cast<int32_t>(pixel[channel]) - palette[entry][channel];
+                    entryError += delta * delta;
+                }
+                if (entryError < bestError) {
+                    best = entry;
+                    bestError = entryError;
+                }
+            }
+            indices |= best << (x * 2);
+            error += bestError;
+        }
+
+        return error;
+    }
+
+    // Solves for the endpoints that best reproduce the pixels with the given indices
+    auto FitEndpoints(const uint8_t* pixels, uint32_t indices, Color& e0, Color& e1) -> bool {
+        constexpr float Weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+        float aa = 0, ab = 0, bb = 0;
+        Color ax = {}, bx = {};
+        for (uint32_t x = 0; x < 16; x++) {
+            auto a = Weights[(indices >> (x * 2)) & 3];
+            auto b = 1.0f - a;
+            const auto* pixel = pixels + x * 4;
+
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            ax = { ax.r + a * pixel[0], ax.g + a * pixel[1], ax.b + a * pixel[2] };
+            bx = { bx.r + b * pixel[0], bx.g + b * pixel[1], bx.b + b * pixel[2] };
+        }
+
+        auto determinant = aa * bb - ab * ab;
+        if (std::abs(determinant) < 1e-6f) {
+            return false;
+        }
+
+        auto inverse = 1.0f / determinant;
+        e0 = {
+            (ax.r * bb - bx.r * ab) * inverse,
+            (ax.g * bb - bx.g * ab) * inverse,
+            (ax.b * bb - bx.b * ab) * inverse
+        };
+        e1 = {
+            (bx.r * aa - ax.r * ab) * inverse,
+            (bx.g * aa - ax.g * ab) * inverse,
+            (bx.b * aa - ax.b * ab) * inverse
+        };
+
+        return true;
+    }
+
+    auto WriteColorBlock(uint16_t c0, uint16_t c1, uint32_t indices, uint8_t* block) -> void {
+        std::memcpy(block, &c0, 2);
+        std::memcpy(block + 2, &c1, 2);
+        std::memcpy(block + 4, &indices, 4);
+    }
+
+    // Encodes the color part of a block in four color mode, which BC1 and BC3 share
+    auto EncodeColorBlock(const uint8_t* pixels, uint8_t* block) -> void {
+        // Principal axis of the colors via power iteration on their covariance
+        Color mean = {};
+        for (uint32_t x = 0; x < 16; x++) {
+            mean = { mean.r + pixels[x * 4], mean.g + pixels[x * 4 + 1], mean.b + pixels[x * 4 + 2] };
+        }
+        mean = { mean.r / 16.0f, mean.g / 16.0f, mean.b / 16.0f };
+
+        float covariance[6] = {};
+        for (uint32_t x = 0; x < 16; x++) {
+            auto r = pixels[x * 4] - mean.r;
+            auto g = pixels[x * 4 + 1] - mean.g;
+            auto b = pixels[x * 4 + 2] - mean.b;
+            covariance[0] += r * r;
+            covariance[1] += r * g;
+            covariance[2] += r * b;
+            covariance[3] += g * g;
+            covariance[4] += g * b;
+            covariance[5] += b * b;
+        }
+
+        Color axis = { 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 8; iteration++) {
+            Color next = {
+                covariance[0] * axis.r + covariance[1] * axis.g + covariance[2] * axis.b,
+                covariance[1] * axis.r + covariance[3] * axis.g + covariance[4] * axis.b,
+                covariance[2] * axis.r + covariance[4] * axis.g + covariance[5] * axis.b
+            };
+            auto length = std::max({ std::abs(next.r), std::abs(next.g), std::abs(next.b) });
+            if (length < 1e-6f) {
+                break;
+            }
+            axis = { next.r / length, next.g / length, next.b / length };
+        }
+        auto axisLength = std::sqrt(axis.r * axis.r + axis.g * axis.g + axis.b * axis.b);
+        axis = { axis.r / axisLength, axis.g / axisLength, axis.b / axisLength };
+
+        // The extremes along the axis become the first guess for the endpoints
+        auto minProjection = FLT_MAX;
+        auto maxProjection = -FLT_MAX;
+        for (uint32_t x = 0; x < 16; x++) {
+            auto projection = (pixels[x * 4] - mean.r) * axis.r + (pixels[x * 4 + 1] - mean.g) * axis.g + (pixels[x * 4 + 2] - mean.b) * axis.b;
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+
+        auto c0 = To565({ mean.r + axis.r * maxProjection, mean.g + axis.g * maxProjection, mean.b + axis.b * maxProjection });
+        auto c1 = To565({ mean.r + axis.r * minProjection, mean.g + axis.g * minProjection, mean.b + axis.b * minProjection });
+        uint32_t indices;
+        auto error = SelectIndices(pixels, c0, c1, indices);
+
+        // Refine the endpoints with a least squares fit as long as that lowers the error
+        for (int iteration = 0; iteration < 2 && error > 0; iteration++) {
+            Color e0, e1;
+            if (!FitEndpoints(pixels, indices, e0, e1)) {
+                break;
+            }
+
+            auto fitted0 = To565(e0);
+            auto fitted1 = To565(e1);
+            uint32_t fittedIndices;
+            auto fittedError = SelectIndices(pixels, fitted0, fitted1, fittedIndices);
+            if (fittedError >= error) {
+                break;
+            }
+            c0 = fitted0;
+            c1 = fitted1;
+            indices = fittedIndices;
+            error = fittedError;
+        }
+
+        // Four color mode needs c0 > c1. Swapping the endpoints maps index 0 <-> 1 and 2 <-> 3
+        if (c0 < c1) {
+            std::swap(c0, c1);
+            indices ^= 0x55555555;
+        }
+        else if (c0 == c1) {
+            indices = 0;
+        }
+
+        WriteColorBlock(c0, c1, indices, block);
+    }
+
+    auto DecodeColorBlock(const uint8_t* block, uint8_t* pixels, bool allowThreeColorMode) -> void {
+        uint16_t c0, c1;
+        uint32_t indices;
+        std::memcpy(&c0, block, 2);
+        std::memcpy(&c1, block + 2, 2);
+        std::memcpy(&indices, block + 4, 4);
+
+        auto palette = Palette(c0, c1);
+        std::array<uint8_t, 4> alphas = { 255, 255, 255, 255 };
+        if (allowThreeColorMode && c0 <= c1) {
+            auto a = From565(c0);
+            auto b = From565(c1);
+            for (int x = 0; x < 3; x++) {
+                palette[2][x] = static_cast<uint8_t>((a[x] + b[x]) / 2);
+                palette[3][x] = 0;
+            }
+            alphas[3] = 0;
+        }
+
+        for (uint32_t x = 0; x < 16; x++) {
+            auto index = (indices >> (x * 2)) & 3;
+            pixels[x * 4] = palette[index][0];
+            pixels[x * 4 + 1] = palette[index][1];
+            pixels[x * 4 + 2] = palette[index][2];
+            pixels[x * 4 + 3] = alphas[index];
+        }
+    }
+
+    auto AlphaPalette(uint8_t a0, uint8_t a1) -> std::array<uint8_t, 8> {
+        std::array<uint8_t, 8> palette = { a0, a1 };
+        if (a0 > a1) {
+            for (int x = 1; x < 7; x++) {
+                palette[x + 1] = static_cast<uint8_t>(((7 - x) * a0 + x * a1) / 7);
+            }
+        }
+        else {
+            for (int x = 1; x < 5; x++) {
+                palette[x + 1] = static_cast<uint8_t>(((5 - x) * a0 + x * a1) / 5);
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+        return palette;
+    }
+
+    auto EncodeAlphaBlock(const uint8_t* pixels, uint8_t* block) -> void {
+        uint8_t minAlpha = 255;
+        uint8_t maxAlpha = 0;
+        for (uint32_t x = 0; x < 16; x++) {
+            minAlpha = std::min(minAlpha, pixels[x * 4 + 3]);
+            maxAlpha = std::max(maxAlpha, pixels[x * 4 + 3]);
+        }
+
+        // Eight interpolated values between the extremes. A flat block ends up in six value mode, where index 0 is exact
+        auto palette = AlphaPalette(maxAlpha, minAlpha);
+        uint64_t indices = 0;
+        for (uint32_t x = 0; x < 16; x++) {
+            uint64_t best = 0;
+            auto bestError = INT32_MAX;
+            for (uint32_t entry = 0; entry < 8; entry++) {
+                auto error = std::abs(static_cast<int32_t>(pixels[x * 4 + 3]) - palette[entry]);
+                if (error < bestError) {
+                    best = entry;
+                    bestError = error;
+                }
+            }
+            indices |= best << (x * 3);
+        }
+
+        block[0] = maxAlpha;
+        block[1] = minAlpha;
+        for (int x = 0; x < 6; x++) {
+            block[2 + x] = static_cast<uint8_t>(indices >> (x * 8));
+        }
+    }
+
+    auto DecodeAlphaBlock(const uint8_t* block, uint8_t* pixels) -> void {
+        auto palette = AlphaPalette(block[0], block[1]);
+        uint64_t indices = 0;
+        for (int x = 0; x < 6; x++) {
+            indices |= static_cast<uint64_t>(block[2 + x]) << (x * 8);
+        }
+
+        for (uint32_t x = 0; x < 16; x++) {
+            pixels[x * 4 + 3] = palette[(indices >> (x * 3)) & 7];
+        }
+    }
+
+    auto AlignUp(size_t value, size_t alignment) -> size_t {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+auto EncodeBC1Block(const uint8_t* pixels, uint8_t* block) -> void {
+    EncodeColorBlock(pixels, block);
+}
+
+auto EncodeBC3Block(const uint8_t* pixels, uint8_t* block) -> void {
+    EncodeAlphaBlock(pixels, block);
+    EncodeColorBlock(pixels, block + 8);
+}
+
+auto DecodeBC1Block(const uint8_t* block, uint8_t* pixels) -> void {
+    DecodeColorBlock(block, pixels, true);
+}
+
+auto DecodeBC3Block(const uint8_t* block, uint8_t* pixels) -> void {
+    DecodeColorBlock(block + 8, pixels, false);
+    DecodeAlphaBlock(block, pixels);
+}
+
+auto CompressImage(const Image& image, TextureFormat format) -> std::vector<uint8_t> {
+    auto blockBytes = kyanite::engine::shared::TextureBlockBytes(format);
+    auto blocksX = (image.width + 3) / 4;
+    auto blocksY = (image.height + 3) / 4;
+    std::vector<uint8_t> blocks(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+    uint8_t pixels[16 * 4];
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++) {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+            for (uint32_t y = 0; y < 4; y++) {
+                auto row = std::min(blockY * 4 + y, image.height - 1);
+                for (uint32_t x = 0; x < 4; x++) {
+                    auto column = std::min(blockX * 4 + x, image.width - 1);
+                    std::memcpy(pixels + (y * 4 + x) * 4, image.pixels.data() + (static_cast<size_t>(row) * image.width + column) * 4, 4);
+                }
+            }
+
+            auto block = blocks.data() + (static_cast<size_t>(blockY) * blocksX + blockX) * blockBytes;
+            if (format == TextureFormat::BC1) {
+                EncodeBC1Block(pixels, block);
+            }
+            else {
+                EncodeBC3Block(pixels, block);
+            }
+        }
+    }
+
+    return blocks;
+}
+
+auto DecompressImage(const uint8_t* blocks, uint32_t width, uint32_t height, TextureFormat format) -> Image {
+    auto blockBytes = kyanite::engine::shared::TextureBlockBytes(format);
+    auto blocksX = (width + 3) / 4;
+    auto blocksY = (height + 3) / 4;
+
+    Image image = { width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4) };
+    uint8_t pixels[16 * 4];
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++) {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+            auto block = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * blockBytes;
+            if (format == TextureFormat::BC1) {
+                DecodeBC1Block(block, pixels);
+            }
+            else {
+                DecodeBC3Block(block, pixels);
+            }
+
+            for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; y++) {
+                for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; x++) {
+                    auto target = (static_cast<size_t>(blockY * 4 + y) * width + blockX * 4 + x) * 4;
+                    std::memcpy(image.pixels.data() + target, pixels + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+
+    return image;
+}
+
+auto Downsample(const Image& image) -> Image {
+    auto width = std::max(image.width / 2, 1u);
+    auto height = std::max(image.height / 2, 1u);
+    Image result = { width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4) };
+
+    for (uint32_t y = 0; y < result.height; y++) {
+        auto y0 = std::min(y * 2, image.height - 1);
+        auto y1 = std::min(y * 2 + 1, image.height - 1);
+        for (uint32_t x = 0; x < result.width; x++) {
+            auto x0 = std::min(x * 2, image.width - 1);
+            auto x1 = std::min(x * 2 + 1, image.width - 1);
+            for (uint32_t channel = 0; channel < 4; channel++) {
+                auto sum =
+                    image.pixels[(static_cast<size_t>(y0) * image.width + x0) * 4 + channel] +
+                    image.pixels[(static_cast<size_t>(y0) * image.width + x1) * 4 + channel] +
+                    image.pixels[(static_cast<size_t>(y1) * image.width + x0) * 4 + channel] +
+                    image.pixels[(static_cast<size_t>(y1) * image.width + x1) * 4 + channel];
+                result.pixels[(static_cast<size_t>(y) * result.width + x) * 4 + channel] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+
+    return result;
+}
+
+auto ChooseFormat(const Image& image) -> TextureFormat {
+    for (size_t x = 3; x < image.pixels.size(); x += 4) {
+        if (image.pixels[x] != 255) {
+            return TextureFormat::BC3;
+        }
+    }
+
+    return TextureFormat::BC1;
+}
+
+auto CookTexture(const Image& image, TextureFormat format) -> std::vector<uint8_t> {
+    using namespace kyanite::engine::shared;
+
+    // Compress every level down to 1x1
+    std::vector<std::vector<uint8_t>> levelData;
+    std::vector<TextureLevel> levels;
+    Image level = image;
+    while (true) {
+        levelData.push_back(CompressImage(level, format));
+        levels.push_back({ 0, levelData.back().size(), level.width, level.height });
+
+        if ((level.width == 1 && level.height == 1) || levels.size() == TextureMaxLevels) {
+            break;
+        }
+        level = Downsample(level);
+    }
+
+    TextureHeader header = {
+        TextureMagic,
+        TextureVersion,
+        format,
+        image.width,
+        image.height,
+        static_cast<uint32_t>(levels.size())
+    };
+
+    auto offset = AlignUp(sizeof(TextureHeader) + levels.size() * sizeof(TextureLevel), TextureDataAlignment);
+    for (auto& entry : levels) {
+        entry.offset = offset;
+        offset = AlignUp(offset + entry.size, TextureDataAlignment);
+    }
+
+    std::vector<uint8_t> file(offset);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), levels.data(), levels.size() * sizeof(TextureLevel));
+    for (size_t x = 0; x < levels.size(); x++) {
+        std::memcpy(file.data() + levels[x].offset, levelData[x].data(), levelData[x].size());
+    }
+
+    return file;
+}
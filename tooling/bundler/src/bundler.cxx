@@ -1,15 +1,285 @@
+#include "bundler/AtlasPacker.hxx"
 #include "bundler/Bundle.hxx"
+#include "bundler/MeshCooker.hxx"
+#include "bundler/TextureCooker.hxx"
 #include <io/Bridge_IO.h>
 #include <crypto/Bridge_Crypto.h>
+#include <shared/AtlasFormat.hxx>
 #include <nlohmann/json.hpp>
 #include <minizip-ng/zip.h>
+#include <FreeImage.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <string>
 #include <string_view>
 #include <vector>
 
+void AddToZip(zipFile zip, const std::string& name, const void* data, size_t size, int level = MZ_COMPRESS_LEVEL_BEST) {
+    zip_fileinfo file_info = { 0 };
+    zipOpenNewFileInZip(
+        zip, 
+        name.c_str(), 
+        &file_info, 
+        nullptr, 
+        0, 
+        nullptr, 
+        0, 
+        nullptr, 
+        level == 0 ? 0 : Z_DEFLATED, 
+        level
+    );
+    zipWriteInFileInZip(zip, data, size);
+    zipCloseFileInZip(zip);
+}
+
+// Copies an image into a page and repeats its border pixels into the padding around it
+void BlitExtruded(FIBITMAP* page, FIBITMAP* image, uint32_t x, uint32_t y, uint32_t padding) {
+    auto width = FreeImage_GetWidth(image);
+    auto height = FreeImage_GetHeight(image);
+
+    for (uint32_t row = 0; row < height + padding * 2; row++) {
+        // FreeImage scanlines run bottom up, and so do the atlas coordinates
+        auto sourceRow = std::clamp<int64_t>(static_cast<int64_t>(row) - padding, 0, height - 1);
+        auto source = reinterpret_cast<const uint32_t*>(FreeImage_GetScanLine(image, static_cast<int>(sourceRow)));
+        auto target = reinterpret_cast<uint32_t*>(FreeImage_GetScanLine(page, y + row)) + x;
+
+        for (uint32_t column = 0; column < width + padding * 2; column++) {
+            auto sourceColumn = std::clamp<int64_t>(static_cast<int64_t>(column) - padding, 0, width - 1);
+            target[column] = source[sourceColumn];
+        }
+    }
+}
+
+bool PackAtlas(zipFile zip, const std::filesystem::path& dirPath, const Atlas& atlas) {
+    std::vector<FIBITMAP*> images;
+    for (const auto& file : atlas.images) {
+        FIBITMAP* bitmap = nullptr;
+        if (file.size() < kyanite::engine::shared::AtlasNameLength) {
+            auto path = (dirPath / file).string();
+            auto format = FreeImage_GetFileType(path.c_str(), 0);
+            bitmap = format != FIF_UNKNOWN ? FreeImage_Load(format, path.c_str(), 0) : nullptr;
+        }
+
+        if (bitmap == nullptr) {
+            std::cerr << "Error opening atlas image (names are limited to " << kyanite::engine::shared::AtlasNameLength - 1 << " characters): " << file << std::endl;
+            for (auto image : images) {
+                FreeImage_Unload(image);
+            }
+            return false;
+        }
+
+        auto converted = FreeImage_ConvertTo32Bits(bitmap);
+        FreeImage_Unload(bitmap);
+        if (converted == nullptr) {
+            std::cerr << "Error converting atlas image to 32 bits: " << file << std::endl;
+            for (auto image : images) {
+                FreeImage_Unload(image);
+            }
+            return false;
+        }
+        images.push_back(converted);
+    }
+
+    // Place the largest images first, that gives the packer the most freedom for the small ones
+    std::vector<size_t> order(images.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        auto sideA = std::max(FreeImage_GetWidth(images[a]), FreeImage_GetHeight(images[a]));
+        auto sideB = std::max(FreeImage_GetWidth(images[b]), FreeImage_GetHeight(images[b]));
+        return sideA > sideB;
+    });
+
+    std::vector<AtlasPacker> packers;
+    std::vector<FIBITMAP*> pages;
+    std::vector<kyanite::engine::shared::AtlasRegion> regions(images.size());
+
+    bool success = true;
+    for (auto index : order) {
+        auto image = images[index];
+        auto width = FreeImage_GetWidth(image);
+        auto height = FreeImage_GetHeight(image);
+        auto paddedWidth = width + atlas.padding * 2;
+        auto paddedHeight = height + atlas.padding * 2;
+
+        if (paddedWidth > atlas.size || paddedHeight > atlas.size) {
+            std::cerr << "Atlas image does not fit into a page: " << atlas.images[index] << std::endl;
+            success = false;
+            break;
+        }
+
+        // Try the existing pages first and open a new one when none has room left
+        PackedRect rect;
+        size_t page = 0;
+        while (page < packers.size() && !packers[page].Insert(paddedWidth, paddedHeight, rect)) {
+            page++;
+        }
+        if (page == packers.size()) {
+            packers.emplace_back(atlas.size, atlas.size);
+            pages.push_back(FreeImage_Allocate(atlas.size, atlas.size, 32));
+            packers.back().Insert(paddedWidth, paddedHeight, rect);
+        }
+
+        BlitExtruded(pages[page], image, rect.x, rect.y, atlas.padding);
+
+        auto& region = regions[index];
+        std::memset(region.name, 0, sizeof(region.name));
+        std::memcpy(region.name, atlas.images[index].c_str(), atlas.images[index].size());
+        region.page = static_cast<uint32_t>(page);
+        region.width = width;
+        region.height = height;
+        region.u0 = static_cast<float>(rect.x + atlas.padding) / atlas.size;
+        region.v0 = static_cast<float>(rect.y + atlas.padding) / atlas.size;
+        region.u1 = static_cast<float>(rect.x + atlas.padding + width) / atlas.size;
+        region.v1 = static_cast<float>(rect.y + atlas.padding + height) / atlas.size;
+    }
+
+    if (success) {
+        for (size_t page = 0; page < pages.size(); page++) {
+            FIMEMORY* memory = FreeImage_OpenMemory();
+            FreeImage_SaveToMemory(FIF_PNG, pages[page], memory, 0);
+
+            BYTE* data = nullptr;
+            DWORD size = 0;
+            FreeImage_AcquireMemory(memory, &data, &size);
+            AddToZip(zip, atlas.name + "_" + std::to_string(page) + ".png", data, size);
+            FreeImage_CloseMemory(memory);
+
+            std::cout << atlas.name << " page " << page << ": " << packers[page].Occupancy() * 100.0f << "% used" << std::endl;
+        }
+
+        kyanite::engine::shared::AtlasHeader header = {
+            kyanite::engine::shared::AtlasMagic,
+            kyanite::engine::shared::AtlasVersion,
+            atlas.size,
+            static_cast<uint32_t>(pages.size()),
+            static_cast<uint32_t>(regions.size())
+        };
+        std::vector<uint8_t> metadata(sizeof(header) + regions.size() * sizeof(kyanite::engine::shared::AtlasRegion));
+        std::memcpy(metadata.data(), &header, sizeof(header));
+        std::memcpy(metadata.data() + sizeof(header), regions.data(), regions.size() * sizeof(kyanite::engine::shared::AtlasRegion));
+        AddToZip(zip, atlas.name + ".atlas", metadata.data(), metadata.size());
+    }
+
+    for (auto page : pages) {
+        FreeImage_Unload(page);
+    }
+    for (auto image : images) {
+        FreeImage_Unload(image);
+    }
+
+    return success;
+}
+
+bool CookTextureFile(zipFile zip, const std::filesystem::path& dirPath, const std::string& file) {
+    auto path = (dirPath / file).string();
+    auto format = FreeImage_GetFileType(path.c_str(), 0);
+    auto bitmap = format != FIF_UNKNOWN ? FreeImage_Load(format, path.c_str(), 0) : nullptr;
+    if (bitmap == nullptr) {
+        std::cerr << "Error opening texture: " << file << std::endl;
+        return false;
+    }
+
+    auto converted = FreeImage_ConvertTo32Bits(bitmap);
+    FreeImage_Unload(bitmap);
+    if (converted == nullptr) {
+        std::cerr << "Error converting texture to 32 bits: " << file << std::endl;
+        return false;
+    }
+
+    // Keep the scanline order the runtime uploads uncompressed images in, but swap BGRA to RGBA
+    auto width = FreeImage_GetWidth(converted);
+    auto height = FreeImage_GetHeight(converted);
+    Image image = { width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4) };
+    for (uint32_t row = 0; row < image.height; row++) {
+        auto source = FreeImage_GetScanLine(converted, row);
+        auto target = image.pixels.data() + static_cast<size_t>(row) * image.width * 4;
+        for (uint32_t column = 0; column < image.width; column++) {
+            target[column * 4] = source[column * 4 + FI_RGBA_RED];
+            target[column * 4 + 1] = source[column * 4 + FI_RGBA_GREEN];
+            target[column * 4 + 2] = source[column * 4 + FI_RGBA_BLUE];
+            target[column * 4 + 3] = source[column * 4 + FI_RGBA_ALPHA];
+        }
+    }
+    FreeImage_Unload(converted);
+
+    auto cooked = CookTexture(image, ChooseFormat(image));
+
+    // Stored, not deflated. The blocks barely shrink and this keeps them readable in place
+    auto name = std::filesystem::path(file).replace_extension(".ktex").generic_string();
+    AddToZip(zip, name, cooked.data(), cooked.size(), 0);
+
+    std::cout << file << ": " << image.pixels.size() << " -> " << cooked.size() << " bytes" << std::endl;
+
+    return true;
+}
+
+bool CookModelFile(zipFile zip, const std::filesystem::path& dirPath, const std::string& file) {
+    auto path = (dirPath / file).string();
+
+    // The renderer is left handed and samples textures with v = 0 at the top row.
+    // Node transforms are baked in, a cooked model is a flat list of meshes in model space.
+    Assimp::Importer importer;
+    auto scene = importer.ReadFile(
+        path,
+        aiProcess_Triangulate |
+        aiProcess_JoinIdenticalVertices |
+        aiProcess_PreTransformVertices |
+        aiProcess_SortByPType |
+        aiProcess_ConvertToLeftHanded
+    );
+    if (scene == nullptr || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0) {
+        std::cerr << "Error opening model: " << file << " " << importer.GetErrorString() << std::endl;
+        return false;
+    }
+
+    std::vector<SourceMesh> meshes;
+    size_t sourceBytes = 0;
+    for (uint32_t x = 0; x < scene->mNumMeshes; x++) {
+        auto source = scene->mMeshes[x];
+        // Points and lines were split off by SortByPType
+        if ((source->mPrimitiveTypes & aiPrimitiveType_TRIANGLE) == 0) {
+            continue;
+        }
+
+        SourceMesh mesh;
+        mesh.name = source->mName.C_Str();
+        mesh.vertices.resize(source->mNumVertices);
+        for (uint32_t vertex = 0; vertex < source->mNumVertices; vertex++) {
+            auto& target = mesh.vertices[vertex];
+            target.position[0] = source->mVertices[vertex].x;
+            target.position[1] = source->mVertices[vertex].y;
+            target.position[2] = source->mVertices[vertex].z;
+            target.uv[0] = source->HasTextureCoords(0) ? source->mTextureCoords[0][vertex].x : 0.0f;
+            target.uv[1] = source->HasTextureCoords(0) ? source->mTextureCoords[0][vertex].y : 0.0f;
+        }
+        mesh.indices.reserve(static_cast<size_t>(source->mNumFaces) * 3);
+        for (uint32_t face = 0; face < source->mNumFaces; face++) {
+            const auto& indices = source->mFaces[face];
+            mesh.indices.insert(mesh.indices.end(), indices.mIndices, indices.mIndices + indices.mNumIndices);
+        }
+
+        sourceBytes += mesh.vertices.size() * sizeof(MeshVertex) + mesh.indices.size() * sizeof(uint32_t);
+        meshes.push_back(std::move(mesh));
+    }
+
+    auto cooked = CookMeshes(std::move(meshes));
+
+    // Stored like textures, so the runtime can map the vertex and index ranges in place
+    auto name = std::filesystem::path(file).replace_extension(".kmesh").generic_string();
+    AddToZip(zip, name, cooked.data(), cooked.size(), 0);
+
+    std::cout << file << ": " << sourceBytes << " -> " << cooked.size() << " bytes" << std::endl;
+
+    return true;
+}
+
 void ReadPackage(const std::string& path) {
     // Open the file
     std::ifstream file(path);
@@ -22,6 +292,25 @@ void ReadPackage(const std::string& path) {
     bundle.name = json_data["name"];
     bundle.files = json_data["files"];
 
+    if (json_data.contains("atlases")) {
+        for (const auto& entry : json_data["atlases"]) {
+            Atlas atlas;
+            atlas.name = entry["name"];
+            atlas.size = entry.value("size", atlas.size);
+            atlas.padding = entry.value("padding", atlas.padding);
+            atlas.images = entry["images"];
+            bundle.atlases.push_back(atlas);
+        }
+    }
+
+    if (json_data.contains("textures")) {
+        bundle.textures = json_data["textures"];
+    }
+
+    if (json_data.contains("models")) {
+        bundle.models = json_data["models"];
+    }
+
     std::stringstream ss;
     ss << bundle.name << ".bundle";
 
@@ -55,23 +344,27 @@ void ReadPackage(const std::string& path) {
         file_stream.close();
 
         // Add the file to the zip
-        zip_fileinfo file_info = { 0 };
-        zipOpenNewFileInZip(
-            zip, 
-            file.c_str(), 
-            &file_info, 
-            nullptr, 
-            0, 
-            nullptr, 
-            0, 
-            nullptr, 
-            Z_DEFLATED, 
-            MZ_COMPRESS_LEVEL_BEST
-        );
-        zipWriteInFileInZip(zip, file_contents.data(), file_contents.size());
-        zipCloseFileInZip(zip);
+        AddToZip(zip, file, file_contents.data(), file_contents.size());
 	}
 
+    for (const auto& atlas : bundle.atlases) {
+        if (!PackAtlas(zip, dirPath, atlas)) {
+            std::cerr << "Failed to pack atlas " << atlas.name << std::endl;
+        }
+    }
+
+    for (const auto& texture : bundle.textures) {
+        if (!CookTextureFile(zip, dirPath, texture)) {
+            std::cerr << "Failed to cook texture " << texture << std::endl;
+        }
+    }
+
+    for (const auto& model : bundle.models) {
+        if (!CookModelFile(zip, dirPath, model)) {
+            std::cerr << "Failed to cook model " << model << std::endl;
+        }
+    }
+
     zipClose(zip, nullptr);
 }
 
@@ -91,4 +384,4 @@ int main(int argc, char** argv) {
     ReadPackage(path);
 
     return 0;
-}
\ No newline at end of file
+}
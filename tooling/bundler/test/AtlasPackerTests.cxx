@@ -0,0 +1,82 @@
+#include "bundler/AtlasPacker.hxx"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+    auto Overlaps(const PackedRect& a, const PackedRect& b) -> bool {
+        return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+
+    auto ExpectInside(const PackedRect& rect, uint32_t size) -> void {
+        EXPECT_LE(rect.x + rect.width, size);
+        EXPECT_LE(rect.y + rect.height, size);
+    }
+}
+
+TEST(AtlasPacker, TestRectsThatFillTheBinExactlyAllFit) {
+    AtlasPacker packer(128, 128);
+
+    std::vector<PackedRect> placed;
+    for (int x = 0; x < 4; x++) {
+        PackedRect rect;
+        ASSERT_TRUE(packer.Insert(64, 64, rect));
+        ExpectInside(rect, 128);
+        EXPECT_EQ(rect.width, 64u);
+        EXPECT_EQ(rect.height, 64u);
+        for (const auto& other : placed) {
+            EXPECT_FALSE(Overlaps(rect, other));
+        }
+        placed.push_back(rect);
+    }
+
+    EXPECT_FLOAT_EQ(packer.Occupancy(), 1.0f);
+}
+
+TEST(AtlasPacker, TestRectsThatDoNotFitAreRejected) {
+    AtlasPacker packer(64, 64);
+    PackedRect rect;
+
+    EXPECT_FALSE(packer.Insert(65, 1, rect));
+    EXPECT_FALSE(packer.Insert(1, 65, rect));
+    EXPECT_FLOAT_EQ(packer.Occupancy(), 0.0f);
+
+    // Once the bin is full a single texel no longer fits, but a rejected insert changes nothing
+    ASSERT_TRUE(packer.Insert(64, 40, rect));
+    EXPECT_FALSE(packer.Insert(32, 32, rect));
+    ASSERT_TRUE(packer.Insert(64, 24, rect));
+    EXPECT_FALSE(packer.Insert(1, 1, rect));
+    EXPECT_FLOAT_EQ(packer.Occupancy(), 1.0f);
+}
+
+TEST(AtlasPacker, TestPaddedRectsKeepTheirImagesApart) {
+    // The bundler inserts every image grown by the padding on each side and draws it inside that border
+    constexpr uint32_t Size = 256;
+    constexpr uint32_t Padding = 2;
+    AtlasPacker packer(Size, Size);
+
+    std::mt19937 random(11);
+    std::uniform_int_distribution<uint32_t> side(4, 40);
+    std::vector<PackedRect> images;
+    for (int x = 0; x < 200; x++) {
+        auto width = side(random);
+        auto height = side(random);
+
+        PackedRect rect;
+        if (!packer.Insert(width + Padding * 2, height + Padding * 2, rect)) {
+            continue;
+        }
+        ExpectInside(rect, Size);
+        images.push_back({ rect.x + Padding, rect.y + Padding, width, height });
+    }
+    ASSERT_GT(images.size(), 20u);
+
+    // Grown by the padding again, no two images may touch, so the extruded borders never bleed into a neighbour
+    for (size_t a = 0; a < images.size(); a++) {
+        auto grown = PackedRect { images[a].x - Padding, images[a].y - Padding, images[a].width + Padding * 2, images[a].height + Padding * 2 };
+        for (size_t b = a + 1; b < images.size(); b++) {
+            auto other = PackedRect { images[b].x - Padding, images[b].y - Padding, images[b].width + Padding * 2, images[b].height + Padding * 2 };
+            EXPECT_FALSE(Overlaps(grown, other)) << "images " << a << " and " << b;
+        }
+    }
+}
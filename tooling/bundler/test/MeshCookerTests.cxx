@@ -0,0 +1,162 @@
+#include "bundler/MeshCooker.hxx"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+
+using kyanite::engine::shared::VertexFormat;
+
+namespace {
+    // A regular grid of quads with its triangles shuffled, about the worst order an exporter hands out
+    auto MakeShuffledGrid(uint32_t size, float offset = 0.0f) -> SourceMesh {
+        SourceMesh mesh;
+        mesh.name = "grid";
+        for (uint32_t y = 0; y <= size; y++) {
+            for (uint32_t x = 0; x <= size; x++) {
+                mesh.vertices.push_back({
+                    { offset + static_cast<float>(x) / size, offset + static_cast<float>(y) / size, 0.0f },
+                    { static_cast<float>(x) / size, static_cast<float>(y) / size }
+                });
+            }
+        }
+
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (uint32_t y = 0; y < size; y++) {
+            for (uint32_t x = 0; x < size; x++) {
+                auto corner = y * (size + 1) + x;
+                triangles.push_back({ corner, corner + 1, corner + size + 1 });
+                triangles.push_back({ corner + 1, corner + size + 2, corner + size + 1 });
+            }
+        }
+
+        std::mt19937 random(7);
+        std::shuffle(triangles.begin(), triangles.end(), random);
+        for (const auto& triangle : triangles) {
+            mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+        }
+
+        return mesh;
+    }
+
+    auto SortedTriangles(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices) -> std::vector<std::array<float, 9>> {
+        std::vector<std::array<float, 9>> triangles;
+        for (size_t x = 0; x < indices.size(); x += 3) {
+            std::array<float, 9> triangle;
+            for (int corner = 0; corner < 3; corner++) {
+                std::memcpy(triangle.data() + corner * 3, vertices[indices[x + corner]].position, sizeof(float) * 3);
+            }
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+TEST(MeshCooker, TestVertexCacheOrderLowersMissRatio) {
+    auto mesh = MakeShuffledGrid(32);
+    auto before = AverageCacheMissRatio(mesh.indices, 16);
+
+    OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+    auto after = AverageCacheMissRatio(mesh.indices, 16);
+
+    EXPECT_GT(before, 1.5f);
+    EXPECT_LT(after, 0.9f);
+}
+
+TEST(MeshCooker, TestOptimizationKeepsEveryTriangle) {
+    auto mesh = MakeShuffledGrid(16);
+    auto expected = SortedTriangles(mesh.vertices, mesh.indices);
+
+    OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+    OptimizeVertexFetch(mesh.vertices, mesh.indices);
+
+    EXPECT_EQ(SortedTriangles(mesh.vertices, mesh.indices), expected);
+}
+
+TEST(MeshCooker, TestVertexFetchOrderFollowsFirstUse) {
+    auto mesh = MakeShuffledGrid(8);
+    // An unreferenced vertex is dropped
+    mesh.vertices.push_back({ { 5.0f, 5.0f, 5.0f }, { 0.0f, 0.0f } });
+    auto vertexCount = mesh.vertices.size();
+
+    OptimizeVertexFetch(mesh.vertices, mesh.indices);
+
+    EXPECT_EQ(mesh.vertices.size(), vertexCount - 1);
+    uint32_t next = 0;
+    for (auto index : mesh.indices) {
+        ASSERT_LE(index, next);
+        if (index == next) {
+            next++;
+        }
+    }
+}
+
+TEST(MeshCooker, TestHalfConversion) {
+    EXPECT_EQ(FloatToHalf(0.0f), 0x0000);
+    EXPECT_EQ(FloatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.0f), 0xC000);
+    EXPECT_EQ(FloatToHalf(65504.0f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(1.0e6f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.0f, -24)), 0x0001);
+
+    for (float value : { 0.5f, 0.333f, -12.75f, 1000.0f, 0.0001f }) {
+        EXPECT_NEAR(HalfToFloat(FloatToHalf(value)), value, std::abs(value) / 1024.0f) << value;
+    }
+}
+
+TEST(MeshCooker, TestChooseVertexFormat) {
+    EXPECT_EQ(ChooseVertexFormat(MakeShuffledGrid(8)), VertexFormat::Half16);
+
+    // One unit far from the origin is below what half floats resolve there
+    EXPECT_EQ(ChooseVertexFormat(MakeShuffledGrid(8, 4000.0f)), VertexFormat::Float32);
+}
+
+TEST(MeshCooker, TestCookedContainerLoadsInPlace) {
+    using namespace kyanite::engine::shared;
+
+    std::vector<SourceMesh> meshes = { MakeShuffledGrid(8), MakeShuffledGrid(4, 4000.0f) };
+    auto file = CookMeshes(meshes);
+
+    MeshHeader header;
+    std::vector<MeshEntry> entries;
+    ASSERT_TRUE(ReadMeshHeader(file.data(), file.size(), header, entries));
+    ASSERT_EQ(entries.size(), 2u);
+
+    EXPECT_STREQ(entries[0].name, "grid");
+    EXPECT_EQ(entries[0].format, VertexFormat::Half16);
+    EXPECT_EQ(entries[1].format, VertexFormat::Float32);
+
+    for (size_t x = 0; x < entries.size(); x++) {
+        const auto& entry = entries[x];
+        EXPECT_EQ(entry.vertexCount, meshes[x].vertices.size());
+        EXPECT_EQ(entry.indexCount, meshes[x].indices.size());
+        EXPECT_EQ(entry.vertexOffset % MeshDataAlignment, 0u);
+        EXPECT_EQ(entry.indexOffset % MeshDataAlignment, 0u);
+
+        // Every index stays inside the vertex range
+        auto indices = reinterpret_cast<const uint32_t*>(file.data() + entry.indexOffset);
+        EXPECT_LT(*std::max_element(indices, indices + entry.indexCount), entry.vertexCount);
+    }
+
+    // Quantized positions stay inside the bounds taken from the source
+    auto halves = reinterpret_cast<const uint16_t*>(file.data() + entries[0].vertexOffset);
+    for (uint32_t x = 0; x < entries[0].vertexCount; x++) {
+        for (int axis = 0; axis < 3; axis++) {
+            auto value = HalfToFloat(halves[x * 6 + axis]);
+            EXPECT_GE(value, entries[0].boundsMin[axis] - 0.001f);
+            EXPECT_LE(value, entries[0].boundsMax[axis] + 0.001f);
+        }
+    }
+}
+
+TEST(MeshCooker, TestTruncatedContainerIsRejected) {
+    using namespace kyanite::engine::shared;
+
+    auto file = CookMeshes({ MakeShuffledGrid(4) });
+    file.resize(file.size() - 16);
+
+    MeshHeader header;
+    std::vector<MeshEntry> entries;
+    EXPECT_FALSE(ReadMeshHeader(file.data(), file.size(), header, entries));
+}
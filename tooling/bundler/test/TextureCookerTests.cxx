@@ -0,0 +1,155 @@
+#include "bundler/TextureCooker.hxx"
+#include <gtest/gtest.h>
+#include <cmath>
+
+using kyanite::engine::shared::TextureFormat;
+
+namespace {
+    // Smooth gradients with a few hard edges, close to what sprites and UI art look like
+    auto MakeTestImage(uint32_t width, uint32_t height, bool withAlpha) -> Image {
+        Image image = { width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4) };
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                auto pixel = image.pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+                auto inside = (x / 16 + y / 16) % 2 == 0;
+                pixel[0] = static_cast<uint8_t>(x * 255 / (width - 1));
+                pixel[1] = static_cast<uint8_t>(y * 255 / (height - 1));
+                pixel[2] = inside ? 200 : 40;
+                pixel[3] = withAlpha ? static_cast<uint8_t>(inside ? 255 : (x * 255 / (width - 1))) : 255;
+            }
+        }
+        return image;
+    }
+
+    // Only gradients, so every mip level stays representable by two endpoints per block
+    auto MakeGradientImage(uint32_t width, uint32_t height) -> Image {
+        Image image = { width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4) };
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                auto pixel = image.pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+                pixel[0] = static_cast<uint8_t>(x * 255 / (width - 1));
+                pixel[1] = static_cast<uint8_t>(x * 128 / (width - 1) + y * 64 / (height - 1));
+                pixel[2] = static_cast<uint8_t>(255 - x * 255 / (width - 1));
+                pixel[3] = static_cast<uint8_t>(y * 255 / (height - 1));
+            }
+        }
+        return image;
+    }
+
+    auto Psnr(const Image& a, const Image& b, uint32_t channels) -> double {
+        double error = 0;
+        size_t count = 0;
+        for (size_t x = 0; x < a.pixels.size(); x += 4) {
+            for (uint32_t channel = 0; channel < channels; channel++) {
+                auto delta = static_cast<double>(a.pixels[x + channel]) - b.pixels[x + channel];
+                error += delta * delta;
+                count++;
+            }
+        }
+        if (error == 0) {
+            return INFINITY;
+        }
+        return 10.0 * std::log10(255.0 * 255.0 / (error / count));
+    }
+
+    auto AlphaPsnr(const Image& a, const Image& b) -> double {
+        double error = 0;
+        for (size_t x = 3; x < a.pixels.size(); x += 4) {
+            auto delta = static_cast<double>(a.pixels[x]) - b.pixels[x];
+            error += delta * delta;
+        }
+        if (error == 0) {
+            return INFINITY;
+        }
+        return 10.0 * std::log10(255.0 * 255.0 / (error / (a.pixels.size() / 4)));
+    }
+}
+
+TEST(TextureCooker, TestBC1SolidColorIsExact) {
+    // 0xF800 is pure red in 565 and expands back to 255, 0, 0
+    Image image = { 4, 4, {} };
+    for (int x = 0; x < 16; x++) {
+        image.pixels.insert(image.pixels.end(), { 255, 0, 0, 255 });
+    }
+
+    auto blocks = CompressImage(image, TextureFormat::BC1);
+    auto decoded = DecompressImage(blocks.data(), 4, 4, TextureFormat::BC1);
+
+    EXPECT_EQ(decoded.pixels, image.pixels);
+}
+
+TEST(TextureCooker, TestBC1RoundTripQuality) {
+    auto image = MakeTestImage(128, 64, false);
+
+    auto blocks = CompressImage(image, TextureFormat::BC1);
+    ASSERT_EQ(blocks.size(), 32u * 16u * 8u);
+
+    auto decoded = DecompressImage(blocks.data(), image.width, image.height, TextureFormat::BC1);
+    EXPECT_GT(Psnr(image, decoded, 3), 32.0);
+}
+
+TEST(TextureCooker, TestBC3RoundTripQuality) {
+    auto image = MakeTestImage(64, 64, true);
+
+    auto blocks = CompressImage(image, TextureFormat::BC3);
+    ASSERT_EQ(blocks.size(), 16u * 16u * 16u);
+
+    auto decoded = DecompressImage(blocks.data(), image.width, image.height, TextureFormat::BC3);
+    EXPECT_GT(Psnr(image, decoded, 3), 32.0);
+    EXPECT_GT(AlphaPsnr(image, decoded), 40.0);
+}
+
+TEST(TextureCooker, TestOddSizesKeepTheirEdges) {
+    auto image = MakeTestImage(61, 29, false);
+
+    auto blocks = CompressImage(image, TextureFormat::BC1);
+    ASSERT_EQ(blocks.size(), 16u * 8u * 8u);
+
+    auto decoded = DecompressImage(blocks.data(), image.width, image.height, TextureFormat::BC1);
+    ASSERT_EQ(decoded.pixels.size(), image.pixels.size());
+    EXPECT_GT(Psnr(image, decoded, 3), 30.0);
+}
+
+TEST(TextureCooker, TestChooseFormat) {
+    EXPECT_EQ(ChooseFormat(MakeTestImage(32, 32, false)), TextureFormat::BC1);
+    EXPECT_EQ(ChooseFormat(MakeTestImage(32, 32, true)), TextureFormat::BC3);
+}
+
+TEST(TextureCooker, TestCookedContainerHasFullMipChain) {
+    using namespace kyanite::engine::shared;
+
+    auto image = MakeGradientImage(256, 64);
+    auto file = CookTexture(image, TextureFormat::BC3);
+
+    TextureHeader header;
+    std::vector<TextureLevel> levels;
+    ASSERT_TRUE(ReadTextureHeader(file.data(), file.size(), header, levels));
+
+    EXPECT_EQ(header.format, TextureFormat::BC3);
+    EXPECT_EQ(header.width, 256u);
+    EXPECT_EQ(header.height, 64u);
+    ASSERT_EQ(levels.size(), 9u);
+    EXPECT_EQ(levels.back().width, 1u);
+    EXPECT_EQ(levels.back().height, 1u);
+
+    for (size_t x = 0; x < levels.size(); x++) {
+        EXPECT_EQ(levels[x].offset % TextureDataAlignment, 0u);
+
+        // Every level decodes close to the box filtered source it was made from
+        auto decoded = DecompressImage(file.data() + levels[x].offset, levels[x].width, levels[x].height, header.format);
+        EXPECT_GT(Psnr(image, decoded, 3), 26.0) << "level " << x;
+        EXPECT_GT(AlphaPsnr(image, decoded), 28.0) << "level " << x;
+        image = Downsample(image);
+    }
+}
+
+TEST(TextureCooker, TestTruncatedContainerIsRejected) {
+    using namespace kyanite::engine::shared;
+
+    auto file = CookTexture(MakeTestImage(32, 32, false), TextureFormat::BC1);
+    file.resize(file.size() / 2);
+
+    TextureHeader header;
+    std::vector<TextureLevel> levels;
+    EXPECT_FALSE(ReadTextureHeader(file.data(), file.size(), header, levels));
+}